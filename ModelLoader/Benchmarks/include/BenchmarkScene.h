@@ -0,0 +1,14 @@
+#ifndef __BENCHMARK_SCENE_H__
+#define __BENCHMARK_SCENE_H__
+
+//Forward Declares
+class Scene;
+
+//Get the world bounds that give a boid count the same density of boids as the default scene
+int GetBenchmarkWorldBounds(unsigned int a_uBoidCount);
+
+//Set up a headless scene through the UI values, the same way a headless run does. Any other
+//UI values the benchmark needs must be set before this is called
+Scene* InitializeBenchmarkScene(unsigned int a_uBoidCount, int a_iWorldBounds);
+
+#endif //!__BENCHMARK_SCENE_H__
@@ -0,0 +1,29 @@
+#ifndef __BENCHMARK_TIMER_H__
+#define __BENCHMARK_TIMER_H__
+
+//C++ Includes
+#include <chrono>
+
+/// <summary>
+/// Simple high resolution timer used to time benchmarks
+/// </summary>
+class BenchmarkTimer
+{
+public:
+	BenchmarkTimer() : m_xStartTime(std::chrono::high_resolution_clock::now()) {}
+
+	//Restart the timer
+	void Start() { m_xStartTime = std::chrono::high_resolution_clock::now(); }
+
+	//Get the time since the timer was started
+	double GetElapsedNanoseconds() const
+	{
+		const std::chrono::high_resolution_clock::time_point xNow = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration<double, std::nano>(xNow - m_xStartTime).count();
+	}
+
+private:
+	std::chrono::high_resolution_clock::time_point m_xStartTime;
+};
+
+#endif //!__BENCHMARK_TIMER_H__
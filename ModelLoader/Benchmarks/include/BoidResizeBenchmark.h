@@ -0,0 +1,8 @@
+#ifndef __BOID_RESIZE_BENCHMARK_H__
+#define __BOID_RESIZE_BENCHMARK_H__
+
+//Run the boid resize benchmark, times shrinking the flock to a tenth of it's size
+//and growing it back again in one call to AdjustBoidCount
+void RunBoidResizeBenchmark(unsigned int a_uMaxBoidCount);
+
+#endif //!__BOID_RESIZE_BENCHMARK_H__
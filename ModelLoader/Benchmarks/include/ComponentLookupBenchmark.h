@@ -0,0 +1,8 @@
+#ifndef __COMPONENT_LOOKUP_BENCHMARK_H__
+#define __COMPONENT_LOOKUP_BENCHMARK_H__
+
+//Run the component lookup benchmark, comparing the old dynamic_cast
+//scan with the component type slot lookup
+void RunComponentLookupBenchmark();
+
+#endif //!__COMPONENT_LOOKUP_BENCHMARK_H__
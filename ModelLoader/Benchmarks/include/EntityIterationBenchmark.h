@@ -0,0 +1,8 @@
+#ifndef __ENTITY_ITERATION_BENCHMARK_H__
+#define __ENTITY_ITERATION_BENCHMARK_H__
+
+//Run the entity iteration benchmark, comparing a sweep over the old entity
+//map with a sweep over the packed entity registry
+void RunEntityIterationBenchmark(unsigned int a_uMaxEntityCount);
+
+#endif //!__ENTITY_ITERATION_BENCHMARK_H__
@@ -0,0 +1,40 @@
+#ifndef __FLOCKING_BENCHMARK_H__
+#define __FLOCKING_BENCHMARK_H__
+
+//C++ Includes
+#include <vector>
+
+/// <summary>
+/// Benchmark of the boid pipeline, sweeps boid counts and neighbour radii
+/// and times each stage of the pipeline and the full simulation step per boid
+/// </summary>
+class FlockingBenchmark
+{
+public:
+	//Run the sweep, printing a table and writing CSV to the given path (or the console if null)
+	static void Run(unsigned int a_uMaxBoidCount, const char* a_szCsvPath);
+
+private:
+
+	//Timings from a single boid count/radius case
+	struct BenchmarkResult
+	{
+		unsigned int uBoidCount;
+		int iWorldBounds;
+		float fNeighbourRadius;
+		unsigned int uThreadCount;
+		double fFlockingNs; //Per boid
+		double fVerletFlockingNs; //Per boid, finding neighbours with the Verlet lists
+		double fCollisionNs; //Per boid, analytic containment and obstacle raycasts
+		double fRaycastCollisionNs; //Per boid, raycasting the walls for containment
+		double fOrthogonalizeNs; //Per boid
+		double fStepNs; //Per boid, full simulation step
+		double fVerletStepNs; //Per boid, full simulation step with the Verlet lists (including rebuilds)
+		double fStepsPerRebuild; //Number of steps between Verlet list rebuilds
+	};
+
+	static BenchmarkResult RunCase(unsigned int a_uBoidCount, float a_fNeighbourRadius);
+	static void WriteCsv(const std::vector<BenchmarkResult>& a_vResults, const char* a_szCsvPath);
+};
+
+#endif //!__FLOCKING_BENCHMARK_H__
@@ -0,0 +1,8 @@
+#ifndef __FLOCKING_KERNEL_BENCHMARK_H__
+#define __FLOCKING_KERNEL_BENCHMARK_H__
+
+//Run the flocking kernel benchmark, times the scalar loop the kernel replaced
+//and every instruction set of the kernel that the CPU supports
+void RunFlockingKernelBenchmark(unsigned int a_uMaxBoidCount);
+
+#endif //!__FLOCKING_KERNEL_BENCHMARK_H__
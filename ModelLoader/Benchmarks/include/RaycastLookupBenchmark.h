@@ -0,0 +1,8 @@
+#ifndef __RAYCAST_LOOKUP_BENCHMARK_H__
+#define __RAYCAST_LOOKUP_BENCHMARK_H__
+
+//Run the raycast lookup benchmark, times the boid collision rays and the
+//lookup of the entity from a hit body as the boid count grows
+void RunRaycastLookupBenchmark(unsigned int a_uMaxBoidCount);
+
+#endif //!__RAYCAST_LOOKUP_BENCHMARK_H__
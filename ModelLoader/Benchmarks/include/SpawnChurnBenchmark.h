@@ -0,0 +1,9 @@
+#ifndef __SPAWN_CHURN_BENCHMARK_H__
+#define __SPAWN_CHURN_BENCHMARK_H__
+
+//Run the spawn churn benchmark, times destroying and respawning boids and checks that once
+//the pools have grown, entities and components are allocated without touching the heap.
+//Returns false if the pools had to allocate during the churn
+bool RunSpawnChurnBenchmark(unsigned int a_uMaxBoidCount);
+
+#endif //!__SPAWN_CHURN_BENCHMARK_H__
@@ -0,0 +1,8 @@
+#ifndef __TRAJECTORY_SEEK_BENCHMARK_H__
+#define __TRAJECTORY_SEEK_BENCHMARK_H__
+
+//Run the trajectory seek benchmark, times recording a trajectory, opening it
+//and seeking to frames in other chunks and in the chunk that is already decoded
+void RunTrajectorySeekBenchmark(unsigned int a_uMaxBoidCount);
+
+#endif //!__TRAJECTORY_SEEK_BENCHMARK_H__
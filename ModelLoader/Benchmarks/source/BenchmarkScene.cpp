@@ -0,0 +1,46 @@
+#include "BenchmarkScene.h"
+
+//C++ Includes
+#include <cmath>
+
+//Project Includes
+#include "DebugUI.h"
+#include "Scene.h"
+
+namespace
+{
+	//The default scene, that the world bounds are scaled from
+	constexpr unsigned int sc_uReferenceBoidCount = 100u;
+	constexpr int sc_iReferenceWorldBounds = 20;
+
+	//Every benchmark spawns from the same seed, so runs can be compared
+	constexpr unsigned int sc_uSeed = 1234u;
+}
+
+/// <summary>
+/// Get the world bounds for a boid count, the bounds are scaled with the cube root
+/// of the count so the boids are as dense as they are in the default scene
+/// </summary>
+/// <param name="a_uBoidCount">Number of boids in the world</param>
+/// <returns>Size of the world bounds</returns>
+int GetBenchmarkWorldBounds(const unsigned int a_uBoidCount)
+{
+	return static_cast<int>(std::round(sc_iReferenceWorldBounds * std::cbrt(static_cast<float>(a_uBoidCount) / sc_uReferenceBoidCount)));
+}
+
+/// <summary>
+/// Initialize the scene headless with a number of boids, ready to be benchmarked
+/// </summary>
+/// <param name="a_uBoidCount">Number of boids to spawn</param>
+/// <param name="a_iWorldBounds">Size of the world bounds</param>
+/// <returns>The initialized scene, which the benchmark must DeInitialize when it is done</returns>
+Scene* InitializeBenchmarkScene(const unsigned int a_uBoidCount, const int a_iWorldBounds)
+{
+	UIInputValues* pUIValues = DebugUI::GetInstance()->GetUIInputValues();
+	pUIValues->iBoidCount.value = static_cast<int>(a_uBoidCount);
+	pUIValues->iInputWorldBounds.value = a_iWorldBounds;
+
+	Scene* pScene = Scene::GetInstance();
+	pScene->InitializeHeadless(sc_uSeed);
+	return pScene;
+}
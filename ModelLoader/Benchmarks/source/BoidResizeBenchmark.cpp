@@ -0,0 +1,60 @@
+#include "BoidResizeBenchmark.h"
+
+//C++ Includes
+#include <cstdio>
+
+//Project Includes
+#include "BenchmarkScene.h"
+#include "BenchmarkTimer.h"
+#include "BoidSpawner.h"
+#include "Scene.h"
+
+namespace
+{
+	//Boid counts to sweep, each is shrunk to a tenth of it's size and grown back
+	const unsigned int sc_auBoidCounts[] = { 1000u, 10000u, 100000u };
+	constexpr unsigned int sc_uShrinkDivisor = 10u;
+
+	/// <summary>
+	/// Time a single call to AdjustBoidCount
+	/// </summary>
+	/// <returns>Time in ms</returns>
+	double TimeAdjustBoidCount(const unsigned int a_uTargetCount)
+	{
+		BenchmarkTimer xTimer;
+		BoidSpawner::GetInstance()->AdjustBoidCount(a_uTargetCount);
+		return xTimer.GetElapsedNanoseconds() / 1000000.0;
+	}
+}
+
+/// <summary>
+/// Run the boid resize benchmark. For each boid count creates a headless scene, then times
+/// shrinking the flock to a tenth of it's size, growing it back (which reuses the collision
+/// bodies of the destroyed boids) and shrinking it once more
+/// </summary>
+/// <param name="a_uMaxBoidCount">Largest boid count to run</param>
+void RunBoidResizeBenchmark(const unsigned int a_uMaxBoidCount)
+{
+	printf("Boid Resize (AdjustBoidCount to a tenth of the boids and back)\n");
+	printf("  %8s %8s %12s %12s %12s\n", "Boids", "Shrunk", "Shrink", "Grow", "Shrink");
+
+	for (unsigned int uBoidCount : sc_auBoidCounts)
+	{
+		if (uBoidCount > a_uMaxBoidCount)
+		{
+			continue;
+		}
+
+		Scene* pScene = InitializeBenchmarkScene(uBoidCount, GetBenchmarkWorldBounds(uBoidCount));
+
+		const unsigned int uShrunkCount = uBoidCount / sc_uShrinkDivisor;
+		const double fShrinkTime = TimeAdjustBoidCount(uShrunkCount);
+		const double fGrowTime = TimeAdjustBoidCount(uBoidCount);
+		const double fSecondShrinkTime = TimeAdjustBoidCount(uShrunkCount);
+
+		printf("  %8u %8u %9.2f ms %9.2f ms %9.2f ms\n", uBoidCount, uShrunkCount, fShrinkTime, fGrowTime, fSecondShrinkTime);
+		fflush(stdout);
+
+		pScene->DeInitialize(false);
+	}
+}
@@ -0,0 +1,151 @@
+#include "ComponentLookupBenchmark.h"
+
+//C++ Includes
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+//Project Includes
+#include "Entity.h"
+#include "BenchmarkTimer.h"
+
+//Stand-in components, so that we can benchmark the lookup without
+//pulling in the physics and rendering of the real components
+template<COMPONENT_TYPE eType>
+class BenchmarkComponent : public Component
+{
+public:
+	explicit BenchmarkComponent(Entity* a_pOwner) : Component(a_pOwner) {}
+
+	void Update(float /*a_fDeltaTime*/) override {}
+	void Draw(Shader* /*a_pShader*/) override {}
+	const char* GetComponentName() const override { return "Benchmark"; }
+
+	COMPONENT_TYPE GetComponentType() const override { return sc_eComponentType; }
+	static constexpr COMPONENT_TYPE sc_eComponentType = eType;
+};
+
+//Components in the order that the boid spawner adds them
+typedef BenchmarkComponent<COMPONENT_TYPE::COMPONENT_TYPE_TRANSFORM> BenchTransform;
+typedef BenchmarkComponent<COMPONENT_TYPE::COMPONENT_TYPE_MODEL> BenchModel;
+typedef BenchmarkComponent<COMPONENT_TYPE::COMPONENT_TYPE_BRAIN> BenchBrain;
+typedef BenchmarkComponent<COMPONENT_TYPE::COMPONENT_TYPE_COLLIDER> BenchCollider;
+typedef BenchmarkComponent<COMPONENT_TYPE::COMPONENT_TYPE_RAYCAST> BenchRaycast;
+
+namespace
+{
+	constexpr unsigned int sc_uEntityCount = 250; //Max boid count in the UI
+	constexpr unsigned int sc_uIterations = 20000; //Number of times we look up every entity
+
+	//Value the results are written to, so the lookups are not optimised away
+	volatile uintptr_t s_uSink = 0;
+
+	/// <summary>
+	/// The old Entity::GetComponent, try and cast every component
+	/// that the entity has to the type that we want
+	/// </summary>
+	template<class returnType>
+	returnType LegacyGetComponent(const std::vector<Component*>& a_apComponentList)
+	{
+		std::vector<Component*>::const_iterator xIter;
+		for (xIter = a_apComponentList.begin(); xIter < a_apComponentList.end(); ++xIter)
+		{
+			returnType pComponent = dynamic_cast<returnType>(*xIter);
+			if (pComponent != nullptr)
+			{
+				return pComponent;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/// <summary>
+	/// Time looking up a component of a type on every entity
+	/// </summary>
+	/// <returns>Average time of a single lookup in nanoseconds</returns>
+	template<class returnType>
+	double TimeLegacyLookup(const std::vector<std::vector<Component*>>& a_vComponentLists)
+	{
+		uintptr_t uResult = 0;
+		BenchmarkTimer xTimer;
+		for (unsigned int i = 0; i < sc_uIterations; ++i)
+		{
+			for (unsigned int j = 0; j < a_vComponentLists.size(); ++j)
+			{
+				uResult += reinterpret_cast<uintptr_t>(LegacyGetComponent<returnType>(a_vComponentLists[j]));
+			}
+		}
+		const double fElapsed = xTimer.GetElapsedNanoseconds();
+		s_uSink = uResult;
+
+		return fElapsed / (static_cast<double>(sc_uIterations) * a_vComponentLists.size());
+	}
+
+	/// <summary>
+	/// Time looking up a component of a type on every entity
+	/// </summary>
+	/// <returns>Average time of a single lookup in nanoseconds</returns>
+	template<class returnType>
+	double TimeSlotLookup(const std::vector<Entity*>& a_vpEntities)
+	{
+		uintptr_t uResult = 0;
+		BenchmarkTimer xTimer;
+		for (unsigned int i = 0; i < sc_uIterations; ++i)
+		{
+			for (unsigned int j = 0; j < a_vpEntities.size(); ++j)
+			{
+				uResult += reinterpret_cast<uintptr_t>(a_vpEntities[j]->GetComponent<returnType>());
+			}
+		}
+		const double fElapsed = xTimer.GetElapsedNanoseconds();
+		s_uSink = uResult;
+
+		return fElapsed / (static_cast<double>(sc_uIterations) * a_vpEntities.size());
+	}
+
+	/// <summary>
+	/// Time and print the lookup of a single component type
+	/// </summary>
+	template<class returnType>
+	void PrintLookup(const char* a_szName, const std::vector<Entity*>& a_vpEntities, const std::vector<std::vector<Component*>>& a_vComponentLists)
+	{
+		const double fLegacy = TimeLegacyLookup<returnType>(a_vComponentLists);
+		const double fSlot = TimeSlotLookup<returnType>(a_vpEntities);
+		printf("  %-10s legacy: %8.2f ns  slot: %8.2f ns  speedup: %6.1fx\n", a_szName, fLegacy, fSlot, fSlot > 0.0 ? fLegacy / fSlot : 0.0);
+	}
+}
+
+/// <summary>
+/// Run the component lookup benchmark. Creates a set of entities with the same components
+/// as a boid then times the per lookup cost of the old dynamic_cast scan and the slot lookup
+/// </summary>
+void RunComponentLookupBenchmark()
+{
+	//Create entities with the components a boid has
+	std::vector<Entity*> vpEntities;
+	std::vector<std::vector<Component*>> vComponentLists;
+	for (unsigned int i = 0; i < sc_uEntityCount; ++i)
+	{
+		Entity* pEntity = new Entity();
+		pEntity->AddComponent(new BenchTransform(pEntity));
+		pEntity->AddComponent(new BenchModel(pEntity));
+		pEntity->AddComponent(new BenchBrain(pEntity));
+		pEntity->AddComponent(new BenchCollider(pEntity));
+		pEntity->AddComponent(new BenchRaycast(pEntity));
+
+		vpEntities.push_back(pEntity);
+		vComponentLists.push_back(pEntity->GetComponentList());
+	}
+
+	printf("Component Lookup (%u entities, %u iterations, per lookup)\n", sc_uEntityCount, sc_uIterations);
+	PrintLookup<BenchTransform*>("Transform", vpEntities, vComponentLists);
+	PrintLookup<BenchCollider*>("Collider", vpEntities, vComponentLists);
+	PrintLookup<BenchRaycast*>("Raycast", vpEntities, vComponentLists);
+
+	//Cleanup
+	for (unsigned int i = 0; i < vpEntities.size(); ++i)
+	{
+		delete vpEntities[i];
+	}
+}
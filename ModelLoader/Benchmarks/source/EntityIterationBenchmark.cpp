@@ -0,0 +1,116 @@
+#include "EntityIterationBenchmark.h"
+
+//C++ Includes
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <vector>
+
+//Project Includes
+#include "Entity.h"
+#include "BenchmarkTimer.h"
+
+namespace
+{
+	//Entity counts to sweep
+	const unsigned int sc_auEntityCounts[] = { 100u, 1000u, 10000u, 100000u };
+	constexpr unsigned int sc_uTargetVisits = 20000000u; //Number of entities we visit for each count, split over repeated sweeps
+
+	//Value the results are written to, so the sweeps are not optimised away
+	volatile uintptr_t s_uSink = 0;
+
+	/// <summary>
+	/// Time a sweep over every entity, reading it's type the way the scene
+	/// checks the type of each entity that it updates
+	/// </summary>
+	/// <returns>Time per entity in ns</returns>
+	template<class sweepFunction>
+	double TimeSweep(const unsigned int a_uEntityCount, const unsigned int a_uSweeps, sweepFunction a_fnSweep)
+	{
+		uintptr_t uResult = 0;
+		BenchmarkTimer xTimer;
+		for (unsigned int i = 0; i < a_uSweeps; ++i)
+		{
+			uResult += a_fnSweep();
+		}
+		const double fElapsed = xTimer.GetElapsedNanoseconds();
+		s_uSink = uResult;
+
+		return fElapsed / (static_cast<double>(a_uSweeps) * a_uEntityCount);
+	}
+}
+
+/// <summary>
+/// Run the entity iteration benchmark. For each entity count creates the entities, destroys and
+/// respawns a third of them (as changing the boid count does) so neither container is in a perfect
+/// order, then times a full sweep over the old ID ordered map and over the registry
+/// </summary>
+/// <param name="a_uMaxEntityCount">Largest entity count to run</param>
+void RunEntityIterationBenchmark(const unsigned int a_uMaxEntityCount)
+{
+	printf("Entity Iteration (per entity)\n");
+	printf("  %8s %12s %14s %10s\n", "Entities", "Map (ns)", "Registry (ns)", "Speedup");
+
+	for (unsigned int uEntityCount : sc_auEntityCounts)
+	{
+		if (uEntityCount > a_uMaxEntityCount)
+		{
+			continue;
+		}
+
+		//Create the entities, then replace every third one
+		std::vector<Entity*> vpEntities;
+		for (unsigned int i = 0; i < uEntityCount; ++i)
+		{
+			vpEntities.push_back(new Entity());
+		}
+		for (unsigned int i = 0; i < uEntityCount; i += 3)
+		{
+			delete vpEntities[i];
+			vpEntities[i] = nullptr;
+		}
+		for (unsigned int i = 0; i < uEntityCount; i += 3)
+		{
+			vpEntities[i] = new Entity();
+			vpEntities[i]->SetEntityType(ENTITY_TYPE::ENTITY_TYPE_BOID);
+		}
+
+		//Build the old map, keyed by the order the entities were spawned in
+		std::map<const unsigned int, Entity*> xEntityMap;
+		const std::vector<Entity*>& vpRegistryEntities = Entity::GetEntityRegistry().GetEntities();
+		for (unsigned int i = 0; i < vpRegistryEntities.size(); ++i)
+		{
+			xEntityMap.insert(std::make_pair(i, vpRegistryEntities[i]));
+		}
+
+		const unsigned int uSweeps = std::max(1u, sc_uTargetVisits / uEntityCount);
+		const double fMapNs = TimeSweep(uEntityCount, uSweeps, [&xEntityMap]()
+		{
+			uintptr_t uCount = 0;
+			for (std::map<const unsigned int, Entity*>::const_iterator xIter = xEntityMap.begin(); xIter != xEntityMap.end(); ++xIter)
+			{
+				uCount += xIter->second->GetEntityType() == ENTITY_TYPE::ENTITY_TYPE_BOID;
+			}
+			return uCount;
+		});
+		const double fRegistryNs = TimeSweep(uEntityCount, uSweeps, [&vpRegistryEntities]()
+		{
+			uintptr_t uCount = 0;
+			for (unsigned int i = 0; i < vpRegistryEntities.size(); ++i)
+			{
+				uCount += vpRegistryEntities[i]->GetEntityType() == ENTITY_TYPE::ENTITY_TYPE_BOID;
+			}
+			return uCount;
+		});
+
+		printf("  %8u %12.2f %14.2f %9.1fx\n", uEntityCount, fMapNs, fRegistryNs, fRegistryNs > 0.0 ? fMapNs / fRegistryNs : 0.0);
+		fflush(stdout);
+
+		//Cleanup
+		for (unsigned int i = 0; i < vpEntities.size(); ++i)
+		{
+			delete vpEntities[i];
+		}
+	}
+}
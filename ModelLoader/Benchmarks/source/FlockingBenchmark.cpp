@@ -0,0 +1,260 @@
+#include "FlockingBenchmark.h"
+
+//C++ Includes
+#include <algorithm>
+#include <cstdio>
+
+//Project Includes
+#include "BenchmarkScene.h"
+#include "BenchmarkTimer.h"
+#include "BoidSystem.h"
+#include "BrainComponent.h"
+#include "DebugUI.h"
+#include "Entity.h"
+#include "JobSystem.h"
+#include "Scene.h"
+#include "SpatialHashGrid.h"
+#include "TransformComponent.h"
+
+namespace
+{
+	//Boid counts and neighbour radii to sweep
+	const unsigned int sc_auBoidCounts[] = { 100u, 1000u, 10000u, 100000u };
+	const float sc_afNeighbourRadii[] = { 1.f, 2.5f, 4.f };
+
+	//Roughly how many boids we time each stage over, so that small counts
+	//are repeated enough times to get a stable number
+	constexpr unsigned int sc_uTargetKernelBoids = 200000u;
+	constexpr unsigned int sc_uTargetStepBoids = 20000u;
+
+	constexpr float sc_fTimeStep = 1.f / 60.f;
+	constexpr unsigned int sc_uWarmupSteps = 2u;
+
+	//Skin used for the Verlet lists, and the fewest steps we time them over so we see a few rebuilds
+	constexpr float sc_fNeighbourListSkin = 1.f;
+	constexpr unsigned int sc_uMinNeighbourListSteps = 30u;
+}
+
+/// <summary>
+/// Run the benchmark over every boid count and neighbour radius
+/// </summary>
+/// <param name="a_uMaxBoidCount">Largest boid count to run</param>
+/// <param name="a_szCsvPath">Path of the CSV file to write, or nullptr to print it</param>
+void FlockingBenchmark::Run(const unsigned int a_uMaxBoidCount, const char* a_szCsvPath)
+{
+	printf("Flocking Pipeline (ns per boid, %u threads for full step)\n", JobSystem::GetInstance()->GetThreadCount());
+	printf("  %8s %6s %6s %12s %12s %12s %12s %12s %12s %12s %8s\n", "Boids", "Bounds", "Radius", "Flocking", "Flock(List)", "Collision", "Coll(Rays)",
+		"Orthogonal", "Step", "Step(List)", "Rebuild");
+
+	std::vector<BenchmarkResult> vResults;
+	for (unsigned int uBoidCount : sc_auBoidCounts)
+	{
+		if (uBoidCount > a_uMaxBoidCount)
+		{
+			continue;
+		}
+
+		for (float fRadius : sc_afNeighbourRadii)
+		{
+			const BenchmarkResult xResult = RunCase(uBoidCount, fRadius);
+			printf("  %8u %6i %6.2f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %12.1f %8.1f\n", xResult.uBoidCount, xResult.iWorldBounds, xResult.fNeighbourRadius,
+				xResult.fFlockingNs, xResult.fVerletFlockingNs, xResult.fCollisionNs, xResult.fRaycastCollisionNs, xResult.fOrthogonalizeNs,
+				xResult.fStepNs, xResult.fVerletStepNs, xResult.fStepsPerRebuild);
+			fflush(stdout);
+			vResults.push_back(xResult);
+		}
+	}
+
+	WriteCsv(vResults, a_szCsvPath);
+}
+
+/// <summary>
+/// Run a single case, creates a headless scene with the number of boids then times
+/// each stage of the pipeline on its own and then the full simulation step
+/// </summary>
+/// <param name="a_uBoidCount">Number of boids to spawn</param>
+/// <param name="a_fNeighbourRadius">Neighbour radius to flock with</param>
+/// <returns>Timings of the case</returns>
+FlockingBenchmark::BenchmarkResult FlockingBenchmark::RunCase(const unsigned int a_uBoidCount, const float a_fNeighbourRadius)
+{
+	BenchmarkResult xResult;
+	xResult.uBoidCount = a_uBoidCount;
+	xResult.iWorldBounds = GetBenchmarkWorldBounds(a_uBoidCount);
+	xResult.fNeighbourRadius = a_fNeighbourRadius;
+	xResult.uThreadCount = JobSystem::GetInstance()->GetThreadCount();
+
+	//Flock with the radius we are timing, the boid count and bounds are set with the scene
+	UIInputValues* pUIValues = DebugUI::GetInstance()->GetUIInputValues();
+	pUIValues->fInputNeighbourRadius.value = a_fNeighbourRadius;
+	pUIValues->bNeighbourLists = false;
+	pUIValues->fNeighbourListSkin.value = sc_fNeighbourListSkin;
+	Scene* pScene = InitializeBenchmarkScene(a_uBoidCount, xResult.iWorldBounds);
+
+	//Step a few times so the boids have velocities and neighbours
+	for (unsigned int i = 0; i < sc_uWarmupSteps; ++i)
+	{
+		pScene->Step(sc_fTimeStep);
+	}
+
+	BoidSystem* pBoidSystem = BoidSystem::GetInstance();
+	const unsigned int uBoidCount = pBoidSystem->GetBoidCount();
+	const unsigned int uKernelRepeats = std::max(1u, sc_uTargetKernelBoids / std::max(uBoidCount, 1u));
+	const unsigned int uStepRepeats = std::max(1u, sc_uTargetStepBoids / std::max(uBoidCount, 1u));
+	const double fKernelBoids = static_cast<double>(uKernelRepeats) * std::max(uBoidCount, 1u);
+	BenchmarkTimer xTimer;
+
+	//Build the grid the same way the boid system does and make sure
+	//the main thread has a candidate list to use
+	pBoidSystem->m_fNeighbourRadius = a_fNeighbourRadius;
+	SpatialHashGrid::GetInstance()->Rebuild(pBoidSystem->m_vV3Positions, pBoidSystem->m_vV3Velocities, a_fNeighbourRadius);
+	if (pBoidSystem->m_vvpNeighbourCandidates.empty())
+	{
+		pBoidSystem->m_vvpNeighbourCandidates.resize(1);
+	}
+	if (pBoidSystem->m_vxFlockingCandidates.empty())
+	{
+		pBoidSystem->m_vxFlockingCandidates.resize(1);
+	}
+
+	//Flocking (single thread)
+	glm::vec3 v3Sink(0.f);
+	xTimer.Start();
+	for (unsigned int r = 0; r < uKernelRepeats; ++r)
+	{
+		for (unsigned int i = 0; i < uBoidCount; ++i)
+		{
+			glm::vec3 v3Separation(0.f), v3Alignment(0.f), v3Cohesion(0.f);
+			v3Sink += pBoidSystem->CalculateFlockingForces(i, 0u, v3Separation, v3Alignment, v3Cohesion);
+		}
+	}
+	xResult.fFlockingNs = xTimer.GetElapsedNanoseconds() / fKernelBoids;
+
+	//Flocking with Verlet neighbour lists (single thread), built from the same state as the grid
+	pBoidSystem->m_bUseNeighbourLists = true;
+	pBoidSystem->m_bNeighbourListsDirty = true;
+	pBoidSystem->UpdateNeighbourLists(sc_fNeighbourListSkin);
+	xTimer.Start();
+	for (unsigned int r = 0; r < uKernelRepeats; ++r)
+	{
+		for (unsigned int i = 0; i < uBoidCount; ++i)
+		{
+			glm::vec3 v3Separation(0.f), v3Alignment(0.f), v3Cohesion(0.f);
+			v3Sink += pBoidSystem->CalculateFlockingForces(i, 0u, v3Separation, v3Alignment, v3Cohesion);
+		}
+	}
+	xResult.fVerletFlockingNs = xTimer.GetElapsedNanoseconds() / fKernelBoids;
+	pBoidSystem->m_bUseNeighbourLists = false;
+
+	//Collision avoidance (single thread)
+	xTimer.Start();
+	for (unsigned int r = 0; r < uKernelRepeats; ++r)
+	{
+		for (unsigned int i = 0; i < uBoidCount; ++i)
+		{
+			glm::vec3 v3Containment(0.f), v3Avoidance(0.f);
+			v3Sink += pBoidSystem->CalculateCollisionForces(i, v3Containment, v3Avoidance);
+		}
+	}
+	xResult.fCollisionNs = xTimer.GetElapsedNanoseconds() / fKernelBoids;
+
+	//Collision raycasts with the walls raycast for containment (single thread)
+	const bool bAnalyticContainment = pBoidSystem->m_bAnalyticContainment;
+	pBoidSystem->m_bAnalyticContainment = false;
+	xTimer.Start();
+	for (unsigned int r = 0; r < uKernelRepeats; ++r)
+	{
+		for (unsigned int i = 0; i < uBoidCount; ++i)
+		{
+			glm::vec3 v3Containment(0.f), v3Avoidance(0.f);
+			v3Sink += pBoidSystem->CalculateCollisionForces(i, v3Containment, v3Avoidance);
+		}
+	}
+	xResult.fRaycastCollisionNs = xTimer.GetElapsedNanoseconds() / fKernelBoids;
+	pBoidSystem->m_bAnalyticContainment = bAnalyticContainment;
+
+	//Orthogonalize (single thread)
+	std::vector<TransformComponent*> vpTransforms;
+	for (unsigned int i = 0; i < uBoidCount; ++i)
+	{
+		vpTransforms.push_back(pBoidSystem->m_vpBrains[i]->GetOwnerEntity()->GetComponent<TransformComponent*>());
+	}
+	xTimer.Start();
+	for (unsigned int r = 0; r < uKernelRepeats; ++r)
+	{
+		for (unsigned int i = 0; i < vpTransforms.size(); ++i)
+		{
+			vpTransforms[i]->Orthogonalize();
+		}
+	}
+	xResult.fOrthogonalizeNs = xTimer.GetElapsedNanoseconds() / fKernelBoids;
+
+	//Full simulation step (job system threads)
+	xTimer.Start();
+	for (unsigned int r = 0; r < uStepRepeats; ++r)
+	{
+		pScene->Step(sc_fTimeStep);
+	}
+	xResult.fStepNs = xTimer.GetElapsedNanoseconds() / (static_cast<double>(uStepRepeats) * std::max(uBoidCount, 1u));
+
+	//Full simulation step with the Verlet lists, over enough steps that the time includes the rebuilds
+	const unsigned int uNeighbourListSteps = std::max(uStepRepeats, sc_uMinNeighbourListSteps);
+	pUIValues->bNeighbourLists = true;
+	pScene->Step(sc_fTimeStep);
+	const unsigned int uStartRebuilds = pBoidSystem->GetNeighbourListRebuildCount();
+	xTimer.Start();
+	for (unsigned int r = 0; r < uNeighbourListSteps; ++r)
+	{
+		pScene->Step(sc_fTimeStep);
+	}
+	xResult.fVerletStepNs = xTimer.GetElapsedNanoseconds() / (static_cast<double>(uNeighbourListSteps) * std::max(uBoidCount, 1u));
+	const unsigned int uRebuilds = pBoidSystem->GetNeighbourListRebuildCount() - uStartRebuilds;
+	xResult.fStepsPerRebuild = uRebuilds > 0u ? static_cast<double>(uNeighbourListSteps) / uRebuilds : static_cast<double>(uNeighbourListSteps);
+	pUIValues->bNeighbourLists = false;
+
+	//Use the sink so the kernels are not optimised away
+	if (std::isnan(v3Sink.x + v3Sink.y + v3Sink.z))
+	{
+		printf("  (NaN in results)\n");
+	}
+
+	pScene->DeInitialize(false);
+
+	return xResult;
+}
+
+/// <summary>
+/// Write the results as CSV, so they can be compared between runs
+/// </summary>
+/// <param name="a_vResults">Results to write</param>
+/// <param name="a_szCsvPath">Path of the file to write, or nullptr to print to the console</param>
+void FlockingBenchmark::WriteCsv(const std::vector<BenchmarkResult>& a_vResults, const char* a_szCsvPath)
+{
+	FILE* pFile = stdout;
+	if (a_szCsvPath)
+	{
+		pFile = fopen(a_szCsvPath, "w");
+		if (!pFile)
+		{
+			printf("Failed to open %s for writing\n", a_szCsvPath);
+			return;
+		}
+	}
+	else
+	{
+		printf("\n");
+	}
+
+	fprintf(pFile, "boids,bounds,radius,threads,flocking_ns,verlet_flocking_ns,collision_ns,collision_raycast_ns,orthogonalize_ns,step_ns,verlet_step_ns,steps_per_rebuild\n");
+	for (const BenchmarkResult& xResult : a_vResults)
+	{
+		fprintf(pFile, "%u,%i,%.2f,%u,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n", xResult.uBoidCount, xResult.iWorldBounds, xResult.fNeighbourRadius, xResult.uThreadCount,
+			xResult.fFlockingNs, xResult.fVerletFlockingNs, xResult.fCollisionNs, xResult.fRaycastCollisionNs, xResult.fOrthogonalizeNs,
+			xResult.fStepNs, xResult.fVerletStepNs, xResult.fStepsPerRebuild);
+	}
+
+	if (pFile != stdout)
+	{
+		fclose(pFile);
+		printf("Wrote %s\n", a_szCsvPath);
+	}
+}
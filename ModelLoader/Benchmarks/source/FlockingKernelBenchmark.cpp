@@ -0,0 +1,209 @@
+#include "FlockingKernelBenchmark.h"
+
+//C++ Includes
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+//Project Includes
+#include "BenchmarkScene.h"
+#include "BenchmarkTimer.h"
+#include "BoidSystem.h"
+#include "DebugUI.h"
+#include "FlockingKernel.h"
+#include "Scene.h"
+#include "SpatialHashGrid.h"
+
+namespace
+{
+	//Boid count and neighbour radii to sweep, the world is scaled to the same density as the default scene.
+	//The largest radius gives each boid enough candidates to see how the kernels scale
+	constexpr unsigned int sc_uBoidCount = 10000u;
+	const float sc_afNeighbourRadii[] = { 1.f, 2.5f, 4.f, 8.f };
+
+	//Roughly how many boids we time each kernel over
+	constexpr unsigned int sc_uTargetBoids = 500000u;
+
+	constexpr float sc_fTimeStep = 1.f / 60.f;
+	constexpr unsigned int sc_uWarmupSteps = 2u;
+
+	/// <summary>
+	/// The loop that the kernel replaced, gets the candidates from the grid then checks
+	/// each one at a time with a square root
+	/// </summary>
+	FlockingSums AccumulateReference(const unsigned int a_uBoidIndex, const glm::vec3& a_v3OwnerPos, const float a_fRadius, std::vector<const SpatialGridEntry*>& a_vpCandidates)
+	{
+		SpatialHashGrid::GetInstance()->QueryNeighbours(a_v3OwnerPos, a_vpCandidates);
+
+		FlockingSums xSums = { glm::vec3(0.f), glm::vec3(0.f), glm::vec3(0.f), 0 };
+		for (unsigned int i = 0; i < a_vpCandidates.size(); ++i)
+		{
+			const SpatialGridEntry* pCandidate = a_vpCandidates[i];
+			if (pCandidate->m_uBoidIndex == a_uBoidIndex)
+			{
+				continue;
+			}
+
+			if (glm::length(pCandidate->m_v3Position - a_v3OwnerPos) < a_fRadius)
+			{
+				xSums.v3Separation += a_v3OwnerPos - pCandidate->m_v3Position;
+				xSums.v3Alignment += pCandidate->m_v3Velocity;
+				xSums.v3Cohesion += pCandidate->m_v3Position;
+				++xSums.iNeighbourCount;
+			}
+		}
+		return xSums;
+	}
+
+	/// <summary>
+	/// Get the candidates from the grid laid out for the kernel and run it, the same way the boid system does
+	/// </summary>
+	FlockingSums AccumulateKernel(const unsigned int a_uBoidIndex, const glm::vec3& a_v3OwnerPos, const float a_fRadius, FlockingCandidates& a_xCandidates)
+	{
+		SpatialHashGrid::GetInstance()->QueryNeighbours(a_v3OwnerPos, a_uBoidIndex, a_xCandidates);
+		a_xCandidates.Pad();
+		return FlockingKernel::Accumulate(a_v3OwnerPos, a_fRadius, a_xCandidates);
+	}
+
+	/// <summary>
+	/// Add a set of sums to a running total, so the compiler can not remove the work
+	/// </summary>
+	void AddToSink(const FlockingSums& a_xSums, glm::vec3& a_v3Sink)
+	{
+		a_v3Sink += a_xSums.v3Separation + a_xSums.v3Alignment + a_xSums.v3Cohesion;
+	}
+}
+
+/// <summary>
+/// Run the flocking kernel benchmark. Times getting the neighbour candidates of every boid from the spatial grid
+/// and summing their flocking influences, with the scalar loop the kernel replaced and with every instruction
+/// set of the kernel the CPU supports. Each instruction set is also checked to give exactly the same sums as
+/// the scalar kernel
+/// </summary>
+/// <param name="a_uMaxBoidCount">Largest boid count to run</param>
+void RunFlockingKernelBenchmark(const unsigned int a_uMaxBoidCount)
+{
+	const FLOCKING_KERNEL eDefaultKernel = FlockingKernel::GetKernel();
+	const unsigned int uBoidCount = std::min(sc_uBoidCount, a_uMaxBoidCount);
+	const int iWorldBounds = GetBenchmarkWorldBounds(uBoidCount);
+
+	printf("Flocking Kernel (ns per boid, %u boids, single thread, default kernel %s)\n", uBoidCount, FlockingKernel::GetKernelName(eDefaultKernel));
+	printf("  %6s %10s %12s", "Radius", "Candidates", "Reference");
+	for (int k = 0; k < static_cast<int>(FLOCKING_KERNEL::FLOCKING_KERNEL_COUNT); ++k)
+	{
+		printf(" %12s", FlockingKernel::GetKernelName(static_cast<FLOCKING_KERNEL>(k)));
+	}
+	printf(" %8s %6s\n", "Speedup", "Match");
+
+	for (float fRadius : sc_afNeighbourRadii)
+	{
+		//Flock with the radius we are timing, the boid count and bounds are set with the scene
+		UIInputValues* pUIValues = DebugUI::GetInstance()->GetUIInputValues();
+		pUIValues->fInputNeighbourRadius.value = fRadius;
+		pUIValues->bNeighbourLists = false;
+		Scene* pScene = InitializeBenchmarkScene(uBoidCount, iWorldBounds);
+		for (unsigned int i = 0; i < sc_uWarmupSteps; ++i)
+		{
+			pScene->Step(sc_fTimeStep);
+		}
+
+		//Build the grid the same way the boid system does
+		BoidSystem* pBoidSystem = BoidSystem::GetInstance();
+		std::vector<glm::vec3> vV3Positions(pBoidSystem->GetBoidCount());
+		std::vector<glm::vec3> vV3Velocities(pBoidSystem->GetBoidCount());
+		for (unsigned int i = 0; i < pBoidSystem->GetBoidCount(); ++i)
+		{
+			vV3Positions[i] = pBoidSystem->GetPosition(i);
+			vV3Velocities[i] = pBoidSystem->GetVelocity(i);
+		}
+		SpatialHashGrid::GetInstance()->Rebuild(vV3Positions, vV3Velocities, fRadius);
+
+		const unsigned int uRepeats = std::max(1u, sc_uTargetBoids / std::max(uBoidCount, 1u));
+		const double fTimedBoids = static_cast<double>(uRepeats) * std::max(uBoidCount, 1u);
+		glm::vec3 v3Sink(0.f);
+		BenchmarkTimer xTimer;
+
+		//The scalar loop with a square root that the kernel replaced
+		std::vector<const SpatialGridEntry*> vpGridCandidates;
+		xTimer.Start();
+		for (unsigned int r = 0; r < uRepeats; ++r)
+		{
+			for (unsigned int i = 0; i < vV3Positions.size(); ++i)
+			{
+				AddToSink(AccumulateReference(i, vV3Positions[i], fRadius, vpGridCandidates), v3Sink);
+			}
+		}
+		const double fReferenceNs = xTimer.GetElapsedNanoseconds() / fTimedBoids;
+
+		//Count the candidates of each boid, not including padding
+		FlockingCandidates xCandidates;
+		unsigned int uCandidateCount = 0u;
+		for (unsigned int i = 0; i < vV3Positions.size(); ++i)
+		{
+			SpatialHashGrid::GetInstance()->QueryNeighbours(vV3Positions[i], i, xCandidates);
+			uCandidateCount += xCandidates.GetCount();
+		}
+
+		//Every kernel the CPU supports, checking it gives the same sums as the scalar kernel
+		double afKernelNs[static_cast<int>(FLOCKING_KERNEL::FLOCKING_KERNEL_COUNT)] = {};
+		std::vector<FlockingSums> vxScalarSums(vV3Positions.size());
+		bool bMatch = true;
+		double fBestNs = fReferenceNs;
+		for (int k = 0; k < static_cast<int>(FLOCKING_KERNEL::FLOCKING_KERNEL_COUNT); ++k)
+		{
+			if (!FlockingKernel::SetKernel(static_cast<FLOCKING_KERNEL>(k)))
+			{
+				continue;
+			}
+
+			xTimer.Start();
+			for (unsigned int r = 0; r < uRepeats; ++r)
+			{
+				for (unsigned int i = 0; i < vV3Positions.size(); ++i)
+				{
+					AddToSink(AccumulateKernel(i, vV3Positions[i], fRadius, xCandidates), v3Sink);
+				}
+			}
+			afKernelNs[k] = xTimer.GetElapsedNanoseconds() / fTimedBoids;
+			fBestNs = std::min(fBestNs, afKernelNs[k]);
+
+			for (unsigned int i = 0; i < vV3Positions.size(); ++i)
+			{
+				const FlockingSums xSums = AccumulateKernel(i, vV3Positions[i], fRadius, xCandidates);
+				if (k == static_cast<int>(FLOCKING_KERNEL::FLOCKING_KERNEL_SCALAR))
+				{
+					vxScalarSums[i] = xSums;
+				}
+				else if (memcmp(&xSums, &vxScalarSums[i], sizeof(FlockingSums)) != 0)
+				{
+					bMatch = false;
+				}
+			}
+		}
+		FlockingKernel::SetKernel(eDefaultKernel);
+
+		printf("  %6.2f %10.1f %12.1f", fRadius, static_cast<double>(uCandidateCount) / std::max(uBoidCount, 1u), fReferenceNs);
+		for (int k = 0; k < static_cast<int>(FLOCKING_KERNEL::FLOCKING_KERNEL_COUNT); ++k)
+		{
+			if (afKernelNs[k] > 0.0)
+			{
+				printf(" %12.1f", afKernelNs[k]);
+			}
+			else
+			{
+				printf(" %12s", "-");
+			}
+		}
+		printf(" %7.1fx %6s\n", fReferenceNs / fBestNs, bMatch ? "Yes" : "No");
+		fflush(stdout);
+
+		//Use the sink so the kernels are not optimised away
+		if (std::isnan(v3Sink.x + v3Sink.y + v3Sink.z))
+		{
+			printf("  (NaN in results)\n");
+		}
+
+		pScene->DeInitialize(false);
+	}
+}
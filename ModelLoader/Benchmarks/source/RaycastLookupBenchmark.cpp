@@ -0,0 +1,153 @@
+#include "RaycastLookupBenchmark.h"
+
+//C++ Includes
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+//Project Includes
+#include "BenchmarkScene.h"
+#include "BenchmarkTimer.h"
+#include "ColliderComponent.h"
+#include "Entity.h"
+#include "RaycastComponent.h"
+#include "Scene.h"
+#include "TransformComponent.h"
+
+namespace
+{
+	//Boid counts to sweep, the legacy lookup is repeated fewer times as the count grows past the smallest
+	const unsigned int sc_auBoidCounts[] = { 100u, 1000u, 10000u, 100000u };
+	constexpr unsigned int sc_uReferenceBoidCount = 100u;
+
+	constexpr float sc_fRayLength = 4.f; //Same as the default neighbour radius
+	constexpr unsigned int sc_uRayCastBoids = 1000u; //Number of boids we cast rays from
+	constexpr unsigned int sc_uLookupSamples = 256u; //Number of bodies we look up the entity of
+	constexpr unsigned int sc_uLookupIterations = 200u; //Number of times we look up each sampled body
+
+	//Value the results are written to, so the lookups are not optimised away
+	volatile uintptr_t s_uSink = 0;
+
+	/// <summary>
+	/// The old ColliderComponent::GetEntityFromCollisionBody, scan every entity
+	/// until we find the one that has the body
+	/// </summary>
+	Entity* LegacyGetEntityFromCollisionBody(const rp3d::CollisionBody* a_pCollisionBody)
+	{
+		const std::vector<Entity*>& vpEntities = Entity::GetEntityRegistry().GetEntities();
+		for (unsigned int i = 0; i < vpEntities.size(); ++i)
+		{
+			Entity* pTarget = vpEntities[i];
+			if (!pTarget) {
+				continue;
+			}
+
+			ColliderComponent* pTargetCollider = pTarget->GetComponent<ColliderComponent*>();
+			if (pTargetCollider == nullptr) {
+				continue;
+			}
+
+			if (a_pCollisionBody == pTargetCollider->GetCollisionBody())
+			{
+				return pTarget;
+			}
+		}
+
+		return nullptr;
+	}
+
+	/// <summary>
+	/// Time the lookup of the entity from each of the given bodies
+	/// </summary>
+	/// <returns>Time per lookup in ns</returns>
+	template<class lookupFunction>
+	double TimeLookup(const std::vector<const rp3d::CollisionBody*>& a_vpBodies, const unsigned int a_uIterations, lookupFunction a_fnLookup)
+	{
+		uintptr_t uResult = 0;
+		BenchmarkTimer xTimer;
+		for (unsigned int r = 0; r < a_uIterations; ++r)
+		{
+			for (unsigned int i = 0; i < a_vpBodies.size(); ++i)
+			{
+				uResult += reinterpret_cast<uintptr_t>(a_fnLookup(a_vpBodies[i]));
+			}
+		}
+		const double fElapsed = xTimer.GetElapsedNanoseconds();
+		s_uSink = uResult;
+
+		return fElapsed / (static_cast<double>(a_uIterations) * a_vpBodies.size());
+	}
+}
+
+/// <summary>
+/// Run the raycast lookup benchmark. For each boid count creates a headless scene, then times
+/// the six collision rays of a fixed number of boids (which looks up the entity of every hit) and
+/// compares the old linear scan for the entity of a body with the user data lookup
+/// </summary>
+/// <param name="a_uMaxBoidCount">Largest boid count to run</param>
+void RunRaycastLookupBenchmark(const unsigned int a_uMaxBoidCount)
+{
+	printf("Raycast Entity Lookup (rays from %u boids, per ray/lookup)\n", sc_uRayCastBoids);
+	printf("  %8s %12s %10s %12s %12s\n", "Boids", "Ray (ns)", "Hits/Ray", "Legacy (ns)", "Lookup (ns)");
+
+	for (unsigned int uBoidCount : sc_auBoidCounts)
+	{
+		if (uBoidCount > a_uMaxBoidCount)
+		{
+			continue;
+		}
+
+		Scene* pScene = InitializeBenchmarkScene(uBoidCount, GetBenchmarkWorldBounds(uBoidCount));
+
+		//Get the boids to cast from and the bodies to look up
+		std::vector<Entity*> vpBoids;
+		std::vector<const rp3d::CollisionBody*> vpBodies;
+		const std::vector<Entity*>& vpEntities = Entity::GetEntityRegistry().GetEntities();
+		for (unsigned int i = 0; i < vpEntities.size(); ++i)
+		{
+			Entity* pEntity = vpEntities[i];
+			if (!pEntity || pEntity->GetEntityType() != ENTITY_TYPE::ENTITY_TYPE_BOID)
+			{
+				continue;
+			}
+			vpBoids.push_back(pEntity);
+		}
+		const unsigned int uStride = std::max(1u, static_cast<unsigned int>(vpBoids.size()) / sc_uLookupSamples);
+		for (unsigned int i = 0; i < vpBoids.size() && vpBodies.size() < sc_uLookupSamples; i += uStride)
+		{
+			vpBodies.push_back(vpBoids[i]->GetComponent<ColliderComponent*>()->GetCollisionBody());
+		}
+
+		//Cast the 6 axis rays from a fixed number of boids, so the result is
+		//only affected by how long each hit takes to resolve
+		const unsigned int uCastCount = std::min(sc_uRayCastBoids, static_cast<unsigned int>(vpBoids.size()));
+		unsigned int uRayCount = 0;
+		unsigned int uHitCount = 0;
+		BenchmarkTimer xTimer;
+		for (unsigned int i = 0; i < uCastCount; ++i)
+		{
+			RaycastComponent* pRayCaster = vpBoids[i]->GetComponent<RaycastComponent*>();
+			const glm::vec3 v3Position = vpBoids[i]->GetComponent<TransformComponent*>()->GetCurrentPosition();
+			const glm::vec3 aV3EndPoints[6] = { v3Position + glm::vec3(sc_fRayLength, 0.f, 0.f), v3Position - glm::vec3(sc_fRayLength, 0.f, 0.f),
+												v3Position + glm::vec3(0.f, sc_fRayLength, 0.f), v3Position - glm::vec3(0.f, sc_fRayLength, 0.f),
+												v3Position + glm::vec3(0.f, 0.f, sc_fRayLength), v3Position - glm::vec3(0.f, 0.f, sc_fRayLength) };
+
+			RayCastHitsInfo rayHits;
+			pRayCaster->MutiRayCast(v3Position, aV3EndPoints, 6, rayHits);
+			uRayCount += 6;
+			uHitCount += rayHits.GetHitCount();
+		}
+		const double fRayNs = xTimer.GetElapsedNanoseconds() / std::max(uRayCount, 1u);
+
+		//Time the old scan over fewer iterations, it gets very slow with lots of boids
+		const unsigned int uLegacyIterations = std::max(1u, sc_uLookupIterations * sc_uReferenceBoidCount / uBoidCount);
+		const double fLegacyNs = TimeLookup(vpBodies, uLegacyIterations, LegacyGetEntityFromCollisionBody);
+		const double fLookupNs = TimeLookup(vpBodies, sc_uLookupIterations, [](const rp3d::CollisionBody* a_pBody) { return static_cast<Entity*>(a_pBody->getUserData()); });
+
+		printf("  %8u %12.1f %10.2f %12.1f %12.2f\n", uBoidCount, fRayNs, static_cast<double>(uHitCount) / std::max(uRayCount, 1u), fLegacyNs, fLookupNs);
+		fflush(stdout);
+
+		pScene->DeInitialize(false);
+	}
+}
@@ -0,0 +1,121 @@
+#include "SpawnChurnBenchmark.h"
+
+//C++ Includes
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+//Project Includes
+#include "BenchmarkScene.h"
+#include "BenchmarkTimer.h"
+#include "BoidSpawner.h"
+#include "ObjectPool.h"
+#include "Scene.h"
+
+namespace
+{
+	//Boid counts to sweep, each cycle destroys and respawns half of the boids
+	const unsigned int sc_auBoidCounts[] = { 100u, 1000u, 10000u };
+	constexpr unsigned int sc_uChurnCycles = 20u;
+
+	//Every heap allocation made by the benchmarks, counted by the global new below. Once warmed up, spawning
+	//and destroying boids should not allocate at all
+	std::atomic<uint64_t> s_uHeapAllocationCount(0u);
+}
+
+//Count every heap allocation in the benchmarks, so we can see how many allocations are left that the pools do not cover
+void* operator new(const size_t a_uSize)
+{
+	s_uHeapAllocationCount.fetch_add(1u, std::memory_order_relaxed);
+	void* pMemory = malloc(a_uSize > 0 ? a_uSize : 1);
+	if (!pMemory) {
+		throw std::bad_alloc();
+	}
+	return pMemory;
+}
+void* operator new[](const size_t a_uSize)
+{
+	return operator new(a_uSize);
+}
+void operator delete(void* a_pMemory) noexcept
+{
+	free(a_pMemory);
+}
+void operator delete[](void* a_pMemory) noexcept
+{
+	free(a_pMemory);
+}
+void operator delete(void* a_pMemory, size_t) noexcept
+{
+	free(a_pMemory);
+}
+void operator delete[](void* a_pMemory, size_t) noexcept
+{
+	free(a_pMemory);
+}
+
+/// <summary>
+/// Run the spawn churn benchmark. For each boid count creates a headless scene, does one cycle of
+/// destroying and respawning half of the boids so the pools are at their peak size, then times
+/// more cycles while counting how many times the pools and the heap are allocated from
+/// </summary>
+/// <param name="a_uMaxBoidCount">Largest boid count to run</param>
+/// <returns>If nothing allocated from the heap during the timed cycles, pools included</returns>
+bool RunSpawnChurnBenchmark(const unsigned int a_uMaxBoidCount)
+{
+	printf("Spawn Churn (destroy and respawn half the boids, %u cycles, per boid)\n", sc_uChurnCycles);
+	printf("  %8s %14s %14s %14s %8s\n", "Boids", "Destroy+Spawn", "Pool Blocks", "Heap Allocs", "Result");
+
+	bool bPassed = true;
+	for (unsigned int uBoidCount : sc_auBoidCounts)
+	{
+		if (uBoidCount > a_uMaxBoidCount)
+		{
+			continue;
+		}
+
+		Scene* pScene = InitializeBenchmarkScene(uBoidCount, GetBenchmarkWorldBounds(uBoidCount));
+
+		//Warm up, so the pools and lists have grown to the size they need
+		BoidSpawner* pSpawner = BoidSpawner::GetInstance();
+		const unsigned int uHalfCount = uBoidCount / 2;
+		pSpawner->AdjustBoidCount(uHalfCount);
+		pSpawner->AdjustBoidCount(uBoidCount);
+
+		const uint64_t uStartBlocks = ObjectPool::GetTotalBlockAllocationCount();
+		const uint64_t uStartHeapAllocations = s_uHeapAllocationCount.load();
+		BenchmarkTimer xTimer;
+		for (unsigned int i = 0; i < sc_uChurnCycles; ++i)
+		{
+			pSpawner->AdjustBoidCount(uHalfCount);
+			pSpawner->AdjustBoidCount(uBoidCount);
+		}
+		const double fElapsed = xTimer.GetElapsedNanoseconds();
+		const uint64_t uPoolBlocks = ObjectPool::GetTotalBlockAllocationCount() - uStartBlocks;
+		const uint64_t uHeapAllocations = s_uHeapAllocationCount.load() - uStartHeapAllocations;
+
+		const double fBoidsChurned = static_cast<double>(sc_uChurnCycles) * (uBoidCount - uHalfCount);
+		const bool bCyclePassed = uPoolBlocks == 0u && uHeapAllocations == 0u;
+		bPassed &= bCyclePassed;
+		printf("  %8u %11.1f ns %14llu %14.2f %8s\n", uBoidCount, fElapsed / std::max(fBoidsChurned, 1.0),
+			static_cast<unsigned long long>(uPoolBlocks), uHeapAllocations / std::max(fBoidsChurned, 1.0), bCyclePassed ? "PASS" : "FAIL");
+		fflush(stdout);
+
+		pScene->DeInitialize(false);
+	}
+
+	//Show how much of each pool was used
+	std::vector<ObjectPoolStats> vStats;
+	ObjectPool::GetAllStats(vStats);
+	printf("  %-26s %6s %8s %10s %8s\n", "Pool", "Size", "Peak", "Capacity", "Blocks");
+	for (const ObjectPoolStats& xStats : vStats)
+	{
+		printf("  %-26s %6zu %8u %10u %8llu\n", xStats.szName, xStats.uObjectSize, xStats.uPeakLiveCount, xStats.uCapacity, static_cast<unsigned long long>(xStats.uBlockAllocationCount));
+	}
+
+	return bPassed;
+}
@@ -0,0 +1,111 @@
+#include "TrajectorySeekBenchmark.h"
+
+//C++ Includes
+#include <cstdio>
+
+//Project Includes
+#include "BenchmarkScene.h"
+#include "BenchmarkTimer.h"
+#include "DebugUI.h"
+#include "Scene.h"
+#include "TrajectoryPlayer.h"
+#include "TrajectoryRecorder.h"
+
+namespace
+{
+	//Boid counts to sweep
+	const unsigned int sc_auBoidCounts[] = { 1000u, 10000u, 50000u };
+	constexpr unsigned int sc_uFrameCount = 256u;
+	constexpr unsigned int sc_uSeekCount = 32u;
+	const char* sc_szTrajectoryPath = "trajectory_benchmark.btrj";
+}
+
+/// <summary>
+/// Run the trajectory seek benchmark. For each boid count creates a headless scene and records
+/// frames of it without stepping (decoding costs the same whatever the boids did), then times
+/// opening the trajectory, seeking to a frame in a different chunk each time (decode and set the
+/// transforms) and seeking to the next frame of the decoded chunk (only set the transforms)
+/// </summary>
+/// <param name="a_uMaxBoidCount">Largest boid count to run</param>
+void RunTrajectorySeekBenchmark(const unsigned int a_uMaxBoidCount)
+{
+	printf("Trajectory Seek (%u frames recorded, %u seeks)\n", sc_uFrameCount, sc_uSeekCount);
+	printf("  %8s %12s %12s %12s %14s %14s\n", "Boids", "Size", "Record", "Open", "Seek Chunk", "Seek Frame");
+
+	for (unsigned int uBoidCount : sc_auBoidCounts)
+	{
+		if (uBoidCount > a_uMaxBoidCount)
+		{
+			continue;
+		}
+
+		Scene* pScene = InitializeBenchmarkScene(uBoidCount, GetBenchmarkWorldBounds(uBoidCount));
+
+		//Record, the time includes waiting for the writer to finish
+		TrajectoryRecorder* pRecorder = TrajectoryRecorder::GetInstance();
+		BenchmarkTimer xTimer;
+		pRecorder->StartRecording(sc_szTrajectoryPath, DebugUI::GetInstance()->GetUIInputValues()->fFixedTimeStep.value);
+		for (unsigned int i = 0; i < sc_uFrameCount; ++i)
+		{
+			pRecorder->RecordFrame();
+		}
+		const bool bRecorded = pRecorder->StopRecording();
+		const double fRecordTime = xTimer.GetElapsedNanoseconds() / 1000000.0;
+		if (!bRecorded)
+		{
+			printf("  %8u failed to record trajectory\n", uBoidCount);
+			pScene->DeInitialize(false);
+			continue;
+		}
+
+		FILE* pFile = fopen(sc_szTrajectoryPath, "rb");
+		long iFileSize = 0;
+		if (pFile) {
+			fseek(pFile, 0, SEEK_END);
+			iFileSize = ftell(pFile);
+			fclose(pFile);
+		}
+
+		TrajectoryPlayer* pPlayer = TrajectoryPlayer::GetInstance();
+		xTimer.Start();
+		const bool bOpened = pPlayer->Open(sc_szTrajectoryPath);
+		const double fOpenTime = xTimer.GetElapsedNanoseconds() / 1000000.0;
+		//A file left from an earlier row would time the wrong number of boids
+		if (!bOpened || pPlayer->GetMaxBoidCount() != uBoidCount)
+		{
+			printf("  %8u failed to open a trajectory of %u boids\n", uBoidCount, uBoidCount);
+			pPlayer->Close();
+			pScene->DeInitialize(false);
+			remove(sc_szTrajectoryPath);
+			continue;
+		}
+
+		//Jump backwards and forwards through the file so every seek lands in a different chunk
+		const unsigned int uFramesPerChunk = pPlayer->GetFramesPerChunk();
+		xTimer.Start();
+		for (unsigned int i = 0; i < sc_uSeekCount; ++i)
+		{
+			const unsigned int uChunk = (i * 5u + 3u) % (sc_uFrameCount / uFramesPerChunk);
+			pPlayer->SeekFrame(uChunk * uFramesPerChunk + (i % uFramesPerChunk));
+		}
+		const double fChunkSeekTime = xTimer.GetElapsedNanoseconds() / 1000000.0 / sc_uSeekCount;
+
+		//Step through the chunk we are in
+		const unsigned int uChunkStart = pPlayer->GetCurrentFrame() - pPlayer->GetCurrentFrame() % uFramesPerChunk;
+		xTimer.Start();
+		for (unsigned int i = 0; i < sc_uSeekCount; ++i)
+		{
+			pPlayer->SeekFrame(uChunkStart + i % uFramesPerChunk);
+		}
+		const double fFrameSeekTime = xTimer.GetElapsedNanoseconds() / 1000000.0 / sc_uSeekCount;
+
+		printf("  %8u %9.2f MB %9.2f ms %9.2f ms %11.2f ms %11.2f ms\n", uBoidCount, iFileSize / (1024.0 * 1024.0),
+			fRecordTime, fOpenTime, fChunkSeekTime, fFrameSeekTime);
+		fflush(stdout);
+
+		//The file can not be removed while it is still mapped
+		pPlayer->Close();
+		pScene->DeInitialize(false);
+		remove(sc_szTrajectoryPath);
+	}
+}
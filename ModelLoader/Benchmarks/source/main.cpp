@@ -0,0 +1,75 @@
+/// <summary>
+/// Benchmarks for the Boids Application, each benchmark times one of the
+/// hot paths of the simulation and prints the results to the console.
+/// Should be run in Release
+///
+/// Usage: Benchmarks [--max-boids N] [--threads N] [--csv file]
+/// </summary>
+
+//C++ Includes
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+//Project Includes
+#include "BoidResizeBenchmark.h"
+#include "ComponentLookupBenchmark.h"
+#include "EntityIterationBenchmark.h"
+#include "FlockingBenchmark.h"
+#include "FlockingKernelBenchmark.h"
+#include "RaycastLookupBenchmark.h"
+#include "SpawnChurnBenchmark.h"
+#include "TrajectorySeekBenchmark.h"
+#include "JobSystem.h"
+
+#ifndef STB_IMAGE_IMPLEMENTATION
+#define STB_IMAGE_IMPLEMENTATION
+#endif
+// ReSharper disable once CppUnusedIncludeDirective
+#include <stb/stb_image.h>
+
+int main(int argc, char** argv)
+{
+	unsigned int uMaxBoidCount = 100000u;
+	const char* szCsvPath = nullptr;
+
+	//Read the arguments
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--max-boids") == 0)
+		{
+			uMaxBoidCount = static_cast<unsigned int>(strtoul(argv[i + 1], nullptr, 10));
+		}
+		else if (strcmp(argv[i], "--threads") == 0)
+		{
+			JobSystem::GetInstance()->SetThreadCount(static_cast<unsigned int>(strtoul(argv[i + 1], nullptr, 10)));
+		}
+		else if (strcmp(argv[i], "--csv") == 0)
+		{
+			szCsvPath = argv[i + 1];
+		}
+		else
+		{
+			printf("Unknown argument %s\n", argv[i]);
+			return 1;
+		}
+	}
+
+	RunComponentLookupBenchmark();
+	printf("\n");
+	RunEntityIterationBenchmark(uMaxBoidCount);
+	printf("\n");
+	RunRaycastLookupBenchmark(uMaxBoidCount);
+	printf("\n");
+	FlockingBenchmark::Run(uMaxBoidCount, szCsvPath);
+	printf("\n");
+	RunFlockingKernelBenchmark(uMaxBoidCount);
+	printf("\n");
+	const bool bSpawnChurnPassed = RunSpawnChurnBenchmark(uMaxBoidCount);
+	printf("\n");
+	RunBoidResizeBenchmark(uMaxBoidCount);
+	printf("\n");
+	RunTrajectorySeekBenchmark(uMaxBoidCount);
+
+	return bSpawnChurnPassed ? 0 : 1;
+}
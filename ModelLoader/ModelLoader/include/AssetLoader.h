@@ -0,0 +1,73 @@
+#ifndef __ASSET_LOADER_H__
+#define __ASSET_LOADER_H__
+
+//C++ Includes
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//Project Includes
+#include "Singleton.h"
+#include "ModelCache.h"
+
+//Forward Declare
+class Model;
+
+/// <summary>
+/// Loads models in the background. Meshes are read and textures are decoded on job system
+/// worker threads, the finished data is then uploaded to the GPU on the main thread
+/// when ProcessUploads is called. Until then a placeholder model can be drawn
+/// </summary>
+class AssetLoader : public Singleton<AssetLoader>
+{
+	friend class Singleton<AssetLoader>;
+public:
+
+	//Function called on the main thread once a model has been uploaded, the
+	//model is nullptr if it failed to load
+	typedef std::function<void(Model* a_pModel)> ModelLoadedCallback;
+
+	//Start loading a model on a worker thread
+	void LoadModelAsync(const std::string& a_szModelPath, const ModelLoadedCallback& a_fnOnLoaded);
+
+	//Upload all of the models that have finished loading, must be called on the main thread
+	void ProcessUploads();
+
+	//Wait for all loads to finish and throw away any that have not been uploaded
+	void CancelPendingLoads();
+
+	//Get the number of models that have been asked for but not uploaded yet
+	unsigned int GetPendingLoadCount();
+
+	//Model to draw in place of models that are still loading
+	Model* GetPlaceholderModel();
+	void ReleasePlaceholderModel();
+
+private:
+	AssetLoader();
+	~AssetLoader();
+
+	//Build the placeholder model, a flat diamond about the size of a fish
+	static Model* CreatePlaceholderModel();
+
+	//A model that has finished loading on a worker thread
+	struct LoadedModel
+	{
+		ModelData xModelData;
+		ModelLoadedCallback fnOnLoaded;
+		bool bLoaded = false;
+	};
+
+	//Models that have finished loading and are waiting to be uploaded
+	std::vector<LoadedModel> m_vLoadedModels;
+	//Number of loads still running on worker threads
+	unsigned int m_uLoadsInProgress;
+	std::mutex m_xLoadMutex;
+	std::condition_variable m_xLoadFinished;
+
+	Model* m_pPlaceholderModel;
+};
+
+#endif //!__ASSET_LOADER_H__
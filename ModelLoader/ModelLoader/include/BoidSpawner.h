@@ -3,15 +3,14 @@
 #include "Singleton.h"
 
 //C++ Includes
+#include <cstdint>
 #include <vector>
 
 //React Physics incluides
 #include "ReactPhysics3D/reactphysics3d.h"
 
-//Project Includes
-#include "DoubleLinkedList.h"
-
 //Forward Declares
+class Entity;
 class Model;
 
 /// <summary>
@@ -20,6 +19,7 @@ class Model;
 class BoidSpawner : public Singleton<BoidSpawner>
 {
 	friend class Singleton<BoidSpawner>;
+	friend class SimulationSnapshot; //Snapshots save and restore the spawn random numbers
 public:
 	void SpawnBoid();
 	void SpawnBoids(unsigned int a_iCount);
@@ -29,26 +29,48 @@ public:
 	void DestroyBoid(Entity* a_pEntity);
 	void DestroyBoids(unsigned int a_iCount);
 
+	//Forget every boid without destroying them, for when the scene has already deleted all of the entities
+	void ForgetAllBoids();
+
 	Entity* GetBoidInfo(unsigned int a_iBoidPos);
+	unsigned int GetBoidCount() const { return static_cast<unsigned int>(m_vpActiveEntities.size()); }
 	
 	void SetCollisionWorld(rp3d::CollisionWorld* a_pCollisionWorld);
+
+	//Seed the random numbers boids are spawned with, and restart the count of boids spawned
+	void SetRandomSeed(unsigned int a_uSeed);
 	
+	void LoadAllModels();
 	void UnloadAllModels();
 	
 private:
 	BoidSpawner();
 	~BoidSpawner();
 
-	void LoadAllModels();
+	//Make sure we have a number of free collision bodies, creating the ones we are missing in one go
+	void ReserveCollisionBodies(unsigned int a_iCount);
 
 	//Margin from the world edges to spawn
 	const float m_fSpawnMargin = 1.0f;
+	//Radius of each boid's sphere collider
+	const float m_fColliderRadius = 0.25f;
 	
-	//Linked list of all of the boids
-	DoubleLinkedList<Entity> m_lpActiveEntities;
-	
-	//Number of boids currently active
-	unsigned int m_iBoidCount;
+	//Packed list of all of the boids, a boid is removed by moving the last boid in to it's place
+	std::vector<Entity*> m_vpActiveEntities;
+	//Where each boid is in the active list, indexed by entity ID
+	std::vector<unsigned int> m_viActiveEntityIndices;
+
+	//Collision bodies of destroyed boids, given to new boids as destroying a rp3d body
+	//has to search every body in the world. The last body is used first
+	std::vector<rp3d::CollisionBody*> m_vpFreeCollisionBodies;
+	//Sphere shapes of destroyed boids, given to new boids along with the bodies so spawning does not
+	//allocate a new shape. Shapes do not belong to a world, so they are kept until we are destroyed
+	std::vector<rp3d::CollisionShape*> m_vpFreeCollisionShapes;
+
+	//Key of the spawn random numbers and the number of boids spawned since it was set, each
+	//boid's spawn position comes from it's spawn number so it does not depend on what else drew random numbers
+	uint64_t m_uRandomKey;
+	unsigned int m_uSpawnCount;
 
 	//Collision world to pass to boids
 	rp3d::CollisionWorld* m_pBoidCollisionWorld;
@@ -0,0 +1,186 @@
+#ifndef __BOID_SYSTEM_H__
+#define __BOID_SYSTEM_H__
+
+//C++ Includes
+#include <cstdint>
+#include <vector>
+
+//GLM Includes
+#include <glm/glm.hpp>
+
+//RP3D Inlcudes
+#include "ReactPhysics3D/reactphysics3d.h"
+
+//Project Includes
+#include "Singleton.h"
+#include "FlockingKernel.h"
+
+//Forward Declare
+class BrainComponent;
+class DebugUI;
+class Entity;
+struct UIInputValues;
+class RayCastHitsInfo;
+struct SpatialGridEntry;
+
+/// <summary>
+/// System that owns the simulation state of every boid in contiguous arrays
+/// (structure of arrays) and runs the flocking, steering and collision avoidance
+/// behaviours over all of them in one pass.
+/// Each boid's BrainComponent is a handle in to this storage
+/// </summary>
+class BoidSystem : public Singleton<BoidSystem>
+{
+	friend class Singleton<BoidSystem>;
+	friend class FlockingBenchmark; //Benchmarks time the stages of the pipeline on their own
+	friend class SimulationSnapshot; //Snapshots copy the boid state arrays in and out in bulk
+public:
+
+	//Add/Remove boids from the system
+	unsigned int AddBoid(BrainComponent* a_pBrain);
+	void RemoveBoid(unsigned int a_uBoidIndex);
+	//Make room for a number of boids, so adding lots of boids at once does not regrow the arrays
+	void ReserveBoids(unsigned int a_uBoidCount);
+
+	//Seed the random numbers boids wander with, and restart the boid and step counters they are drawn from
+	void SetRandomSeed(unsigned int a_uSeed);
+
+	//Update all of the boids
+	void Update(float a_fDeltaTime);
+
+	//Get info about boids in the system
+	unsigned int GetBoidCount() const { return static_cast<unsigned int>(m_vpBrains.size()); }
+	const glm::vec3& GetPosition(const unsigned int a_uBoidIndex) const { return m_vV3Positions[a_uBoidIndex]; }
+	const glm::vec3& GetVelocity(const unsigned int a_uBoidIndex) const { return m_vV3Velocities[a_uBoidIndex]; }
+	const glm::vec3& GetForward(const unsigned int a_uBoidIndex) const { return m_vV3Forwards[a_uBoidIndex]; }
+	BrainComponent* GetBrain(const unsigned int a_uBoidIndex) const { return m_vpBrains[a_uBoidIndex]; }
+
+	//Get how often the neighbour lists have been rebuilt, in steps that used the neighbour lists
+	unsigned int GetNeighbourListRebuildCount() const { return m_uNeighbourListRebuildCount; }
+	unsigned int GetNeighbourListStepCount() const { return m_uNeighbourListStepCount; }
+
+private:
+	BoidSystem();
+	~BoidSystem() = default;
+
+	//Forces on a single boid this step, each phase of the pipeline fills them for a whole batch of boids
+	struct BoidForces
+	{
+		glm::vec3 v3Containment;
+		glm::vec3 v3Avoidance;
+		glm::vec3 v3Separation;
+		glm::vec3 v3Alignment;
+		glm::vec3 v3Cohesion;
+		glm::vec3 v3Wander;
+	};
+
+	//Run each phase of the behaviour pipeline over a batch of boids
+	void StepBoidBatch(unsigned int a_uBatchStart, unsigned int a_uBatchEnd, unsigned int a_uThreadIndex, float a_fDeltaTime, const UIInputValues* a_pUIValues);
+	//Sum a boid's forces, integrate it's velocity and position and write them to it's transform
+	void IntegrateBoid(unsigned int a_uBoidIndex, float a_fDeltaTime, const UIInputValues* a_pUIValues, const BoidForces& a_xForces);
+
+	//Steering Behaviours
+	glm::vec3 CalculateSeekForce(const glm::vec3& a_v3Target, const glm::vec3& a_v3CurrentPos, const glm::vec3& a_v3CurrentVelocity) const;
+	glm::vec3 CalculateFleeForce(const glm::vec3& a_v3Target, const glm::vec3& a_v3CurrentPos, const glm::vec3& a_v3CurrentVelocity) const;
+	glm::vec3 CalculateWanderForce(unsigned int a_uBoidIndex, const UIInputValues* a_pUIValues);
+	//Move every boid's collision body to it's transform, after the boid state has been replaced
+	void SyncCollisionBodies();
+	//Neighbour Lists
+	void UpdateNeighbourLists(float a_fSkin);
+	void RebuildNeighbourLists(float a_fListRadius);
+	//Flocking Behaviours
+	glm::vec3 CalculateFlockingForces(unsigned int a_uBoidIndex, unsigned int a_uThreadIndex, glm::vec3& a_v3SeparationForce, glm::vec3& a_v3AlignmentForce, glm::vec3& a_v3CohesionForce);
+	void ApplyFlockingWeights(const UIInputValues* a_pUIValues, glm::vec3& a_v3SeparationForce, glm::vec3& a_v3AlignmentForce, glm::vec3& a_v3CohesionForce) const;
+	//Collision Avoidance
+	glm::vec3 CalculateCollisionForces(unsigned int a_uBoidIndex, glm::vec3& a_v3ContainmentForce, glm::vec3& a_v3CollisionAvoidForce) const;
+	glm::vec3 CalculateContainmentForce(const RayCastHitsInfo& a_rayCastHits) const;
+	glm::vec3 CalculateAvoidanceForce(const RayCastHitsInfo& a_rayCastHits) const;
+	glm::vec3 CalculateBoundsContainmentForce(unsigned int a_uBoidIndex) const;
+
+	//Steering Helper Functions
+	static glm::vec3 GetPointDirection(const glm::vec3& a_v3Start, const glm::vec3& a_v3End);
+
+	//Number of rays cast around each boid to check for collisions (forward, right and up plus their inverses)
+	static constexpr unsigned int sc_uCollisionRayCount = 6u;
+
+	//Function for getting the end points of the current collision rays
+	unsigned int GetCollisionRays(unsigned int a_uBoidIndex, glm::vec3 (&a_aV3RayEndPoints)[sc_uCollisionRayCount]) const;
+
+	/*
+	 * Boid state, each array is indexed by the boid index
+	 * stored in the boid's brain component
+	 */
+	std::vector<glm::vec3> m_vV3Positions; //Current position of each boid
+	std::vector<glm::vec3> m_vV3Velocities; //Current velocity of each boid
+	std::vector<glm::vec3> m_vV3Forwards; //Current forward direction of each boid
+	std::vector<glm::vec3> m_vV3WanderPoints; //Projected point each boid is wandering to
+	std::vector<BrainComponent*> m_vpBrains; //Brain that owns each boid
+	std::vector<unsigned int> m_vuRandomStreams; //Random stream of each boid, so it's random numbers do not change when it's index does
+
+	//Neighbour candidates from the spatial grid for each job system thread, kept between
+	//boids so that we do not reallocate the list every time we build a neighbour list
+	std::vector<std::vector<const SpatialGridEntry*>> m_vvpNeighbourCandidates;
+	//Neighbour candidates for each job system thread laid out for the flocking kernel, kept
+	//between boids so that we do not reallocate them every time we flock
+	std::vector<FlockingCandidates> m_vxFlockingCandidates;
+
+	/*
+	 * Verlet neighbour lists, each boid keeps a list of every boid that was within the neighbour
+	 * radius plus a skin when the lists were built. No boid can get within the neighbour radius of a boid
+	 * that is not on it's list until one of them has moved half the skin, so the lists are only rebuilt then
+	 */
+	bool m_bUseNeighbourLists; //If flocking uses the lists rather than searching the spatial grid
+	bool m_bNeighbourListsDirty; //Set when boids are added or removed, as boid indices change
+	float m_fNeighbourListRadius; //Radius the lists were built with, the neighbour radius plus the skin
+	std::vector<std::vector<unsigned int>> m_vvuNeighbourLists; //Index of each boid on the list of each boid
+	std::vector<glm::vec3> m_vV3NeighbourListPositions; //Position of each boid when the lists were built
+	//State of each boid at the start of the frame, read through the lists so every boid sees the same flock
+	std::vector<glm::vec3> m_vV3FramePositions;
+	std::vector<glm::vec3> m_vV3FrameVelocities;
+	//Counters so we can see how often the lists are rebuilt
+	unsigned int m_uNeighbourListRebuildCount;
+	unsigned int m_uNeighbourListStepCount;
+
+	//Set when the boid state is replaced without moving the collision bodies (e.g loading a snapshot),
+	//moving every body rebuilds most of the broadphase so it is left until the next step needs them
+	bool m_bCollisionBodiesDirty;
+
+	/*
+	 * Counter based random numbers, each random number a boid draws comes from it's stream and the
+	 * step number, so boids can draw them on any thread and the same seed always gives the same run
+	 */
+	uint64_t m_uRandomKey; //Key of the wander random numbers, from the seed
+	unsigned int m_uNextRandomStream; //Stream that the next boid added gets
+	uint64_t m_uRandomStep; //Number of steps since the seed was set
+
+	//Debug UI Instance used to apply weights
+	DebugUI* m_pDebugUI;
+
+	//Radius that boids consider other boids their neighbours
+	float m_fNeighbourRadius;
+
+	//If boids are kept inside the world using the bounds size rather than raycasting
+	//the walls, and the distance from the center of the world to the walls on each axis
+	bool m_bAnalyticContainment;
+	glm::vec3 m_v3ContainmentExtent;
+
+	#pragma region Boid Defaults
+
+	/*
+	 * Defaults for the boid, limitiing it's speed, velocity
+	 * and force per frame
+	 */
+	//Max force that can be applied each frame
+	const glm::vec3 mc_v3MaxForce = glm::vec3(20.f, 20.f, 20.f);
+	const glm::vec3 mc_v3MinForce = glm::vec3(-20.f, -20.f, -20.f);
+	//Overall maximum and minimum velocities
+	const glm::vec3 mc_v3MaxVelocity = glm::vec3(2.f, 2.f, 2.f);
+	const glm::vec3 mc_v3MinVelocity = glm::vec3(-2.f, -2.f, -2.f);
+
+	//Number of boids that are updated in each job
+	static constexpr unsigned int sc_uBoidsPerJob = 32u;
+
+	#pragma endregion
+};
+
+#endif //!__BOID_SYSTEM_H__
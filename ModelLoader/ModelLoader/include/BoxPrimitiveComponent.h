@@ -15,6 +15,8 @@ public:
 	explicit BoxPrimitiveComponent(Entity* a_pOwner, glm::vec3 a_v3BoxDimensions = glm::vec3(1, 1, 1));
 	~BoxPrimitiveComponent() = default;
 
+	DECLARE_POOLED_ALLOCATION()
+
 	//Function to set size
 	void SetDimensions(glm::vec3 a_v3NewDimensions);
 	
@@ -22,8 +24,10 @@ public:
 	void Update(float a_fDeltaTime) override = 0;
 	void Draw(Shader* a_pShader) override;
 
-	//Get text name of the component
+	//Get text name/type of the component
 	const char* GetComponentName() const override;
+	COMPONENT_TYPE GetComponentType() const override { return sc_eComponentType; }
+	static constexpr COMPONENT_TYPE sc_eComponentType = COMPONENT_TYPE::COMPONENT_TYPE_BOX_PRIMITIVE;
 private:
 	//Dimentions of the box
 	glm::vec3 m_v3BoxDimensions;
@@ -1,92 +1,53 @@
 #ifndef __BRAIN_COMPONENT_H__
 #define	__BRAIN_COMPONENT_H__
 
-//C++ Includes
-#include <vector>
-
 //GLM Includes
 #include <glm/glm.hpp>
 
-//RP3D Inlcudes
-#include "ReactPhysics3D/reactphysics3d.h"
-
 //Project Includes
 #include "Component.h"
 
 //Forward Declare
-class ColliderComponent;
-class RayCastHitsInfo;
 class Entity;
 class Shader;
-class DebugUI;
-struct UIInputValues;
-struct RayCastHit;
 
 /// <summary>
-/// Component to control all of the flocking, steering and collision avoidance
-/// behaviours of a boid
+/// Component that marks an entity as a boid. The flocking, steering and collision avoidance
+/// state of the boid lives in the BoidSystem, this component is a handle in to that state
 /// </summary>
 class BrainComponent : public Component
 {
+	friend class BoidSystem;
 public:
 	explicit BrainComponent(Entity* a_pOwner);
-	~BrainComponent() = default;
+	~BrainComponent();
 
-	void Update(float a_fDeltaTime) override;
+	DECLARE_POOLED_ALLOCATION()
+
+	void Update(float a_fDeltaTime) override {};
 	void Draw(Shader* a_pShader) override {};
 
-	glm::vec3 GetCurrentVelocity() const { return m_v3CurrentVelocity; }
+	glm::vec3 GetCurrentVelocity() const;
+
+	//Get the index of this boid in the boid system
+	unsigned int GetBoidIndex() const { return m_uBoidIndex; }
 
 	//Get text name of the component
 	const char* GetComponentName() const override;
+
+	//Get type of the component, used to find the component on it's owner
+	COMPONENT_TYPE GetComponentType() const override { return sc_eComponentType; }
+	static constexpr COMPONENT_TYPE sc_eComponentType = COMPONENT_TYPE::COMPONENT_TYPE_BRAIN;
 	
 private:
-	
-	//Steering Behaviours
-	glm::vec3 CalculateSeekForce(const glm::vec3& a_v3Target, const glm::vec3& a_v3CurrentPos) const;
-	glm::vec3 CalculateFleeForce(const glm::vec3& a_v3Target, const glm::vec3& a_v3CurrentPos) const;
-	glm::vec3 CalculateWanderForce(UIInputValues* a_pUIValues);
-	//Flocking Behaviours
-	glm::vec3 CalculateFlockingForces(glm::vec3& a_v3SeparationForce, glm::vec3& a_v3AlignmentForce, glm::vec3& a_v3CohesionForce) const;
-	void ApplyFlockingWeights(glm::vec3& a_v3SeparationForce, glm::vec3& a_v3AlignmentForce, glm::vec3& a_v3CohesionForce) const;
-	//Collision Avoidance
-	glm::vec3 CalculateCollisionForces(glm::vec3& a_v3ContainmentForce, glm::vec3& a_v3CollisionAvoidForce) const;
-	glm::vec3 CalculateContainmentForce(std::vector<RayCastHit*>& a_vRayCastHits) const;
-	glm::vec3 CalculateAvoidanceForce(std::vector<RayCastHit*>& a_vRayCastHits) const;
 
-	//Steering Helper Functions
-	inline glm::vec3 GetPointDirection(const glm::vec3& a_v3Start, const glm::vec3& a_v3End) const;
+	//Set by the boid system when boids are moved around in it's storage
+	void SetBoidIndex(const unsigned int a_uBoidIndex) { m_uBoidIndex = a_uBoidIndex; }
 
-	//Function for getting the current ray directions
-	std::vector<rp3d::Ray*> GetCollisionRays() const;
-	
-	//Current Velocity of the boid
-	glm::vec3 m_v3CurrentVelocity;
-	
-	//Projected point we are wandering to
-	glm::vec3 m_v3WanderPoint;
-
-	//Debug UI Instance used to apply weights
-	DebugUI* m_pDebugUI;
+	//Index of this boid in the boid system
+	unsigned int m_uBoidIndex;
 
 	const char* m_szName = "Brain";
-	
-	#pragma region Boid Defaults
-	
-	/*
-	 * Defaults for the boid, limitiing it's speed, velocity
-	 * and force per frame
-	 */
-	//Max force that can be applied each frame
-	const glm::vec3 mc_v3MaxForce = glm::vec3(20.f, 20.f, 20.f);
-	const glm::vec3 mc_v3MinForce = glm::vec3(-20.f,-20.f,-20.f);
-	//Overall maximum and minimum velocities
-	const glm::vec3 mc_v3MaxVelocity = glm::vec3(2.f, 2.f, 2.f);
-	const glm::vec3 mc_v3MinVelocity = glm::vec3(-2.f, -2.f, -2.f);
-
-	float m_fNeighbourRadius = 5.0f;
-	
-	#pragma endregion 
 
 };
 
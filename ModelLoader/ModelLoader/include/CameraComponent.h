@@ -35,6 +35,8 @@ public:
 	CameraComponent(Entity* a_pOwner, GLFWwindow* a_pWindow, glm::vec3 a_v3Pos = sc_v3DefaultPosition, glm::vec3 a_v3Up = sc_v3DefaultUp, float a_fYaw = sc_fDefaultYaw, float a_fPitch = sc_fDefaultPitch);
 	~CameraComponent() = default;
 
+	DECLARE_POOLED_ALLOCATION()
+
 	
 	//Reqiured Update/Draw Functions
 	void Update(float a_fDeltaTime) override;
@@ -52,6 +54,11 @@ public:
 
 	//Get text name of the component
 	const char* GetComponentName() const override;
+
+	//Get type of the component, used to find the component on it's owner
+	COMPONENT_TYPE GetComponentType() const override { return sc_eComponentType; }
+	static constexpr COMPONENT_TYPE sc_eComponentType = COMPONENT_TYPE::COMPONENT_TYPE_CAMERA;
+
 private:
 	void UpdateCameraVectors() const;
 
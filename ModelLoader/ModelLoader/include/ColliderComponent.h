@@ -17,6 +17,18 @@ class CollisionInfo;
 class RayCastHitsInfo;
 struct RayCastHit;
 
+/// <summary>
+/// Categories that a collider can belong to, these are used as
+/// the rp3d category bits so raycasts can ignore whole categories
+/// </summary>
+enum class COLLISION_CATEGORY : unsigned short
+{
+	COLLISION_CATEGORY_DEFAULT = 0x0001,
+	COLLISION_CATEGORY_CONTAINER = 0x0002,
+
+	COLLISION_CATEGORY_ALL = 0xFFFF //Mask of every category
+};
+
 /// <summary>
 /// Component used for detecting collisions between entities in the world
 /// </summary>
@@ -24,15 +36,22 @@ class ColliderComponent : public Component {
 	friend class CollisionInfo;
 	friend class RayCastHitsInfo;
 public:
-	ColliderComponent(Entity* a_pOwner, rp3d::CollisionWorld* a_pCollisionWorld);
+	ColliderComponent(Entity* a_pOwner, rp3d::CollisionWorld* a_pCollisionWorld, rp3d::CollisionBody* a_pCollisionBody = nullptr);
 	~ColliderComponent();
 
+	DECLARE_POOLED_ALLOCATION()
+
 	void Update(float a_fDeltaTime) override;
 	void Draw(Shader* a_pShader) override;
 
 	//Functions to add collider shapes
 	void AddBoxCollider(glm::vec3 a_v3BoxSize, glm::vec3 a_v3Offset);
 	void AddSphereCollider(float a_fSphereSize, glm::vec3 a_v3Offset);
+	//Add a shape that has already been made, the collider deletes it unless it is released
+	void AddCollisionShape(rp3d::CollisionShape* a_pCollisionShape, glm::vec3 a_v3Offset);
+
+	//Set the category that all of the collider shapes are in
+	void SetCollisionCategory(COLLISION_CATEGORY a_eCategory);
 
 	//Functions to check for a collision
 	bool IsColliding(bool a_bUseAABB) const;
@@ -42,8 +61,19 @@ public:
 	std::vector<CollisionInfo*> GetCollisionInfo() const;
 	CollisionInfo* GetCollisionInfo(ColliderComponent* a_pOtherCollider) const;
 
+	//Get the rp3d body of this collider
+	rp3d::CollisionBody* GetCollisionBody() const { return m_pCollisionBody; }
+	//Take the rp3d body away from this collider, without it's shapes, so it can be given to another collider
+	rp3d::CollisionBody* ReleaseCollisionBody();
+	//Take the shapes away from this collider once it's body has been released, so they can be given to another collider
+	void ReleaseCollisionShapes(std::vector<rp3d::CollisionShape*>& a_vpCollisionShapes);
+
 	//Get text name of the component
 	const char* GetComponentName() const override;
+
+	//Get type of the component, used to find the component on it's owner
+	COMPONENT_TYPE GetComponentType() const override { return sc_eComponentType; }
+	static constexpr COMPONENT_TYPE sc_eComponentType = COMPONENT_TYPE::COMPONENT_TYPE_COLLIDER;
 	
 private:
 	
@@ -52,15 +82,18 @@ private:
 	bool IsCollisionCheckValid(ColliderComponent* a_pOtherCollider) const;
 
 	//Function to get a entity from a collision body
-	static Entity* GetEntityFromCollisionBody(rp3d::CollisionBody* a_collisionBody);
+	static Entity* GetEntityFromCollisionBody(const rp3d::CollisionBody* a_collisionBody);
 	
 	rp3d::CollisionBody* m_pCollisionBody; //Pointer to the rp3d collision body that is used in the physics system
 	rp3d::CollisionWorld* m_pCollisionWorld; //Pointer to the physics world that this object is using
+	COLLISION_CATEGORY m_eCollisionCategory; //Category that all of our shapes are in
 
 	//Collision Shapes - physical shape that we use and the proxy shape,
-	//used by the collision system
-	std::vector<rp3d::CollisionShape*> m_apCollisionShapes; //List of physical shapes used
-	std::vector<rp3d::ProxyShape*> m_apProxyShapes; //List of proxy shapes. Proxy shape is the collision shape with mass and transform info
+	//used by the collision system. The lists take their memory from a pool
+	//while they have a few shapes, so spawning a collider reuses it
+	static constexpr unsigned int sc_uPooledShapeCount = 4u;
+	std::vector<rp3d::CollisionShape*, PooledArrayAllocator<rp3d::CollisionShape*, sc_uPooledShapeCount>> m_apCollisionShapes; //List of physical shapes used
+	std::vector<rp3d::ProxyShape*, PooledArrayAllocator<rp3d::ProxyShape*, sc_uPooledShapeCount>> m_apProxyShapes; //List of proxy shapes. Proxy shape is the collision shape with mass and transform info
 
 	//Constants for debug collider drawing
 	const glm::vec4 mc_v4ColliderDrawCol = glm::vec4(0, 0, 0, 1);
@@ -1,10 +1,29 @@
 #ifndef __COMPONENT_H__
 #define __COMPONENT_H__
 
+//Project Includes
+#include "ObjectPool.h"
+
 //Forward Declare
 class Entity;
 class Shader;
 
+//Enum for Types of component, each type has a slot
+//in it's owner entity's component table
+enum class COMPONENT_TYPE
+{
+	COMPONENT_TYPE_TRANSFORM,
+	COMPONENT_TYPE_MODEL,
+	COMPONENT_TYPE_BRAIN,
+	COMPONENT_TYPE_COLLIDER,
+	COMPONENT_TYPE_RAYCAST,
+	COMPONENT_TYPE_CAMERA,
+	COMPONENT_TYPE_OBSTACLE_SPAWNER,
+	COMPONENT_TYPE_SPHERE_PRIMITIVE,
+	COMPONENT_TYPE_BOX_PRIMITIVE,
+
+	COMPONENT_TYPE_COUNT //Total number of component types
+};
 
 /// <summary>
 /// Abstract class for component types to inherit from
@@ -19,6 +38,7 @@ public:
 	virtual void Draw(Shader* a_pShader) = 0; //Pure Virtual Function
 
 	virtual const char* GetComponentName() const = 0; //Pure Virtual Function
+	virtual COMPONENT_TYPE GetComponentType() const = 0; //Pure Virtual Function
 
 	Entity* GetOwnerEntity() const;
 	void RemoveOwnerEntity();
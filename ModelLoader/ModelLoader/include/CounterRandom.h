@@ -0,0 +1,111 @@
+#ifndef __COUNTER_RANDOM_H__
+#define __COUNTER_RANDOM_H__
+
+//C++ Includes
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+//GLM Includes
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+/// <summary>
+/// Parts of the simulation that draw random numbers, each gets it's own key from the seed
+/// so that the numbers they draw are not related to each other
+/// </summary>
+enum class RANDOM_DOMAIN : unsigned int
+{
+	RANDOM_DOMAIN_GLOBAL,
+	RANDOM_DOMAIN_SPAWN,
+	RANDOM_DOMAIN_WANDER,
+
+	RANDOM_DOMAIN_COUNT
+};
+
+/// <summary>
+/// Counter based random number generator. Rather than stepping a shared state, each random number
+/// is a hash of a key (from the seed), a stream (e.g a boid) and a counter (e.g the step and draw number).
+/// There is no state to share, so any thread can draw any number in any order and always get the same
+/// value for the same seed. The hash is the SplitMix64 finalizer applied to each input in turn
+/// </summary>
+class CounterRandom
+{
+public:
+	//Get the key of a domain for a seed
+	static uint64_t GetKey(uint64_t a_uSeed, RANDOM_DOMAIN a_eDomain);
+
+	//Get 64 random bits for a key, stream and counter
+	static uint64_t GetBits(uint64_t a_uKey, uint64_t a_uStream, uint64_t a_uCounter);
+
+	//Get a random float in [a_fStart, a_fEnd)
+	static float GetRange(float a_fStart, float a_fEnd, uint64_t a_uKey, uint64_t a_uStream, uint64_t a_uCounter);
+	//Get a random point on the surface of a sphere, without rejection sampling so there are no
+	//branches and a loop over many streams can be vectorized
+	static glm::vec3 GetPointOnSphere(float a_fRadius, uint64_t a_uKey, uint64_t a_uStream, uint64_t a_uCounter);
+
+private:
+	//Mix the bits of a value, the SplitMix64 finalizer
+	static uint64_t Mix(uint64_t a_uValue);
+	//Turn 32 random bits in to a float in [0, 1)
+	static float ToUnitFloat(uint32_t a_uBits);
+};
+
+/// <summary>
+/// Get the key of a domain for a seed
+/// </summary>
+inline uint64_t CounterRandom::GetKey(const uint64_t a_uSeed, const RANDOM_DOMAIN a_eDomain)
+{
+	return Mix(Mix(a_uSeed) + static_cast<uint64_t>(a_eDomain));
+}
+
+/// <summary>
+/// Get 64 random bits, the same key, stream and counter always give the same bits
+/// </summary>
+inline uint64_t CounterRandom::GetBits(const uint64_t a_uKey, const uint64_t a_uStream, const uint64_t a_uCounter)
+{
+	return Mix(Mix(a_uKey ^ a_uStream) + a_uCounter);
+}
+
+/// <summary>
+/// Get a random float in [a_fStart, a_fEnd)
+/// </summary>
+inline float CounterRandom::GetRange(const float a_fStart, const float a_fEnd, const uint64_t a_uKey, const uint64_t a_uStream, const uint64_t a_uCounter)
+{
+	const float fUnit = ToUnitFloat(static_cast<uint32_t>(GetBits(a_uKey, a_uStream, a_uCounter) >> 32));
+	return a_fStart + fUnit * (a_fEnd - a_fStart);
+}
+
+/// <summary>
+/// Get a random point on the surface of a sphere. Uses one set of bits for both angles, the height
+/// on the sphere is uniform in [-1, 1] which makes the points uniform over the surface
+/// </summary>
+inline glm::vec3 CounterRandom::GetPointOnSphere(const float a_fRadius, const uint64_t a_uKey, const uint64_t a_uStream, const uint64_t a_uCounter)
+{
+	const uint64_t uBits = GetBits(a_uKey, a_uStream, a_uCounter);
+	const float fZ = ToUnitFloat(static_cast<uint32_t>(uBits >> 32)) * 2.f - 1.f;
+	const float fAngle = ToUnitFloat(static_cast<uint32_t>(uBits)) * glm::two_pi<float>();
+	const float fRingRadius = std::sqrt(std::max(0.f, 1.f - fZ * fZ));
+	return glm::vec3(fRingRadius * std::cos(fAngle), fRingRadius * std::sin(fAngle), fZ) * a_fRadius;
+}
+
+/// <summary>
+/// Mix the bits of a value so that every input bit affects every output bit
+/// </summary>
+inline uint64_t CounterRandom::Mix(uint64_t a_uValue)
+{
+	a_uValue += 0x9E3779B97F4A7C15ull;
+	a_uValue = (a_uValue ^ (a_uValue >> 30)) * 0xBF58476D1CE4E5B9ull;
+	a_uValue = (a_uValue ^ (a_uValue >> 27)) * 0x94D049BB133111EBull;
+	return a_uValue ^ (a_uValue >> 31);
+}
+
+/// <summary>
+/// Turn random bits in to a float in [0, 1), using the top 24 bits as that is all a float can hold
+/// </summary>
+inline float CounterRandom::ToUnitFloat(const uint32_t a_uBits)
+{
+	return static_cast<float>(a_uBits >> 8) * (1.f / 16777216.f);
+}
+
+#endif //!__COUNTER_RANDOM_H__
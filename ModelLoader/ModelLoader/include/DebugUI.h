@@ -40,11 +40,23 @@ struct UIInputValues
 	UIRange<float> fInputWanderRadius			= UIRange<float>(0.625f, 0.001f, 2.f); //0.001 as we cannot have a 0 radius sphere
 	//NEIGHBOUR RADIUS
 	UIRange<float> fInputNeighbourRadius		= UIRange<float>(4.f, 0.01f, 5.0f);
+	bool bNeighbourLists = false; //Find neighbours with Verlet lists that are reused between frames rather than searching the grid each frame
+	UIRange<float> fNeighbourListSkin			= UIRange<float>(1.f, 0.05f, 4.f); //Distance past the neighbour radius that boids are kept on the lists
 	//WORLD SETTINGS
 	UIRange<int> iInputWorldBounds				= UIRange<int>(20, 0, 100);
 	UIRange<int> iBoidCount						= UIRange<int>(100, 0, 250);
+	bool bAnalyticContainment = true; //Contain boids using the bounds size rather than raycasting the walls
+	//SIMULATION TICK
+	UIRange<float> fFixedTimeStep				= UIRange<float>(1.f / 60.f, 1.f / 240.f, 1.f / 10.f);
+	UIRange<int> iMaxSubSteps					= UIRange<int>(5, 1, 20);
+	bool bInterpolateTransforms = true;
+	//RENDERING
+	bool bInstancedRendering = true; //Draw all boids with the same model in one draw call per mesh
+	//THREADING
+	UIRange<int> iThreadCount					= UIRange<int>(1, 1, 64); //Set to the job system's thread count when the UI is created
 	//DEBUG
 	bool bShowColliders = false;
+	UIRange<int> iTraceFrames					= UIRange<int>(120, 1, 1000); //Number of frames recorded by a trace
 };
 
 // ReSharper restore CppInconsistentNaming
@@ -63,17 +75,29 @@ public:
 	
 private:
 
-	DebugUI() : Singleton() {};
+	DebugUI();
 	~DebugUI(){};
 
 	void DrawDebugUI();
 	void DrawInspector() const;
+	void DrawProfiler();
 
 	//UI Positions
 	const ImVec2 m_v2DebugWindowPos = ImVec2(0, 0);
 	const ImVec2 m_v2DebugWindowSize = ImVec2(550, 460);
 	const ImVec2 m_v2InspectorPos = ImVec2(976, 0);
 	const ImVec2 m_v2InspectorSize = ImVec2(300, 600);
+	const ImVec2 m_v2ProfilerPos = ImVec2(0, 460);
+	const ImVec2 m_v2ProfilerSize = ImVec2(550, 340);
+
+	//File the profiler stats are written to
+	const char* m_szProfilerReportPath = "profile_report.csv";
+	//File traces are written to
+	const char* m_szTracePath = "trace.json";
+	//File the simulation is saved to and loaded from
+	const char* m_szSnapshotPath = "snapshot.bin";
+	//File the boids are recorded to
+	const char* m_szTrajectoryPath = "trajectory.btrj";
 
 
 	//All of the UI Values
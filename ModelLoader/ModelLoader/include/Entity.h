@@ -3,12 +3,14 @@
 
 //std includes
 #include <vector>
-#include <map>
+#include <type_traits>
 
 //Project Includes
 #include <string>
 
 #include "Component.h"
+#include "EntityRegistry.h"
+#include "ObjectPool.h"
 
 //Forward Declare
 class Shader;
@@ -35,6 +37,8 @@ public:
 	Entity();
 	virtual ~Entity();
 
+	DECLARE_POOLED_ALLOCATION()
+
 	virtual void Update(float a_fDeltaTime);
 	virtual void Draw(Shader* a_pShader);
 
@@ -52,18 +56,22 @@ public:
 	template<class returnType>
 	returnType GetComponent() const;
 	
-	unsigned int GetEntityID() const { return m_uEntityID; }
-	static const std::map<const unsigned int, Entity*>& GetEntityMap() { return s_xEntityMap; }
+	//The entity ID is the entity's registry slot, so it is only unique between entities that exist at the same time
+	unsigned int GetEntityID() const { return m_xHandle.uSlot; }
+	EntityHandle GetEntityHandle() const { return m_xHandle; }
+	static const EntityRegistry& GetEntityRegistry() { return s_xEntityRegistry; }
 
 private:
+	//The component list takes it's memory from a pool with room for a component of every type, so spawning an entity reuses it
+	typedef std::vector<Component*, PooledArrayAllocator<Component*, static_cast<unsigned int>(COMPONENT_TYPE::COMPONENT_TYPE_COUNT)>> ComponentList;
 
 	ENTITY_TYPE m_eEntityType; //Type of entity, used for collision resolution
 	
-	unsigned int m_uEntityID; //ID of this entity
-	std::vector<Component*> m_apComponentList;
+	EntityHandle m_xHandle; //Handle of this entity in the registry
+	ComponentList m_apComponentList;
+	Component* m_apComponentSlots[static_cast<unsigned int>(COMPONENT_TYPE::COMPONENT_TYPE_COUNT)]; //Component of each type, indexed by COMPONENT_TYPE
 
-	static unsigned int s_uNextEntityID; //ID of the next entity to spawn
-	static std::map<const unsigned int, Entity*> s_xEntityMap; //Map of all entites that exist
+	static EntityRegistry s_xEntityRegistry; //Registry of all entites that exist
 };
 
 /// <summary>
@@ -78,22 +86,16 @@ private:
 template<class returnType>
 returnType Entity::GetComponent() const
 {
-	//Loop through all of the components that we have,
-	//try and cast each one to the returnType, if we can cast to it
-	//then it is a component of the type that we are looking to return, so return it.
-	//If we go through all of the components that we have and have not succesfully
-	//cast then we do not have a component of returnType, so return nullptr.
-	std::vector<Component*>::const_iterator xIter;
-	for (xIter = m_apComponentList.begin(); xIter < m_apComponentList.end(); ++xIter)
-	{
-		returnType pComponent = dynamic_cast<returnType>(*xIter);
-		if (pComponent != nullptr)
-		{
-			return pComponent;
-		}
-	}
-
-	return nullptr;
+	//Each component type has a compile time type id which is used as the index
+	//of it's slot in our component table, so we can look up the slot directly
+	//rather than trying to cast every component that we have
+	typedef typename std::remove_pointer<returnType>::type ComponentType;
+	static_assert(std::is_base_of<Component, ComponentType>::value, "GetComponent type must be a Component*");
+	//A type that inherits it's component type would look up it's parent's slot, which can hold a different
+	//type of component. The type is declared alongside GetComponentType, which we can check is not inherited
+	static_assert(std::is_same<decltype(&ComponentType::GetComponentType), COMPONENT_TYPE (ComponentType::*)() const>::value,
+		"GetComponent type must declare it's own component type");
+	return static_cast<returnType>(m_apComponentSlots[static_cast<unsigned int>(ComponentType::sc_eComponentType)]);
 }
 
 #endif // ! __ENTITY_H__
@@ -0,0 +1,64 @@
+#ifndef __ENTITY_REGISTRY_H__
+#define __ENTITY_REGISTRY_H__
+
+//C++ Includes
+#include <vector>
+
+//Forward Declare
+class Entity;
+
+/// <summary>
+/// Handle to an entity in the registry. The slot stays the same for the life of the entity
+/// and the generation changes each time the slot is reused, so a handle to an entity that
+/// has been destroyed never finds the entity that took it's slot
+/// </summary>
+struct EntityHandle
+{
+	unsigned int uSlot;
+	unsigned int uGeneration;
+
+	bool operator==(const EntityHandle& a_xOther) const { return uSlot == a_xOther.uSlot && uGeneration == a_xOther.uGeneration; }
+	bool operator!=(const EntityHandle& a_xOther) const { return !(*this == a_xOther); }
+};
+
+/// <summary>
+/// Slot map of every entity that exists. Entities are kept packed in one array so that
+/// iterating over them is a linear sweep, with a table of slots (plus a free list of unused
+/// slots) that maps handles to where each entity is in the packed array
+/// </summary>
+class EntityRegistry
+{
+public:
+	EntityRegistry() = default;
+
+	//Add/Remove entities
+	EntityHandle Add(Entity* a_pEntity);
+	void Remove(EntityHandle a_xHandle);
+
+	//Get the entity of a handle, nullptr if the entity has been destroyed
+	Entity* Get(EntityHandle a_xHandle) const;
+	//Get the entity using a slot, whatever generation it is
+	Entity* GetInSlot(unsigned int a_uSlot) const;
+
+	//Packed list of every entity, entities may move in this list when others are removed
+	const std::vector<Entity*>& GetEntities() const { return m_vpEntities; }
+	unsigned int GetEntityCount() const { return static_cast<unsigned int>(m_vpEntities.size()); }
+
+private:
+	//Where the entity in a slot is in the packed array
+	struct Slot
+	{
+		unsigned int uPackedIndex;
+		unsigned int uGeneration;
+		bool bInUse;
+	};
+
+	std::vector<Slot> m_vSlots;
+	std::vector<unsigned int> m_vuFreeSlots; //Slots that are not in use, the last one is reused first
+
+	//Packed entities and the slot of each of them, so we can fix up the slot when an entity moves
+	std::vector<Entity*> m_vpEntities;
+	std::vector<unsigned int> m_vuEntitySlots;
+};
+
+#endif //!__ENTITY_REGISTRY_H__
@@ -0,0 +1,127 @@
+#ifndef __FLOCKING_KERNEL_H__
+#define __FLOCKING_KERNEL_H__
+
+//C++ Includes
+#include <vector>
+
+//GLM Includes
+#include <glm/glm.hpp>
+
+/// <summary>
+/// Instruction sets the flocking kernel can use
+/// </summary>
+enum class FLOCKING_KERNEL : int
+{
+	FLOCKING_KERNEL_SCALAR,
+	FLOCKING_KERNEL_SSE2,
+	FLOCKING_KERNEL_AVX2,
+
+	FLOCKING_KERNEL_COUNT
+};
+
+/// <summary>
+/// Sums of the flocking influences of every candidate within the neighbour radius
+/// </summary>
+struct FlockingSums
+{
+	glm::vec3 v3Separation; //Sum of owner - neighbour position
+	glm::vec3 v3Alignment; //Sum of neighbour velocities
+	glm::vec3 v3Cohesion; //Sum of neighbour positions
+	int iNeighbourCount; //Number of candidates that were within the radius
+};
+
+//Forward Declare
+struct FlockingCandidates;
+
+/// <summary>
+/// Kernel that tests 8 neighbour candidates at once against the squared neighbour radius and adds
+/// the separation, alignment and cohesion of the ones in range. The widest instruction set the
+/// CPU supports is picked when the program starts. Every instruction set sums the candidates
+/// in the same 8 lanes and adds the lanes together in the same order, so they all give the same result
+/// </summary>
+class FlockingKernel
+{
+public:
+	//Number of candidates tested at once, the size of each candidate block
+	static constexpr unsigned int sc_uLaneCount = 8u;
+
+	//Sum the influences of the candidates that are within the radius of the owner
+	static FlockingSums Accumulate(const glm::vec3& a_v3OwnerPos, float a_fRadius, const FlockingCandidates& a_xCandidates);
+
+	//Get/Set the instruction set that is used, setting one the CPU does not support is ignored
+	static FLOCKING_KERNEL GetKernel();
+	static bool SetKernel(FLOCKING_KERNEL a_eKernel);
+	static bool IsKernelSupported(FLOCKING_KERNEL a_eKernel);
+	static const char* GetKernelName(FLOCKING_KERNEL a_eKernel);
+
+private:
+	//Get the widest instruction set the CPU supports, using CPUID
+	static FLOCKING_KERNEL DetectKernel();
+
+	static FLOCKING_KERNEL s_eKernel;
+};
+
+/// <summary>
+/// Neighbour candidates of a single boid, stored in blocks of 8 candidates where each block holds the
+/// 8 x positions, then the 8 y positions and so on. The kernel loads the same value of 8 candidates
+/// at once, and a whole block is next to each other in memory
+/// </summary>
+struct FlockingCandidates
+{
+	//Values in each block
+	enum class BLOCK_VALUE : unsigned int
+	{
+		BLOCK_VALUE_POSITION_X,
+		BLOCK_VALUE_POSITION_Y,
+		BLOCK_VALUE_POSITION_Z,
+		BLOCK_VALUE_VELOCITY_X,
+		BLOCK_VALUE_VELOCITY_Y,
+		BLOCK_VALUE_VELOCITY_Z,
+
+		BLOCK_VALUE_COUNT
+	};
+
+	//Remove all of the candidates, keeping the memory
+	void Clear() { uCount = 0u; }
+	//Add a candidate to the end of the blocks, inline as it is called for every candidate of every boid
+	void Add(const glm::vec3& a_v3Position, const glm::vec3& a_v3Velocity)
+	{
+		const unsigned int uLane = uCount % FlockingKernel::sc_uLaneCount;
+		if (uLane == 0u)
+		{
+			AddBlock();
+		}
+
+		//Values are stored in the order of BLOCK_VALUE
+		float* pLane = &vfBlocks[(uCount / FlockingKernel::sc_uLaneCount) * sc_uBlockSize + uLane];
+		pLane[0u * FlockingKernel::sc_uLaneCount] = a_v3Position.x;
+		pLane[1u * FlockingKernel::sc_uLaneCount] = a_v3Position.y;
+		pLane[2u * FlockingKernel::sc_uLaneCount] = a_v3Position.z;
+		pLane[3u * FlockingKernel::sc_uLaneCount] = a_v3Velocity.x;
+		pLane[4u * FlockingKernel::sc_uLaneCount] = a_v3Velocity.y;
+		pLane[5u * FlockingKernel::sc_uLaneCount] = a_v3Velocity.z;
+		++uCount;
+	}
+	//Fill the rest of the last block with candidates that are never in range
+	void Pad();
+
+	unsigned int GetCount() const { return uCount; }
+	unsigned int GetBlockCount() const { return (uCount + FlockingKernel::sc_uLaneCount - 1u) / FlockingKernel::sc_uLaneCount; }
+	//Get the 8 values of a block
+	const float* GetBlockValues(const unsigned int a_uBlock, const BLOCK_VALUE a_eValue) const
+	{
+		return &vfBlocks[a_uBlock * sc_uBlockSize + static_cast<unsigned int>(a_eValue) * FlockingKernel::sc_uLaneCount];
+	}
+
+	//Number of floats in each block
+	static constexpr unsigned int sc_uBlockSize = FlockingKernel::sc_uLaneCount * static_cast<unsigned int>(BLOCK_VALUE::BLOCK_VALUE_COUNT);
+
+	std::vector<float> vfBlocks;
+	unsigned int uCount = 0u;
+
+private:
+	//Make sure there is memory for the block the next candidate starts
+	void AddBlock();
+};
+
+#endif //!__FLOCKING_KERNEL_H__
@@ -0,0 +1,18 @@
+#ifndef __HEADLESS_SIMULATION_H__
+#define __HEADLESS_SIMULATION_H__
+
+//Forward Declare
+struct SimulationSettings;
+
+/// <summary>
+/// Runs the boid simulation without a window or GL context for a fixed
+/// number of steps and reports the throughput of the simulation
+/// </summary>
+class HeadlessSimulation
+{
+public:
+	//Run the simulation, returns the exit code for the program
+	static int Run(const SimulationSettings& a_xSettings);
+};
+
+#endif //!__HEADLESS_SIMULATION_H__
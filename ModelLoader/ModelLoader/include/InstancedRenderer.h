@@ -0,0 +1,77 @@
+#ifndef __INSTANCED_RENDERER_H__
+#define __INSTANCED_RENDERER_H__
+
+//C++ Includes
+#include <map>
+#include <vector>
+
+//GLM Includes
+#include <glm/glm.hpp>
+
+//Project Includes
+#include "Singleton.h"
+
+//Forward Declare
+class Model;
+class Shader;
+
+/// <summary>
+/// Renderer that draws models in batches. Every instance of a model that is submitted
+/// during a frame is drawn with one instanced draw call for each mesh of the model, so
+/// the number of draw calls depends on the number of models rather than the number of boids.
+/// Also counts the number of model draw calls made each frame
+/// </summary>
+class InstancedRenderer : public Singleton<InstancedRenderer>
+{
+	friend class Singleton<InstancedRenderer>;
+public:
+
+	//Start a new frame, removing all of the submitted instances and resetting the draw call count
+	void BeginFrame();
+
+	//Add an instance of a model to be drawn when we flush
+	void Submit(Model* a_pModel, const glm::mat4& a_m4ModelMatrix);
+
+	//Draw all of the submitted instances
+	void Flush(Shader* a_pShader);
+
+	//Delete the GL buffers of every model, must be called before the models are unloaded
+	void ReleaseBuffers();
+
+	//Count draw calls that were made without the renderer (i.e drawing models one at a time)
+	void AddDrawCalls(const unsigned int a_uDrawCallCount) { m_uDrawCallCount += a_uDrawCallCount; }
+
+	//Get the number of model draw calls made since the start of the frame
+	unsigned int GetDrawCallCount() const { return m_uDrawCallCount; }
+
+	//Vertex attribute location of the instance model matrix in the instanced shader,
+	//uses 4 locations (one for each column)
+	static constexpr unsigned int sc_uInstanceMatrixLocation = 5u;
+
+private:
+	InstancedRenderer();
+	~InstancedRenderer() = default;
+
+	/// <summary>
+	/// All of the instances of a single model and the GL buffer used to draw them
+	/// </summary>
+	struct ModelBatch
+	{
+		std::vector<glm::mat4> vM4Instances; //Model matrix of each instance submitted this frame
+		unsigned int uInstanceBuffer = 0; //GL buffer that the instance matrices are uploaded to
+		unsigned int uInstanceCapacity = 0; //Number of matrices that the buffer can hold
+		std::vector<std::vector<int>> vviSamplerLocations; //Texture sampler uniform locations of each mesh
+		unsigned int uSamplerShaderID = 0; //Shader that the sampler locations were found in
+	};
+
+	//Setup helper functions
+	void CreateInstanceBuffer(Model* a_pModel, ModelBatch& a_batch) const;
+	void FindSamplerLocations(Model* a_pModel, ModelBatch& a_batch, const Shader* a_pShader) const;
+
+	//Batch for every model that has been drawn
+	std::map<Model*, ModelBatch> m_mBatches;
+
+	unsigned int m_uDrawCallCount; //Number of model draw calls this frame
+};
+
+#endif //!__INSTANCED_RENDERER_H__
@@ -0,0 +1,61 @@
+#ifndef __JOB_SYSTEM_H__
+#define __JOB_SYSTEM_H__
+
+//C++ Includes
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//Project Includes
+#include "Singleton.h"
+
+/// <summary>
+/// Thread pool that runs jobs across a number of worker threads.
+/// The main thread counts as one of the threads, so a thread count of 1
+/// runs everything on the main thread with no workers
+/// </summary>
+class JobSystem : public Singleton<JobSystem>
+{
+	friend class Singleton<JobSystem>;
+public:
+
+	//Function that is run for a range [start, end) of a parallel for, with the index of the
+	//thread that is running it (0 is the main thread)
+	typedef std::function<void(unsigned int a_uStart, unsigned int a_uEnd, unsigned int a_uThreadIndex)> ParallelForJob;
+
+	//Set/Get the number of threads that jobs are run on
+	void SetThreadCount(unsigned int a_uThreadCount);
+	unsigned int GetThreadCount() const { return static_cast<unsigned int>(m_vWorkerThreads.size()) + 1u; }
+	static unsigned int GetHardwareThreadCount();
+
+	//Split a range in to chunks and run them across all threads, blocks until every chunk is done
+	void ParallelFor(unsigned int a_uCount, unsigned int a_uChunkSize, const ParallelForJob& a_fnJob);
+
+	//Run a job on a worker thread without waiting for it to finish
+	void Schedule(const std::function<void()>& a_fnJob);
+
+private:
+	JobSystem();
+	~JobSystem();
+
+	//Start/Stop the worker threads
+	void StartWorkers(unsigned int a_uWorkerCount);
+	void StopWorkers();
+
+	//Loop that each worker thread runs, waiting for and running jobs
+	void WorkerLoop(unsigned int a_uThreadIndex);
+
+	//Queue of jobs waiting for a worker, each job is given the index of the thread that runs it
+	std::deque<std::function<void(unsigned int)>> m_xJobQueue;
+	std::mutex m_xQueueMutex;
+	std::condition_variable m_xJobAvailable;
+	bool m_bStopWorkers;
+
+	std::vector<std::thread> m_vWorkerThreads;
+};
+
+#endif //!__JOB_SYSTEM_H__
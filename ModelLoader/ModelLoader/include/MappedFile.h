@@ -0,0 +1,44 @@
+#ifndef __MAPPED_FILE_H__
+#define __MAPPED_FILE_H__
+
+//C++ Includes
+#include <cstddef>
+#include <string>
+
+/// <summary>
+/// Read only view of a whole file mapped in to memory, so a file can be read
+/// straight from the OS page cache without copying it in to our own buffers.
+/// The file is unmapped when this is closed or destroyed
+/// </summary>
+class MappedFile
+{
+public:
+	MappedFile();
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	//Map/Unmap a file
+	bool Open(const std::string& a_szPath);
+	void Close();
+
+	//Get the mapped file contents
+	bool IsOpen() const { return m_pData != nullptr; }
+	const unsigned char* GetData() const { return m_pData; }
+	size_t GetSize() const { return m_uSize; }
+
+private:
+	const unsigned char* m_pData; //Start of the mapped file
+	size_t m_uSize; //Size of the file in bytes
+
+	//OS handles of the mapping
+#ifdef _WIN32
+	void* m_pFileHandle;
+	void* m_pMappingHandle;
+#else
+	int m_iFileDescriptor;
+#endif
+};
+
+#endif //!__MAPPED_FILE_H__
@@ -1,7 +1,7 @@
 #ifndef __MATHS_UTILS_H__
 #define __MATHS_UTILS_H__
 
-#include <random>
+#include <cstdint>
 
 /// <summary>
 /// Maths utility static class
@@ -15,22 +15,25 @@ public:
 	static T RandomRange(T a_rangeStart, T a_rangeEnd);
 	template<class T>
 	static int RandomRange(int a_rangeStart, int a_rangeEnd);
+
+	//Seed the RNG with a known seed, so runs can be repeated
+	static void SetSeed(unsigned int a_uSeed);
 private:
-	static void SeedRandom();
+	//Get the next random bits, safe to call from any thread
+	static uint64_t NextRandomBits();
 };
 
 template <class T>
 T MathsUtils::RandomRange(T a_rangeStart, T a_rangeEnd)
 {
-	SeedRandom();
-	return a_rangeStart + T(rand() / T(RAND_MAX) * (a_rangeEnd - a_rangeStart));
+	const T unitValue = T(static_cast<uint32_t>(NextRandomBits() >> 40)) / T(16777216);
+	return a_rangeStart + T(unitValue * (a_rangeEnd - a_rangeStart));
 }
 
 template<class T>
 int MathsUtils::RandomRange(int a_rangeStart, int a_rangeEnd)
 {
-	SeedRandom();
-	return a_rangeStart + (rand() % (a_rangeEnd - a_rangeStart));
+	return a_rangeStart + static_cast<int>(NextRandomBits() % static_cast<uint64_t>(a_rangeEnd - a_rangeStart));
 }
 
 
@@ -0,0 +1,95 @@
+#ifndef __MODEL_CACHE_H__
+#define __MODEL_CACHE_H__
+
+//C++ Includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//Lib Includes
+#include <learnopengl/mesh.h>
+
+//Forward Declare
+class Model;
+struct aiNode;
+struct aiScene;
+
+/// <summary>
+/// A model that has been loaded in to memory but has nothing on the GPU yet, so it
+/// can be loaded on any thread and then turned in to a Model on the main thread
+/// </summary>
+struct ModelData
+{
+	//Vertices, indices and textures of a single mesh
+	struct MeshData
+	{
+		std::vector<Vertex> vVertices;
+		std::vector<unsigned int> vIndices;
+		std::vector<Texture> vTextures; //Texture ids are filled when the model is created
+	};
+
+	//Decoded pixels of a texture file
+	struct ImageData
+	{
+		std::string szPath; //Path relative to the model's directory, as used by the mesh textures
+		int iWidth = 0;
+		int iHeight = 0;
+		int iComponents = 0;
+		std::vector<unsigned char> vPixels;
+	};
+
+	std::string szDirectory;
+	std::vector<MeshData> vMeshes;
+	std::vector<ImageData> vImages; //Each texture used by the meshes, only once
+};
+
+/// <summary>
+/// Cache of models in a compact binary format, so that models only have to be
+/// parsed by Assimp the first time they are loaded. The cache is written next to the
+/// source file and is memory mapped on later loads, if the source file or it's material
+/// file changes the cache is rebuilt
+/// </summary>
+class ModelCache
+{
+public:
+	//Load a model from it's cache, or from the source file if the cache is missing or out of date
+	static Model* LoadModel(const std::string& a_szModelPath);
+
+	//Load a model in to memory and decode it's textures without touching GL, safe to call on any thread
+	static bool LoadModelData(const std::string& a_szModelPath, ModelData& a_xModelData);
+	//Upload model data to the GPU, must be called on the thread with the GL context
+	static Model* CreateModel(const ModelData& a_xModelData);
+	//Delete a model made by CreateModel along with it's textures and mesh buffers, must be called on the thread with the GL context
+	static void DestroyModel(Model* a_pModel);
+
+private:
+
+	//Info about a source file stored in the cache, used to check the cache is up to date
+	struct SourceFileInfo
+	{
+		std::string szPath; //Path of the file, empty if the model has no material file
+		uint64_t uSize = 0; //Size of the file in bytes
+		int64_t iModifiedTime = 0; //Last time the file was modified
+	};
+
+	//Functions for reading and writing the cache
+	static bool ReadCache(const std::string& a_szCachePath, const SourceFileInfo& a_xSourceInfo, const SourceFileInfo& a_xMaterialInfo, ModelData& a_xModelData);
+	static bool WriteCache(const ModelData& a_xModelData, const std::string& a_szCachePath, const SourceFileInfo& a_xSourceInfo, const SourceFileInfo& a_xMaterialInfo);
+
+	//Functions for loading the source model with Assimp
+	static bool ParseModel(const std::string& a_szModelPath, ModelData& a_xModelData);
+	static void ParseNode(const aiNode* a_pNode, const aiScene* a_pScene, ModelData& a_xModelData);
+
+	//Texture helper functions
+	static void DecodeImages(ModelData& a_xModelData);
+	static unsigned int UploadImage(const ModelData::ImageData& a_xImage);
+
+	//Source file helper functions
+	static bool GetSourceFileInfo(const std::string& a_szPath, SourceFileInfo& a_xSourceInfo);
+	static std::string GetMaterialPath(const std::string& a_szModelPath);
+	static uint64_t HashFile(const std::string& a_szPath);
+	static std::string GetCachePath(const std::string& a_szModelPath) { return a_szModelPath + ".meshcache"; }
+	static std::string GetDirectory(const std::string& a_szModelPath) { return a_szModelPath.substr(0, a_szModelPath.find_last_of('/')); }
+};
+
+#endif //!__MODEL_CACHE_H__
@@ -18,18 +18,31 @@ public:
 	explicit ModelComponent(Entity* a_pOwner);
 	~ModelComponent() = default;
 
+	DECLARE_POOLED_ALLOCATION()
+
 	void Update(float a_fDeltaTime) override {};
 	void Draw(Shader* a_pShader) override;
 
-	void SetModel(Model* a_pNewModel) { m_pModelData = a_pNewModel; };
-	void ChooseRandomModel(std::vector<Model*>& a_vpModels);
+	void SetModel(Model* a_pNewModel) { m_pModelData = a_pNewModel; m_pvpModelChoices = nullptr; };
+	void ChooseRandomModel(const std::vector<Model*>& a_vpModels);
 	void SetScale(const float a_fNewScale) { m_fModelScale = a_fNewScale; };
 
 
 	//Get text name of the component
 	const char* GetComponentName() const override;
+
+	//Get type of the component, used to find the component on it's owner
+	COMPONENT_TYPE GetComponentType() const override { return sc_eComponentType; }
+	static constexpr COMPONENT_TYPE sc_eComponentType = COMPONENT_TYPE::COMPONENT_TYPE_MODEL;
 private:
+	//Get the model to draw, the placeholder if the model we chose is still loading
+	Model* GetModel() const;
+
 	Model* m_pModelData;
+	//Models we chose a random model from and the index we chose, the list is
+	//read each time we draw so that we swap to our model once it has loaded
+	const std::vector<Model*>* m_pvpModelChoices;
+	unsigned int m_uModelIndex;
 	float m_fModelScale;
 
 	const char* m_szName = "Model";
@@ -0,0 +1,158 @@
+#ifndef __OBJECT_POOL_H__
+#define __OBJECT_POOL_H__
+
+//C++ Includes
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+/// <summary>
+/// Counters of a single object pool
+/// </summary>
+struct ObjectPoolStats
+{
+	const char* szName; //Name of the type the pool holds
+	size_t uObjectSize; //Size of each object
+	unsigned int uLiveCount; //Objects that are allocated right now
+	unsigned int uPeakLiveCount; //Most objects that have been allocated at once
+	unsigned int uCapacity; //Objects the pool can hold before it has to allocate another block
+	uint64_t uAllocationCount; //Total objects allocated from the pool
+	uint64_t uBlockAllocationCount; //Number of times the pool has allocated from the heap
+};
+
+/// <summary>
+/// Pool of fixed size objects. Memory is allocated from the heap in blocks of objects and freed
+/// objects are kept on a free list to be reused, so once the pool has grown to the most objects we
+/// need at once, allocating and freeing never touches the heap. Blocks are only freed with the pool.
+/// Not thread safe, entities and components are only created and destroyed on the main thread
+/// </summary>
+class ObjectPool
+{
+public:
+	ObjectPool(const char* a_szName, size_t a_uObjectSize, size_t a_uAlignment, unsigned int a_uObjectsPerBlock = sc_uDefaultObjectsPerBlock);
+	~ObjectPool();
+
+	ObjectPool(const ObjectPool&) = delete;
+	ObjectPool& operator=(const ObjectPool&) = delete;
+
+	//Allocate/Free memory for a single object
+	void* Allocate();
+	void Free(void* a_pMemory);
+
+	ObjectPoolStats GetStats() const;
+
+	//Get the counters of every pool that exists
+	static void GetAllStats(std::vector<ObjectPoolStats>& a_vStats);
+	//Get the number of times any pool has allocated from the heap
+	static uint64_t GetTotalBlockAllocationCount();
+
+	static constexpr unsigned int sc_uDefaultObjectsPerBlock = 256u;
+
+private:
+	//Allocate a new block and add all of it's objects to the free list
+	void AllocateBlock();
+
+	const char* m_szName;
+	size_t m_uObjectSize;
+	size_t m_uSlotSize; //Size of each object rounded up to the alignment, and big enough to hold a free list pointer
+	size_t m_uAlignment;
+	unsigned int m_uObjectsPerBlock;
+
+	std::vector<void*> m_vpBlocks;
+	void* m_pFreeList; //First free object, each free object holds a pointer to the next one
+
+	//Counters
+	unsigned int m_uLiveCount;
+	unsigned int m_uPeakLiveCount;
+	uint64_t m_uAllocationCount;
+
+	//Every pool that exists, so their counters can be collected
+	static std::vector<ObjectPool*>& GetPools();
+};
+
+//Declare class specific new/delete that allocate objects of the class from it's own pool, so spawning and destroying
+//them reuses memory (entities and every component type use this). Should be put in the public part of a class with a
+//virtual destructor so objects deleted from a base pointer go back to the right pool
+#define DECLARE_POOLED_ALLOCATION() \
+	static void* operator new(size_t a_uSize); \
+	static void operator delete(void* a_pMemory, size_t a_uSize); \
+	static ObjectPool& GetObjectPool();
+
+//Define the pooled new/delete of a class, should be put in the class's cpp. Classes derived from it
+//that are a different size fall back to the heap
+#define DEFINE_POOLED_ALLOCATION(ClassName) \
+	ObjectPool& ClassName::GetObjectPool() \
+	{ \
+		static ObjectPool s_xObjectPool(#ClassName, sizeof(ClassName), alignof(ClassName)); \
+		return s_xObjectPool; \
+	} \
+	void* ClassName::operator new(const size_t a_uSize) \
+	{ \
+		return a_uSize == sizeof(ClassName) ? GetObjectPool().Allocate() : ::operator new(a_uSize); \
+	} \
+	void ClassName::operator delete(void* a_pMemory, const size_t a_uSize) \
+	{ \
+		if (a_uSize == sizeof(ClassName)) { \
+			GetObjectPool().Free(a_pMemory); \
+		} \
+		else { \
+			::operator delete(a_pMemory); \
+		} \
+	}
+
+/// <summary>
+/// Allocator for containers (e.g std::vector) that takes arrays of up to uPooledCount objects from a pool
+/// shared by every container of the same type and count, so a container that is freed and made again
+/// reuses the memory rather than touching the heap. Bigger arrays fall back to the heap.
+/// Not thread safe, like the pools it allocates from
+/// </summary>
+template <class T, unsigned int uPooledCount>
+class PooledArrayAllocator
+{
+public:
+	typedef T value_type;
+
+	template <class U>
+	struct rebind
+	{
+		typedef PooledArrayAllocator<U, uPooledCount> other;
+	};
+
+	PooledArrayAllocator() = default;
+	template <class U>
+	PooledArrayAllocator(const PooledArrayAllocator<U, uPooledCount>&) {}
+
+	T* allocate(const size_t a_uCount)
+	{
+		return static_cast<T*>(a_uCount <= uPooledCount ? GetObjectPool().Allocate() : ::operator new(a_uCount * sizeof(T)));
+	}
+
+	void deallocate(T* a_pMemory, const size_t a_uCount)
+	{
+		if (a_uCount <= uPooledCount) {
+			GetObjectPool().Free(a_pMemory);
+		}
+		else {
+			::operator delete(a_pMemory);
+		}
+	}
+
+	//Each pool is named after the element type and count it holds (e.g "class Component * [8]" with MSVC)
+	//so their stats can be told apart, type names are mangled with other compilers
+	static ObjectPool& GetObjectPool()
+	{
+		static const std::string s_szName = std::string(typeid(T).name()) + " [" + std::to_string(uPooledCount) + "]";
+		static ObjectPool s_xObjectPool(s_szName.c_str(), sizeof(T) * uPooledCount, alignof(T));
+		return s_xObjectPool;
+	}
+};
+
+//Every allocator of the same type uses the same pool, so memory from one can be freed by another
+template <class T, class U, unsigned int uPooledCount>
+bool operator==(const PooledArrayAllocator<T, uPooledCount>&, const PooledArrayAllocator<U, uPooledCount>&) { return true; }
+template <class T, class U, unsigned int uPooledCount>
+bool operator!=(const PooledArrayAllocator<T, uPooledCount>&, const PooledArrayAllocator<U, uPooledCount>&) { return false; }
+
+#endif //!__OBJECT_POOL_H__
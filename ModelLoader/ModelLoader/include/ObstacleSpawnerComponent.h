@@ -19,17 +19,24 @@ public:
 	explicit ObstacleSpawnerComponent(Entity* a_pOwner);
 	~ObstacleSpawnerComponent() = default;
 
+	DECLARE_POOLED_ALLOCATION()
+
 	//Update/Draw Functions
 	void Update(float a_fDeltaTime) override;
 	void Draw(Shader* a_pShader) override;
 
 	//Get text name of the component
 	const char* GetComponentName() const override;
+
+	//Spawn an obstacle entity, static so obstacles can be created without a spawner (e.g when loading a snapshot)
+	static Entity* SpawnObstacle(glm::vec3 a_v3Position, float a_fRadius);
+
+	//Get type of the component, used to find the component on it's owner
+	COMPONENT_TYPE GetComponentType() const override { return sc_eComponentType; }
+	static constexpr COMPONENT_TYPE sc_eComponentType = COMPONENT_TYPE::COMPONENT_TYPE_OBSTACLE_SPAWNER;
 	
 private:
 
-	void SpawnObstacle(glm::vec3 a_v3Position) const;
-
 	glm::vec3 GetObstacleSpawnPos() const;
 
 	//Obsticle Color
@@ -0,0 +1,140 @@
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+//C++ Includes
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//Project Includes
+#include "Singleton.h"
+
+/// <summary>
+/// Collects the time spent in named scopes each frame and keeps a history of the
+/// last frames so we can show the min, average and 99th percentile time of each scope.
+/// Scopes can be timed on any thread, times from all threads are added together.
+/// Scope names are paths split by '/' (e.g "Update/Step") so scopes can be shown under their parent
+/// </summary>
+class Profiler : public Singleton<Profiler>
+{
+	friend class Singleton<Profiler>;
+public:
+
+	//Stats of a single scope over the frames in the history
+	struct ScopeStats
+	{
+		std::string szName; //Last part of the scope path
+		std::string szPath; //Full scope path
+		unsigned int uDepth; //Number of parents the scope has that are scopes themselves
+		double fMinMs;
+		double fAvgMs;
+		double fP99Ms;
+		double fAvgCalls; //Average times the scope was entered each frame
+	};
+
+	//Get the ID of a scope, registering it if this is the first time it is used
+	unsigned int RegisterScope(const std::string& a_szPath);
+
+	//Add time spent in a scope to the current frame
+	void AddSample(unsigned int a_uScopeId, uint64_t a_uNanoseconds);
+
+	//Use the samples of a job system thread index for the calling thread, so a worker that replaces another reuses it's samples
+	void SetThreadIndex(unsigned int a_uThreadIndex);
+
+	//Finish the current frame, moving it's times in to the history
+	void EndFrame();
+
+	//Get the stats of every scope, ordered so that scopes come after their parents
+	void GetStats(std::vector<ScopeStats>& a_vStats);
+	unsigned int GetHistoryFrameCount() const { return m_uHistoryCount; }
+
+	//Write the stats of every scope to a CSV file
+	bool WriteReport(const char* a_szPath);
+
+	//Clear the history
+	void Reset();
+
+	//Max number of scopes and the number of frames kept in the history
+	static constexpr unsigned int sc_uMaxScopes = 64u;
+	static constexpr unsigned int sc_uHistoryFrames = 300u;
+
+private:
+	Profiler();
+	~Profiler() = default;
+
+	//Times added by a single thread this frame, only the owning thread adds
+	//to them and only EndFrame takes them
+	struct ThreadSamples
+	{
+		std::array<std::atomic<uint64_t>, sc_uMaxScopes> auNanoseconds;
+		std::array<std::atomic<uint32_t>, sc_uMaxScopes> auCalls;
+	};
+	ThreadSamples* GetThreadSamples();
+	ThreadSamples* CreateThreadSamples();
+	static thread_local ThreadSamples* s_pThreadSamples; //Samples of the calling thread, null until it first needs them
+
+	//Registered scopes and the samples of each thread that has timed a scope
+	std::vector<std::string> m_vszScopePaths;
+	std::vector<std::unique_ptr<ThreadSamples>> m_vpThreadSamples;
+	std::vector<ThreadSamples*> m_vpIndexedThreadSamples; //Samples given to each job system thread index
+	std::mutex m_xRegisterMutex;
+
+	//Time and call count of each scope in each of the last frames, used as a ring buffer
+	std::vector<std::array<double, sc_uHistoryFrames>> m_vafHistoryMs;
+	std::vector<std::array<uint32_t, sc_uHistoryFrames>> m_vauHistoryCalls;
+	unsigned int m_uHistoryHead; //Index the next frame is written to
+	unsigned int m_uHistoryCount; //Number of frames in the history
+};
+
+/// <summary>
+/// Times from when it is created until it goes out of scope and adds the time to the profiler
+/// </summary>
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const unsigned int a_uScopeId) :
+		m_uScopeId(a_uScopeId),
+		m_xStartTime(std::chrono::steady_clock::now())
+	{
+	}
+
+	~ProfileScope()
+	{
+		const std::chrono::steady_clock::duration xElapsed = std::chrono::steady_clock::now() - m_xStartTime;
+		Profiler::GetInstance()->AddSample(m_uScopeId, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(xElapsed).count()));
+	}
+
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+	unsigned int m_uScopeId;
+	std::chrono::steady_clock::time_point m_xStartTime;
+};
+
+//Profiling macros, these compile to nothing unless ENABLE_PROFILER is defined
+//(set by the Debug and Profile configurations, Release builds without it)
+#ifdef ENABLE_PROFILER
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+//Time the rest of the current scope, the scope is registered the first time it is reached
+#define PROFILE_SCOPE(szPath) \
+	static const unsigned int PROFILE_CONCAT(s_uProfileScopeId, __LINE__) = Profiler::GetInstance()->RegisterScope(szPath); \
+	const ProfileScope PROFILE_CONCAT(xProfileScope, __LINE__)(PROFILE_CONCAT(s_uProfileScopeId, __LINE__))
+//Time the rest of the current scope with an already registered scope ID
+#define PROFILE_SCOPE_ID(uScopeId) const ProfileScope PROFILE_CONCAT(xProfileScope, __LINE__)(uScopeId)
+#define PROFILE_END_FRAME() Profiler::GetInstance()->EndFrame()
+#define PROFILE_THREAD_INDEX(uThreadIndex) Profiler::GetInstance()->SetThreadIndex(uThreadIndex)
+#else
+#define PROFILE_SCOPE(szPath)
+#define PROFILE_SCOPE_ID(uScopeId)
+#define PROFILE_END_FRAME()
+#define PROFILE_THREAD_INDEX(uThreadIndex)
+#endif
+
+#endif //!__PROFILER_H__
@@ -23,17 +23,24 @@ public:
 	RaycastComponent(Entity* a_pOwner, reactphysics3d::CollisionWorld* a_pCollisionWorld);
 	~RaycastComponent() = default;
 
+	DECLARE_POOLED_ALLOCATION()
+
 	//Component Functions
 	void Update(float a_fDeltaTime) override {};
 	void Draw(Shader* a_pShader) override {};
 	
-	//Functions to do raycasting
-	RayCastHitsInfo* RayCast(glm::vec3 a_v3StartPoint, glm::vec3 a_v3EndPoint) const;
-	RayCastHitsInfo* RayCast(rp3d::Ray* a_ray) const;
-	std::vector<RayCastHitsInfo*> MutiRayCast(std::vector<rp3d::Ray*> a_vRays, bool a_bDeleteRays = false) const;
+	//Functions to do raycasting, hits are added to the given hits info. Only colliders
+	//in one of the categories in the category mask are hit
+	bool RayCast(glm::vec3 a_v3StartPoint, glm::vec3 a_v3EndPoint, RayCastHitsInfo& a_hitsInfo, unsigned short a_uCategoryMask = 0xFFFF) const;
+	bool RayCast(const rp3d::Ray& a_ray, RayCastHitsInfo& a_hitsInfo, unsigned short a_uCategoryMask = 0xFFFF) const;
+	bool MutiRayCast(const glm::vec3& a_v3StartPoint, const glm::vec3* a_pV3EndPoints, unsigned int a_uRayCount, RayCastHitsInfo& a_hitsInfo, unsigned short a_uCategoryMask = 0xFFFF) const;
 
 	//Get text name of the component
 	const char* GetComponentName() const override;
+
+	//Get type of the component, used to find the component on it's owner
+	COMPONENT_TYPE GetComponentType() const override { return sc_eComponentType; }
+	static constexpr COMPONENT_TYPE sc_eComponentType = COMPONENT_TYPE::COMPONENT_TYPE_RAYCAST;
 	
 private:
 	rp3d::CollisionWorld* m_pCollisionWorld; //Pointer to the physics world that this object is using
@@ -55,7 +62,9 @@ struct RayCastHit
 /// <summary>
 /// Class which handles all of the objects that a raycast has hit.
 /// Contains info about the entity, hit point, hit normal and hit fraction
-/// All hits are gathered in the order that they occoured
+/// All hits are gathered in the order that they occoured.
+/// Hits are stored in a fixed size buffer owned by whoever is casting, so it can
+/// be kept on the stack and reused for many casts without allocating
 /// </summary>
 class RayCastHitsInfo final : public rp3d::RaycastCallback
 {
@@ -63,23 +72,27 @@ public:
 
 	//Default Constructor
 	RayCastHitsInfo() = default;
-
-	//Destructor, removes all raycast hits
-	~RayCastHitsInfo()
-	{
-		if (!m_vRayCastHits.empty()) {
-			for (unsigned int i = 0; i < m_vRayCastHits.size(); ++i)
-			{
-				delete m_vRayCastHits[i];
-			}
-			m_vRayCastHits.clear();
-		}
-	}
+	~RayCastHitsInfo() = default;
 
 	rp3d::decimal notifyRaycastHit(const reactphysics3d::RaycastInfo& a_pRaycastInfo) override;
 
+	//Remove all of the hits so this buffer can be reused
+	void Clear() { m_uHitCount = 0; }
+
+	//Get the hits from the raycasts
+	unsigned int GetHitCount() const { return m_uHitCount; }
+	bool IsFull() const { return m_uHitCount >= sc_uMaxHits; }
+	const RayCastHit& GetHit(const unsigned int a_uHitIndex) const { return m_aRayCastHits[a_uHitIndex]; }
+
+	//Max number of hits that can be stored, once we are full
+	//any more hits are ignored and the current ray is stopped
+	static constexpr unsigned int sc_uMaxHits = 32u;
+
+private:
+
 	//List of hits from this raycast
-	std::vector<RayCastHit*> m_vRayCastHits;
+	RayCastHit m_aRayCastHits[sc_uMaxHits];
+	unsigned int m_uHitCount = 0;
 
 };
 
@@ -0,0 +1,24 @@
+#ifndef __REGRESSION_HARNESS_H__
+#define __REGRESSION_HARNESS_H__
+
+//Forward Declare
+struct SimulationSettings;
+
+/// <summary>
+/// Runs a fixed set of seeded scenarios headless and compares every step of them against golden
+/// files, so changes that alter how the flock behaves are caught. Each scenario is checked step by
+/// step with a hash of the boids against the golden files written by the same compiler and configuration.
+/// A build with no golden files can be tried against another build's with --tolerance. Only the state after the
+/// first step is compared within the tolerance, later steps are not checked at all, so this is never a clean pass.
+/// The gcc-x64-release golden files come from the GCC build in ModelLoader/Regression (make check / make update-golden),
+/// the MSVC builds need their own written with --update-golden before they can pass.
+/// Also reports the throughput of each scenario
+/// </summary>
+class RegressionHarness
+{
+public:
+	//Run every scenario, checking against or updating the golden files. Returns the exit code for the program
+	static int Run(const SimulationSettings& a_xSettings);
+};
+
+#endif //!__REGRESSION_HARNESS_H__
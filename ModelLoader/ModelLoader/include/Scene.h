@@ -8,6 +8,9 @@
 #include <vector>
 #include <ReactPhysics3D/reactphysics3d.h>
 
+//GLM Includes
+#include <glm/vec3.hpp>
+
 
 //Foward Declares
 class Camera;
@@ -21,6 +24,7 @@ class Model;
 /// </summary>
 class Scene : private Application
 {
+	friend class SimulationSnapshot; //Snapshots rebuild the bounds and reset the fixed timestep when they are loaded
 public:
 	Scene(const Scene&) = delete; //Overload Copy Constructor - no implementation
 	Scene& operator=(const Scene&) = delete; //Overload Equals Operator - no implementation
@@ -28,18 +32,35 @@ public:
 	static Scene* GetInstance();
 
 	bool Initialize(bool a_bInitApplication);
+	bool InitializeHeadless(unsigned int a_uSeed);
 	bool Update() override;
 	void Render() override;
 	void DeInitialize(bool a_bCloseApplication);
 
+	//Step the simulation of all of the entities in the scene
+	void Step(float a_fDeltaTime);
+
+	//Get if the scene is running without a window
+	bool IsHeadless() const { return m_bHeadless; }
+
+	//Get how far between the last two simulation steps we are rendering
+	float GetInterpolationAlpha() const { return m_fInterpolationAlpha; }
+	int GetStepsLastFrame() const { return m_iStepsLastFrame; }
+
 	//Get the collision world - used for collider components
 	rp3d::CollisionWorld* GetCollisionWorld() const;
 
+	//Get the distance from the center of the world to the inside of the bounds walls on each axis
+	const glm::vec3& GetBoundsInnerExtent() const { return m_v3BoundsInnerExtent; }
+
 private:
 	Scene();
+
+	//Create the collision world, bounds and boids
+	void InitializeSimulation(unsigned int a_uSeed);
 	
 	//Function to generate our bounds volume
-	void GenerateBoundsVolume(float a_fBoundsSize) const;
+	void GenerateBoundsVolume(float a_fBoundsSize);
 	
 	//OpenGL Callback functions
 	static void mouse_callback(GLFWwindow* window, double xpos, double ypos);
@@ -48,14 +69,27 @@ private:
 
 	CameraComponent* m_pCamera;
 	Shader* m_ourShader;
+	Shader* m_pInstancedShader; //Shader used to draw models with the instanced renderer
 
 	//Collision World
 	rp3d::CollisionWorld* m_pSceneCollisionWorld;
 
+	//World Bounds
+	float m_fBoundsSize; //Size the bounds volume was generated with
+	glm::vec3 m_v3BoundsInnerExtent; //Distance to the inside face of the walls on each axis, from the wall colliders
+	static constexpr float sc_fWallThickness = 0.5f; //Thickness of the bounds walls
+
 	//Mouse Info
 	float m_fLastX; //Last X Position of the mouse
 	float m_fLastY; //Last Y Position of the mouse
 	bool m_bFirstMouse; //If this is the first time that we are geting mouse info
+
+	bool m_bHeadless; //If we are running with no window, GL context or models
+
+	//Fixed Timestep Info
+	float m_fStepAccumulator; //Frame time that has not been simulated yet
+	float m_fInterpolationAlpha; //How far between the last two simulation steps we are (0-1)
+	int m_iStepsLastFrame; //Number of simulation steps taken last frame
 	
 	static Scene* s_pSceneInstance; //Single instance of this scene;
 };
@@ -0,0 +1,36 @@
+#ifndef __SIMULATION_SETTINGS_H__
+#define __SIMULATION_SETTINGS_H__
+
+//C++ Includes
+#include <string>
+
+/// <summary>
+/// Settings for a run of the application, read from the command line
+/// </summary>
+struct SimulationSettings
+{
+	bool bHeadless = false; //Run with no window, GL context or models
+	int iBoidCount = 100; //Number of boids to spawn
+	int iWorldBounds = 20; //Size of the world bounds
+	int iStepCount = 1000; //Number of steps to simulate when headless
+	float fTimeStep = 1.f / 60.f; //Time each step simulates when headless
+	unsigned int uSeed = 0; //Seed for the RNG when headless
+	bool bNeighbourLists = false; //Find neighbours with Verlet lists rather than searching the grid each step
+	float fNeighbourListSkin = 1.f; //Distance past the neighbour radius that boids are kept on the lists
+	int iThreadCount = 0; //Number of job system threads, 0 uses every hardware thread
+	int iTraceFrames = 0; //Number of frames (steps when headless) to record a trace of, 0 records nothing
+	std::string szTracePath = "trace.json"; //Path the trace is written to
+	std::string szLoadSnapshotPath; //Snapshot to load before stepping when headless, empty loads nothing
+	std::string szSaveSnapshotPath; //Path to save a snapshot to after stepping when headless, empty saves nothing
+	std::string szTrajectoryPath; //Path to record every step of the boids to when headless, empty records nothing
+	std::string szReplayPath; //Trajectory to play back instead of simulating, only with a window
+	std::string szRegressionPath; //Directory of golden files to check the regression scenarios against, empty runs normally
+	bool bUpdateGolden = false; //Write the golden files from this build rather than checking against them
+	std::string szToleranceBuild; //Build whose golden files are checked against within a tolerance, empty checks this build's exactly
+
+	//Fill settings from the command line arguments
+	static bool ParseCommandLine(int a_iArgCount, char** a_pArgs, SimulationSettings& a_xSettings);
+	static void PrintUsage();
+};
+
+#endif //!__SIMULATION_SETTINGS_H__
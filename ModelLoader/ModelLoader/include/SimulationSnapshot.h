@@ -0,0 +1,21 @@
+#ifndef __SIMULATION_SNAPSHOT_H__
+#define __SIMULATION_SNAPSHOT_H__
+
+//C++ Includes
+#include <string>
+
+/// <summary>
+/// Saves and loads the state of the simulation (boids, obstacles, world bounds, UI values
+/// and random numbers) as a compact binary file, so long runs can be resumed or branched
+/// from a known state. Boid state is written and read as whole arrays rather than boid by boid
+/// </summary>
+class SimulationSnapshot
+{
+public:
+	//Save the current simulation to a file
+	static bool Save(const std::string& a_szPath);
+	//Replace the current simulation with the one saved in a file, the scene must already be initialized
+	static bool Load(const std::string& a_szPath);
+};
+
+#endif //!__SIMULATION_SNAPSHOT_H__
@@ -0,0 +1,82 @@
+#ifndef __SPATIAL_HASH_GRID_H__
+#define __SPATIAL_HASH_GRID_H__
+
+//C++ Includes
+#include <vector>
+
+//GLM Includes
+#include <glm/glm.hpp>
+
+//Project Includes
+#include "Singleton.h"
+
+//Forward Declare
+struct FlockingCandidates;
+
+/// <summary>
+/// A single boid stored in the spatial hash grid. Caches the values
+/// that neighbour queries need so they do not have to go back to
+/// the boid system
+/// </summary>
+struct SpatialGridEntry
+{
+	unsigned int m_uBoidIndex; //Index of the boid this entry was built from
+	glm::vec3 m_v3Position; //Position of the boid when the grid was built
+	glm::vec3 m_v3Velocity; //Velocity of the boid when the grid was built
+};
+
+/// <summary>
+/// Uniform spatial hash grid used to find boids that are near each other.
+/// The grid is rebuilt once per frame and each query only visits the 27 cells
+/// surrounding the query point, rather than every entity in the world
+/// </summary>
+class SpatialHashGrid : public Singleton<SpatialHashGrid>
+{
+	friend class Singleton<SpatialHashGrid>;
+public:
+
+	//Rebuild the grid from the positions/velocities of all of the boids
+	void Rebuild(const std::vector<glm::vec3>& a_vV3Positions, const std::vector<glm::vec3>& a_vV3Velocities, float a_fCellSize);
+	void Clear();
+
+	//Get all of the entries in the cells surrounding a position
+	void QueryNeighbours(const glm::vec3& a_v3Position, std::vector<const SpatialGridEntry*>& a_vpNeighbours) const;
+	//Get all of the entries in the cells surrounding a position laid out for the flocking kernel, apart from one boid
+	void QueryNeighbours(const glm::vec3& a_v3Position, unsigned int a_uExcludeBoidIndex, FlockingCandidates& a_xCandidates) const;
+
+	unsigned int GetEntryCount() const { return static_cast<unsigned int>(m_vEntries.size()); }
+
+private:
+	SpatialHashGrid();
+	~SpatialHashGrid() = default;
+
+	//Cell helper functions
+	glm::ivec3 GetCellCoord(const glm::vec3& a_v3Position) const;
+	unsigned int GetCellBucket(const glm::ivec3& a_v3CellCoord) const;
+	//Get the buckets of the 27 cells surrounding a position, without repeats
+	unsigned int GetNeighbourBuckets(const glm::vec3& a_v3Position, unsigned int (&a_auBuckets)[27]) const;
+
+	//Size of each cell and the inverse, so we can multiply rather than divide
+	float m_fCellSize;
+	float m_fInvCellSize;
+
+	//Mask used to wrap cell hashes in to the bucket table (table size is a power of 2)
+	unsigned int m_uBucketMask;
+
+	//Entries sorted by bucket, with the start index of each bucket.
+	//Bucket i holds entries [m_vBucketStart[i], m_vBucketStart[i + 1])
+	std::vector<SpatialGridEntry> m_vEntries;
+	std::vector<unsigned int> m_vBucketStart;
+
+	//Scratch storage reused between rebuilds to avoid reallocating each frame
+	std::vector<SpatialGridEntry> m_vUnsortedEntries;
+	std::vector<unsigned int> m_vEntryBuckets;
+	std::vector<unsigned int> m_vBucketCursor;
+
+	#pragma region Grid Defaults
+	const float mc_fMinCellSize = 0.01f; //Smallest cell we allow, prevents a divide by 0
+	const unsigned int mc_uMinBucketCount = 64u; //Smallest bucket table we create
+	#pragma endregion
+};
+
+#endif //!__SPATIAL_HASH_GRID_H__
@@ -12,16 +12,21 @@ public:
 	explicit SpherePrimitiveComponent(Entity* a_pOwner, float a_fSphereRadius = 1.0f);
 	~SpherePrimitiveComponent() = default;
 
+	DECLARE_POOLED_ALLOCATION()
+
 	//Function to set size
 	void SetDimensions(float a_fNewRadius);
+	float GetRadius() const { return m_fSphereRadius; }
 	
 	//Update/Draw Functions - have no implementation as primatives
 	//cannot be created 
 	void Update(float a_fDeltaTime) override {};
 	void Draw(Shader* a_pShader) override;
 
-	//Get text name of the component
+	//Get text name/type of the component
 	const char* GetComponentName() const override;
+	COMPONENT_TYPE GetComponentType() const override { return sc_eComponentType; }
+	static constexpr COMPONENT_TYPE sc_eComponentType = COMPONENT_TYPE::COMPONENT_TYPE_SPHERE_PRIMITIVE;
 
 private:
 	//Radius of the sphere
@@ -0,0 +1,123 @@
+#ifndef __TRACE_RECORDER_H__
+#define __TRACE_RECORDER_H__
+
+//C++ Includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+//Project Includes
+#include "Singleton.h"
+
+/// <summary>
+/// Records timed events from every thread for a number of frames and writes them as
+/// Chrome trace event JSON, which can be opened in chrome://tracing or Perfetto.
+/// Events are only kept while recording, so trace scopes cost very little the rest of the time
+/// </summary>
+class TraceRecorder : public Singleton<TraceRecorder>
+{
+	friend class Singleton<TraceRecorder>;
+public:
+
+	//Start recording for a number of frames, the trace is written to the path once they are recorded
+	void StartRecording(unsigned int a_uFrameCount, const std::string& a_szPath);
+	//Stop recording and write the trace
+	void StopRecording();
+	bool IsRecording() const { return m_bRecording.load(std::memory_order_relaxed); }
+	unsigned int GetFramesRemaining() const { return m_uFramesRemaining; }
+
+	//Mark the end of a frame, recording stops once we have recorded enough frames
+	void EndFrame();
+
+	//Add an event that has finished, safe to call from any thread
+	void AddEvent(const char* a_szName, const char* a_szCategory, std::chrono::steady_clock::time_point a_xStartTime,
+		std::chrono::steady_clock::time_point a_xEndTime, const std::string& a_szDetail);
+
+	//Set the name the calling thread is shown with in traces
+	void SetThreadName(const std::string& a_szName);
+
+private:
+	TraceRecorder();
+	~TraceRecorder() = default;
+
+	//A single timed event
+	struct TraceEvent
+	{
+		const char* szName;
+		const char* szCategory;
+		int64_t iStartNs; //Time since recording started
+		int64_t iDurationNs;
+		std::string szDetail; //Extra info shown with the event, can be empty
+	};
+
+	//Events recorded by a single thread, the lock is only contended when the trace is written
+	struct ThreadEvents
+	{
+		unsigned int uThreadId;
+		std::string szThreadName;
+		std::vector<TraceEvent> vEvents;
+		std::mutex xMutex;
+	};
+	ThreadEvents* GetThreadEvents();
+
+	//Write all of the recorded events to a file
+	bool WriteTrace(const std::string& a_szPath);
+
+	std::atomic<bool> m_bRecording;
+	unsigned int m_uFramesRemaining;
+	std::string m_szTracePath;
+	std::chrono::steady_clock::time_point m_xRecordStartTime;
+
+	//Events of every thread that has added an event or been named
+	std::vector<std::unique_ptr<ThreadEvents>> m_vpThreadEvents;
+	std::mutex m_xThreadsMutex;
+};
+
+/// <summary>
+/// Adds a trace event that lasts from when it is created until it goes out of scope, if we are recording
+/// </summary>
+class TraceScope
+{
+public:
+	TraceScope(const char* a_szName, const char* a_szCategory) :
+		m_szName(a_szName),
+		m_szCategory(a_szCategory),
+		m_bActive(TraceRecorder::GetInstance()->IsRecording())
+	{
+		if (m_bActive) {
+			m_xStartTime = std::chrono::steady_clock::now();
+		}
+	}
+
+	~TraceScope()
+	{
+		if (m_bActive) {
+			TraceRecorder::GetInstance()->AddEvent(m_szName, m_szCategory, m_xStartTime, std::chrono::steady_clock::now(), m_szDetail);
+		}
+	}
+
+	//If this scope will be recorded, used to only build details when we need them
+	bool IsActive() const { return m_bActive; }
+	void SetDetail(const std::string& a_szDetail) { m_szDetail = a_szDetail; }
+
+	TraceScope(const TraceScope&) = delete;
+	TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+	const char* m_szName;
+	const char* m_szCategory;
+	bool m_bActive;
+	std::chrono::steady_clock::time_point m_xStartTime;
+	std::string m_szDetail;
+};
+
+//Add a trace event for the rest of the current scope
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_SCOPE(szName, szCategory) const TraceScope TRACE_CONCAT(xTraceScope, __LINE__)(szName, szCategory)
+
+#endif //!__TRACE_RECORDER_H__
@@ -0,0 +1,86 @@
+#ifndef __TRAJECTORY_CODEC_H__
+#define __TRAJECTORY_CODEC_H__
+
+//C++ Includes
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//GLM Includes
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+/*
+ * Trajectory file layout, all values are little endian:
+ * TrajectoryFileHeader
+ * For each chunk:
+ *		TrajectoryChunkHeader
+ *		Encoded frames (uDataSize bytes)
+ * TrajectoryIndexEntry[uChunkCount], at uIndexOffset
+ */
+
+//Header at the start of a trajectory file, the frame and chunk counts and index
+//offset are filled in once recording stops
+struct TrajectoryFileHeader
+{
+	uint32_t uMagic;
+	uint32_t uVersion;
+	uint32_t uFrameCount;
+	uint32_t uChunkCount;
+	uint32_t uFramesPerChunk; //Most frames in a chunk, chunks also end when the boid count changes
+	uint32_t uMaxBoidCount; //Most boids in any frame
+	float fPositionExtent; //Positions are quantized to [-extent, extent] on each axis
+	float fTimeStep; //Time between frames
+	uint64_t uIndexOffset; //Offset of the chunk index, 0 if recording never finished
+};
+
+//Header before the encoded frames of each chunk
+struct TrajectoryChunkHeader
+{
+	uint32_t uFirstFrame;
+	uint32_t uFrameCount;
+	uint32_t uBoidCount; //Every frame in a chunk has the same number of boids
+	uint32_t uPadding;
+	uint64_t uDataSize; //Size of the encoded frames that follow
+};
+
+//Entry in the chunk index at the end of the file, so any frame can be found without reading the chunks before it
+struct TrajectoryIndexEntry
+{
+	uint64_t uOffset; //Offset of the chunk header
+	uint32_t uFirstFrame;
+	uint32_t uFrameCount;
+};
+
+static_assert(sizeof(TrajectoryFileHeader) == 40, "Trajectory file header must have no hidden padding");
+static_assert(sizeof(TrajectoryChunkHeader) == 24, "Trajectory chunk header must have no hidden padding");
+static_assert(sizeof(TrajectoryIndexEntry) == 16, "Trajectory index entry must have no hidden padding");
+
+/// <summary>
+/// Turns boid positions and rotations in to the compact values stored in trajectory files and back.
+/// Each boid is quantized to 16 bit values (3 for it's position within the world bounds, 4 for it's rotation
+/// as a quaternion). The first frame of a chunk is stored as is, later frames store the difference from
+/// a prediction made from the frames before (zig-zag varints), which is usually a single byte per value
+/// </summary>
+class TrajectoryCodec
+{
+public:
+	static constexpr uint32_t sc_uMagic = 0x4A525442; //"BTRJ"
+	static constexpr uint32_t sc_uVersion = 1u;
+
+	//Number of 16 bit values stored for each boid in each frame
+	static constexpr unsigned int sc_uValuesPerBoid = 7u;
+
+	//Quantize a boid, the previous frame of the boid keeps the sign of it's quaternion from flipping, it can be nullptr
+	static void QuantizeBoid(const glm::vec3& a_v3Position, const glm::quat& a_qRotation, float a_fPositionExtent,
+		const uint16_t* a_puPreviousValues, uint16_t* a_puValues);
+	//Get a boid's position and rotation back from it's quantized values
+	static void DequantizeBoid(const uint16_t* a_puValues, float a_fPositionExtent, glm::vec3& a_v3Position, glm::quat& a_qRotation);
+
+	//Encode the quantized frames of a chunk, adding them to the end of a buffer
+	static void EncodeChunk(const uint16_t* a_puFrames, unsigned int a_uFrameCount, unsigned int a_uBoidCount, std::vector<uint8_t>& a_vuEncoded);
+	//Decode every frame of a chunk in to quantized values, returns false if the data is not a valid chunk
+	static bool DecodeChunk(const uint8_t* a_puEncoded, size_t a_uEncodedSize, unsigned int a_uFrameCount, unsigned int a_uBoidCount, uint16_t* a_puFrames);
+};
+
+#endif //!__TRAJECTORY_CODEC_H__
@@ -0,0 +1,78 @@
+#ifndef __TRAJECTORY_PLAYER_H__
+#define __TRAJECTORY_PLAYER_H__
+
+//C++ Includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+//Project Includes
+#include "Singleton.h"
+#include "MappedFile.h"
+#include "TrajectoryCodec.h"
+
+/// <summary>
+/// Plays back a trajectory file written by the TrajectoryRecorder. The file is memory mapped and the
+/// boids' transforms are set straight from it's frames, nothing is simulated. Any frame can be shown by
+/// looking up it's chunk in the file's index and decoding that chunk, the last decoded chunk is kept so
+/// scrubbing within a chunk only has to set the transforms
+/// </summary>
+class TrajectoryPlayer : public Singleton<TrajectoryPlayer>
+{
+	friend class Singleton<TrajectoryPlayer>;
+public:
+
+	//Open a trajectory and show it's first frame, the scene must already be initialized
+	bool Open(const std::string& a_szPath);
+	void Close();
+	bool IsOpen() const { return m_xFile.IsOpen(); }
+
+	//Move the playback on by some time, when playing
+	void Update(float a_fDeltaTime);
+
+	//Show a frame, playback carries on from it
+	bool SeekFrame(unsigned int a_uFrame);
+
+	//Get/Set playback
+	void SetPlaying(const bool a_bPlaying) { m_bPlaying = a_bPlaying; }
+	bool IsPlaying() const { return m_bPlaying; }
+	unsigned int GetFrameCount() const { return IsOpen() ? m_xHeader.uFrameCount : 0u; }
+	unsigned int GetMaxBoidCount() const { return IsOpen() ? m_xHeader.uMaxBoidCount : 0u; }
+	unsigned int GetCurrentFrame() const { return m_uCurrentFrame; }
+	unsigned int GetFramesPerChunk() const { return IsOpen() ? m_xHeader.uFramesPerChunk : 0u; }
+
+	//Get how far between the last frame and the next we are, for rendering
+	float GetInterpolationAlpha() const { return m_fInterpolationAlpha; }
+
+private:
+	TrajectoryPlayer();
+	~TrajectoryPlayer() = default;
+
+	//Set every boid's transform from a frame, the frame before becomes the previous transform if we are interpolating
+	bool ShowFrame(unsigned int a_uFrame, bool a_bInterpolate);
+	//Decode the chunk a frame is in, if it is not the chunk we already have
+	bool DecodeChunkForFrame(unsigned int a_uFrame);
+
+	//The header and index are copied out of the mapped file, chunks are not aligned in the file so the index is not either
+	MappedFile m_xFile;
+	TrajectoryFileHeader m_xHeader;
+	std::vector<TrajectoryIndexEntry> m_vxIndex;
+
+	//Last chunk we decoded, every frame of it
+	unsigned int m_uDecodedChunk;
+	TrajectoryChunkHeader m_xDecodedChunkHeader;
+	std::vector<uint16_t> m_vuDecodedFrames;
+
+	//Playback
+	bool m_bPlaying;
+	unsigned int m_uCurrentFrame;
+	float m_fFrameTime; //Time since the current frame was shown
+	float m_fInterpolationAlpha;
+
+	//Boids set in each job
+	static constexpr unsigned int sc_uBoidsPerJob = 256u;
+	//Chunk index used when no chunk is decoded
+	static constexpr unsigned int sc_uNoChunk = 0xFFFFFFFFu;
+};
+
+#endif //!__TRAJECTORY_PLAYER_H__
@@ -0,0 +1,94 @@
+#ifndef __TRAJECTORY_RECORDER_H__
+#define __TRAJECTORY_RECORDER_H__
+
+//C++ Includes
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+//Project Includes
+#include "Singleton.h"
+#include "TrajectoryCodec.h"
+
+/// <summary>
+/// Records the position and rotation of every boid each simulation step to a trajectory file, so runs
+/// can be looked at offline or replayed. Frames are quantized on the simulation thread in to a chunk,
+/// full chunks are handed to a writer thread that encodes and writes them, so the simulation never waits on the disk
+/// </summary>
+class TrajectoryRecorder : public Singleton<TrajectoryRecorder>
+{
+	friend class Singleton<TrajectoryRecorder>;
+public:
+
+	//Start recording to a file, frames are a fixed time step apart
+	bool StartRecording(const std::string& a_szPath, float a_fTimeStep);
+	//Stop recording, waits for the writer to finish and completes the file. Returns if the file was written
+	bool StopRecording();
+	bool IsRecording() const { return m_pFile != nullptr; }
+	unsigned int GetFrameCount() const { return m_uFrameCount; }
+
+	//Record the current state of every boid as a frame
+	void RecordFrame();
+
+private:
+	TrajectoryRecorder();
+	~TrajectoryRecorder();
+
+	//Quantized frames waiting to be encoded and written
+	struct FrameChunk
+	{
+		uint32_t uFirstFrame = 0u;
+		uint32_t uFrameCount = 0u;
+		uint32_t uBoidCount = 0u;
+		std::vector<uint16_t> vuValues; //sc_uValuesPerBoid for each boid of each frame
+	};
+
+	//Get an empty chunk to fill, only makes a new one if the writer has not finished with the others
+	FrameChunk* GetEmptyChunk();
+	//Give a chunk to the writer thread
+	void SubmitChunk();
+
+	//Loop the writer thread runs, writing chunks until recording stops
+	void WriterLoop();
+	void WriteChunk(const FrameChunk& a_xChunk);
+
+	//Frames in each chunk, each chunk starts with a key frame so this is how far seeking has to decode
+	static constexpr unsigned int sc_uFramesPerChunk = 32u;
+	//Number of chunks made when recording starts, one to fill and one to write
+	static constexpr unsigned int sc_uStartingChunkCount = 2u;
+	//Boids quantized in each job
+	static constexpr unsigned int sc_uBoidsPerJob = 256u;
+
+	//File being recorded to, it is written to a temporary path and renamed once it is complete
+	FILE* m_pFile;
+	std::string m_szPath;
+	std::string m_szTempPath;
+	TrajectoryFileHeader m_xHeader;
+
+	//Chunk the simulation thread is filling
+	FrameChunk* m_pFillingChunk;
+	unsigned int m_uFrameCount;
+
+	//Chunks are passed between the threads, full chunks to the writer and written chunks back
+	std::vector<std::unique_ptr<FrameChunk>> m_vpChunks;
+	std::deque<FrameChunk*> m_xFullChunks;
+	std::vector<FrameChunk*> m_vpEmptyChunks;
+	std::mutex m_xChunkMutex;
+	std::condition_variable m_xChunkSubmitted;
+	bool m_bStopWriter;
+	std::thread m_xWriterThread;
+
+	//Only touched by the writer thread while recording
+	std::vector<uint8_t> m_vuEncoded;
+	std::vector<TrajectoryIndexEntry> m_vxIndex;
+	uint64_t m_uWriteOffset;
+	bool m_bWriteFailed;
+};
+
+#endif //!__TRAJECTORY_RECORDER_H__
@@ -25,6 +25,8 @@ public:
 	explicit TransformComponent(Entity* a_pOwner);
 	~TransformComponent() = default;
 
+	DECLARE_POOLED_ALLOCATION()
+
 	void Update(float a_fDeltaTime) override {};
 	void Draw(Shader* a_pShader) override {};
 
@@ -36,9 +38,18 @@ public:
 	glm::vec3 GetEntityMatrixRow(MATRIX_ROW a_eRow);
 	glm::vec3 GetCurrentPosition();
 
+	//Store the current matrix as the previous simulation state, so
+	//that we can interpolate between the two when rendering
+	void StorePreviousMatrix();
+	glm::mat4 GetInterpolatedMatrix(float a_fAlpha) const;
+
 	//Get text name of the component
 	const char* GetComponentName() const override;
 
+	//Get type of the component, used to find the component on it's owner
+	COMPONENT_TYPE GetComponentType() const override { return sc_eComponentType; }
+	static constexpr COMPONENT_TYPE sc_eComponentType = COMPONENT_TYPE::COMPONENT_TYPE_TRANSFORM;
+
 private:
 
 	/*
@@ -51,6 +62,10 @@ private:
 	const char* m_szName = "Transform";
 	
 	glm::mat4 m_m4EntityMatrix;
+
+	//Matrix from the previous simulation step, only valid once it has been stored
+	glm::mat4 m_m4PreviousEntityMatrix;
+	bool m_bHasPreviousMatrix;
 };
 
 #endif // ! __TRANSFORM_COMPONENT_H__
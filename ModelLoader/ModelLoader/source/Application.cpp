@@ -15,6 +15,9 @@
 #include <imgui/imgui_impl_glfw.h>
 #include <imgui/imgui_impl_opengl3.h>
 
+//Project Includes
+#include "Profiler.h"
+
 /// <summary>
 /// Create the application
 /// </summary>
@@ -100,6 +103,8 @@ void Application::Deinitialize()
 
 bool Application::Update()
 {
+	PROFILE_SCOPE("Update/Application");
+
 	//Start New Imgui Frame
 	ImGui_ImplOpenGL3_NewFrame();
 	ImGui_ImplGlfw_NewFrame();
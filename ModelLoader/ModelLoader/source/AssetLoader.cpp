@@ -0,0 +1,197 @@
+#include "AssetLoader.h"
+
+//C++ Includes
+#include <iostream>
+
+//Lib Includes
+#include <learnopengl/model.h>
+
+//Project Includes
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "TraceRecorder.h"
+
+/// <summary>
+/// Create the asset loader
+/// </summary>
+AssetLoader::AssetLoader() :
+	m_uLoadsInProgress(0u),
+	m_pPlaceholderModel(nullptr)
+{
+}
+
+/// <summary>
+/// Destroy the asset loader, waiting for any loads still running so
+/// they don't finish after we are gone
+/// </summary>
+AssetLoader::~AssetLoader()
+{
+	CancelPendingLoads();
+}
+
+/// <summary>
+/// Start loading a model on a job system worker. The model is read and it's textures
+/// decoded on the worker, once that is done the model is uploaded and the callback called
+/// on the next call to ProcessUploads
+/// </summary>
+/// <param name="a_szModelPath">Path of the model file to load</param>
+/// <param name="a_fnOnLoaded">Function called with the model once it has been uploaded</param>
+void AssetLoader::LoadModelAsync(const std::string& a_szModelPath, const ModelLoadedCallback& a_fnOnLoaded)
+{
+	{
+		std::lock_guard<std::mutex> xLock(m_xLoadMutex);
+		++m_uLoadsInProgress;
+	}
+
+	JobSystem::GetInstance()->Schedule([this, a_szModelPath, a_fnOnLoaded]()
+	{
+		LoadedModel xLoadedModel;
+		{
+			TraceScope xLoadTrace("Load Model", "assets");
+			if (xLoadTrace.IsActive()) {
+				xLoadTrace.SetDetail(a_szModelPath);
+			}
+			xLoadedModel.bLoaded = ModelCache::LoadModelData(a_szModelPath, xLoadedModel.xModelData);
+		}
+		xLoadedModel.fnOnLoaded = a_fnOnLoaded;
+
+		std::lock_guard<std::mutex> xLock(m_xLoadMutex);
+		m_vLoadedModels.push_back(std::move(xLoadedModel));
+		--m_uLoadsInProgress;
+		m_xLoadFinished.notify_all();
+	});
+}
+
+/// <summary>
+/// Upload every model that has finished loading since the last call and tell
+/// whoever asked for them that they are ready
+/// </summary>
+void AssetLoader::ProcessUploads()
+{
+	PROFILE_SCOPE("Update/Asset Uploads");
+
+	//Take the finished models so that workers are not held up while we upload
+	std::vector<LoadedModel> vLoadedModels;
+	{
+		std::lock_guard<std::mutex> xLock(m_xLoadMutex);
+		if (m_vLoadedModels.empty()) {
+			return;
+		}
+		vLoadedModels.swap(m_vLoadedModels);
+	}
+
+	for (unsigned int i = 0; i < vLoadedModels.size(); ++i)
+	{
+		TraceScope xUploadTrace("Upload Model", "assets");
+		if (xUploadTrace.IsActive()) {
+			xUploadTrace.SetDetail(vLoadedModels[i].xModelData.szDirectory);
+		}
+		Model* pModel = vLoadedModels[i].bLoaded ? ModelCache::CreateModel(vLoadedModels[i].xModelData) : nullptr;
+		if (vLoadedModels[i].fnOnLoaded) {
+			vLoadedModels[i].fnOnLoaded(pModel);
+		}
+	}
+}
+
+/// <summary>
+/// Wait for every load running on a worker to finish, then throw away all of the
+/// loaded models without uploading them or calling their callbacks
+/// </summary>
+void AssetLoader::CancelPendingLoads()
+{
+	std::unique_lock<std::mutex> xLock(m_xLoadMutex);
+	m_xLoadFinished.wait(xLock, [this]() { return m_uLoadsInProgress == 0u; });
+	m_vLoadedModels.clear();
+}
+
+/// <summary>
+/// Get the number of models that are still loading or waiting to be uploaded
+/// </summary>
+/// <returns>Pending Load Count</returns>
+unsigned int AssetLoader::GetPendingLoadCount()
+{
+	std::lock_guard<std::mutex> xLock(m_xLoadMutex);
+	return m_uLoadsInProgress + static_cast<unsigned int>(m_vLoadedModels.size());
+}
+
+/// <summary>
+/// Get the placeholder model, creating it the first time it is used. Must
+/// be called on the main thread
+/// </summary>
+/// <returns>Placeholder Model</returns>
+Model* AssetLoader::GetPlaceholderModel()
+{
+	if (!m_pPlaceholderModel) {
+		m_pPlaceholderModel = CreatePlaceholderModel();
+	}
+	return m_pPlaceholderModel;
+}
+
+/// <summary>
+/// Delete the placeholder model and it's textures and GL buffers
+/// </summary>
+void AssetLoader::ReleasePlaceholderModel()
+{
+	ModelCache::DestroyModel(m_pPlaceholderModel);
+	m_pPlaceholderModel = nullptr;
+}
+
+/// <summary>
+/// Build the placeholder model, a diamond that is long along z like the fish
+/// models so boids still point the right way while their model is loading
+/// </summary>
+/// <returns>Placeholder Model</returns>
+Model* AssetLoader::CreatePlaceholderModel()
+{
+	//Points of the diamond, in the same units as the fish models
+	const glm::vec3 av3Points[] = {
+		glm::vec3(0.0f, 0.0f, 22.0f),	//Nose
+		glm::vec3(0.0f, 0.0f, -22.0f),	//Tail
+		glm::vec3(-6.0f, 0.0f, 0.0f),	//Left
+		glm::vec3(6.0f, 0.0f, 0.0f),	//Right
+		glm::vec3(0.0f, 14.0f, 0.0f),	//Top
+		glm::vec3(0.0f, -14.0f, 0.0f)	//Bottom
+	};
+	//Triangles of the diamond, each face gets it's own vertices so it has a flat normal
+	const unsigned int auTriangles[][3] = {
+		{ 0, 3, 4 }, { 0, 5, 3 }, { 0, 2, 5 }, { 0, 4, 2 },
+		{ 1, 4, 3 }, { 1, 3, 5 }, { 1, 5, 2 }, { 1, 2, 4 }
+	};
+
+	ModelData::MeshData xMeshData;
+	for (const unsigned int (&auTriangle)[3] : auTriangles)
+	{
+		const glm::vec3 v3Normal = glm::normalize(glm::cross(av3Points[auTriangle[1]] - av3Points[auTriangle[0]], av3Points[auTriangle[2]] - av3Points[auTriangle[0]]));
+		for (const unsigned int uPoint : auTriangle)
+		{
+			Vertex vertex;
+			vertex.Position = av3Points[uPoint];
+			vertex.Normal = v3Normal;
+			vertex.TexCoords = glm::vec2(0.5f);
+			vertex.Tangent = glm::vec3(0.0f);
+			vertex.Bitangent = glm::vec3(0.0f);
+			xMeshData.vIndices.push_back(static_cast<unsigned int>(xMeshData.vVertices.size()));
+			xMeshData.vVertices.push_back(vertex);
+		}
+	}
+
+	//Single grey pixel, so the shader has a diffuse texture to sample
+	ModelData::ImageData xImage;
+	xImage.szPath = "placeholder";
+	xImage.iWidth = 1;
+	xImage.iHeight = 1;
+	xImage.iComponents = 4;
+	xImage.vPixels = { 128, 128, 128, 255 };
+
+	Texture xTexture;
+	xTexture.id = 0;
+	xTexture.type = "texture_diffuse";
+	xTexture.path = xImage.szPath;
+	xMeshData.vTextures.push_back(xTexture);
+
+	ModelData xModelData;
+	xModelData.vMeshes.push_back(std::move(xMeshData));
+	xModelData.vImages.push_back(std::move(xImage));
+
+	return ModelCache::CreateModel(xModelData);
+}
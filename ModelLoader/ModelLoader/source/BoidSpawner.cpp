@@ -5,7 +5,7 @@
 
 //Project Includes
 #include "Scene.h"
-#include "MathsUtils.h"
+#include "CounterRandom.h"
 #include "DebugUI.h"
 //Colliders
 #include "ColliderComponent.h"
@@ -13,24 +13,35 @@
 #include "Entity.h"
 #include "ModelComponent.h"
 #include "RaycastComponent.h"
+#include "AssetLoader.h"
+#include "ModelCache.h"
+#include "BoidSystem.h"
+#include "TraceRecorder.h"
 
-//Typedefs
-typedef std::pair<const unsigned int, Entity*> BoidPair;
+//C++ Includes
+#include <algorithm>
 
 //Construct the boid spawner
 BoidSpawner::BoidSpawner() :
-	m_iBoidCount(0u)
+	m_uRandomKey(CounterRandom::GetKey(0u, RANDOM_DOMAIN::RANDOM_DOMAIN_SPAWN)),
+	m_uSpawnCount(0u),
+	m_pBoidCollisionWorld(nullptr)
 {
-	//Load all of the models 
-	LoadAllModels();
 }
 
 //Destructor
 BoidSpawner::~BoidSpawner()
 {
-	//Remove all of the boids from the linked list
-	//entity cleanup is dealt with by the scene
-	m_lpActiveEntities.Clear();
+	//Forget all of the boids, entity cleanup is dealt with by the scene
+	//and collision bodies are destroyed with the collision world
+	ForgetAllBoids();
+
+	//The free shapes are not used by any body, so they are ours to delete
+	for (unsigned int i = 0; i < m_vpFreeCollisionShapes.size(); ++i)
+	{
+		delete m_vpFreeCollisionShapes[i];
+	}
+	m_vpFreeCollisionShapes.clear();
 }
 
 /// <summary>
@@ -53,34 +64,57 @@ void BoidSpawner::SpawnBoid()
 
 	//Transform Component
 	TransformComponent* pTransform = new TransformComponent(pEntity);
-	pTransform->SetEntityMatrixRow(MATRIX_ROW::POSITION_VECTOR, glm::vec3(MathsUtils::RandomRange(-fSpawnBounds, fSpawnBounds),
-																		MathsUtils::RandomRange(-fSpawnBounds, fSpawnBounds),
-																		MathsUtils::RandomRange(-fSpawnBounds, fSpawnBounds)));
+	const uint64_t uSpawnStream = m_uSpawnCount++;
+	pTransform->SetEntityMatrixRow(MATRIX_ROW::POSITION_VECTOR, glm::vec3(CounterRandom::GetRange(-fSpawnBounds, fSpawnBounds, m_uRandomKey, uSpawnStream, 0u),
+																		CounterRandom::GetRange(-fSpawnBounds, fSpawnBounds, m_uRandomKey, uSpawnStream, 1u),
+																		CounterRandom::GetRange(-fSpawnBounds, fSpawnBounds, m_uRandomKey, uSpawnStream, 2u)));
 	pEntity->AddComponent(pTransform);
 
-	//Model Component
-	ModelComponent* pModel = new ModelComponent(pEntity);
-	pModel->ChooseRandomModel(m_vpLoadedModels);
-	pModel->SetScale(0.02f);
-	pEntity->AddComponent(pModel);
+	//Model Component, only if we have models to draw (we don't load any when running
+	//headless). Models may still be loading, the boid draws a placeholder until it's model is ready
+	if (!m_vpLoadedModels.empty())
+	{
+		ModelComponent* pModel = new ModelComponent(pEntity);
+		pModel->ChooseRandomModel(m_vpLoadedModels);
+		pModel->SetScale(0.02f);
+		pEntity->AddComponent(pModel);
+	}
 
 	//Brain Component
 	BrainComponent* pBrain = new BrainComponent(pEntity);
 	pEntity->AddComponent(pBrain);
 
-	//Collider Component
-	ColliderComponent* pCollider = new ColliderComponent(pEntity, m_pBoidCollisionWorld);
-	pCollider->AddSphereCollider(0.25f, glm::vec3(0.0f));
+	//Collider Component, using the body of a destroyed boid if we have one
+	rp3d::CollisionBody* pCollisionBody = nullptr;
+	if (!m_vpFreeCollisionBodies.empty())
+	{
+		pCollisionBody = m_vpFreeCollisionBodies.back();
+		m_vpFreeCollisionBodies.pop_back();
+	}
+	ColliderComponent* pCollider = new ColliderComponent(pEntity, m_pBoidCollisionWorld, pCollisionBody);
+	if (!m_vpFreeCollisionShapes.empty())
+	{
+		pCollider->AddCollisionShape(m_vpFreeCollisionShapes.back(), glm::vec3(0.0f));
+		m_vpFreeCollisionShapes.pop_back();
+	}
+	else
+	{
+		pCollider->AddSphereCollider(m_fColliderRadius, glm::vec3(0.0f));
+	}
 	pEntity->AddComponent(pCollider);
 
 	//Raycast Component
 	RaycastComponent* pRayCaster = new RaycastComponent(pEntity, m_pBoidCollisionWorld);
 	pEntity->AddComponent(pRayCaster);
 
-	//Add to linked list
-	m_lpActiveEntities.Push(pEntity);
-
-	++m_iBoidCount;
+	//Add to the end of the active list
+	const unsigned int uEntityID = pEntity->GetEntityID();
+	if (uEntityID >= m_viActiveEntityIndices.size())
+	{
+		m_viActiveEntityIndices.resize(uEntityID + 1u, 0u);
+	}
+	m_viActiveEntityIndices[uEntityID] = static_cast<unsigned int>(m_vpActiveEntities.size());
+	m_vpActiveEntities.push_back(pEntity);
 }
 
 /// <summary>
@@ -89,6 +123,18 @@ void BoidSpawner::SpawnBoid()
 /// <param name="a_iCount">Number of boids to spawn</param>
 void BoidSpawner::SpawnBoids(const unsigned int a_iCount)
 {
+	if (m_pBoidCollisionWorld == nullptr)
+	{
+		return;
+	}
+
+	//Make room for all of the boids up front and create all of the collision bodies
+	//that we can't reuse in one batch, so we only grow each list once
+	const unsigned int uTotalCount = GetBoidCount() + a_iCount;
+	m_vpActiveEntities.reserve(uTotalCount);
+	BoidSystem::GetInstance()->ReserveBoids(uTotalCount);
+	ReserveCollisionBodies(a_iCount);
+
 	for (unsigned int i = 0; i < a_iCount; ++i)
 	{
 		SpawnBoid();
@@ -103,15 +149,16 @@ void BoidSpawner::SpawnBoids(const unsigned int a_iCount)
 /// <param name="a_iTargetCount"></param>
 void BoidSpawner::AdjustBoidCount(const unsigned int a_iTargetCount)
 {
-	const int iCountDiff = a_iTargetCount - m_iBoidCount;
+	TRACE_SCOPE("BoidSpawner::AdjustBoidCount", "scene");
 
 	//If we have too few boids spawn them, otherwise destroy
-	if(iCountDiff > 0)
+	const unsigned int uBoidCount = GetBoidCount();
+	if(a_iTargetCount > uBoidCount)
 	{
-		SpawnBoids(iCountDiff);
-	}else if(iCountDiff < 0)
+		SpawnBoids(a_iTargetCount - uBoidCount);
+	}else if(a_iTargetCount < uBoidCount)
 	{
-		DestroyBoids(abs(iCountDiff));
+		DestroyBoids(uBoidCount - a_iTargetCount);
 	}
 }
 
@@ -121,12 +168,42 @@ void BoidSpawner::AdjustBoidCount(const unsigned int a_iTargetCount)
 /// <param name="a_pEntity">Boid to destroy</param>
 void BoidSpawner::DestroyBoid(Entity* a_pEntity)
 {
-	//Remove the entity from the linked list
-	m_lpActiveEntities.Pop(a_pEntity);
+	//Check that the entity is one of our boids
+	if (a_pEntity == nullptr)
+	{
+		return;
+	}
+	const unsigned int uEntityID = a_pEntity->GetEntityID();
+	if (uEntityID >= m_viActiveEntityIndices.size())
+	{
+		return;
+	}
+	const unsigned int uIndex = m_viActiveEntityIndices[uEntityID];
+	if (uIndex >= m_vpActiveEntities.size() || m_vpActiveEntities[uIndex] != a_pEntity)
+	{
+		return;
+	}
+
+	//Remove the entity from the active list, by moving the last boid in to it's place
+	Entity* pLastEntity = m_vpActiveEntities.back();
+	m_vpActiveEntities[uIndex] = pLastEntity;
+	m_viActiveEntityIndices[pLastEntity->GetEntityID()] = uIndex;
+	m_vpActiveEntities.pop_back();
+
+	//Keep the collision body and it's shape to give to the next boid we spawn
+	ColliderComponent* pCollider = a_pEntity->GetComponent<ColliderComponent*>();
+	if (pCollider)
+	{
+		rp3d::CollisionBody* pCollisionBody = pCollider->ReleaseCollisionBody();
+		if (pCollisionBody)
+		{
+			m_vpFreeCollisionBodies.push_back(pCollisionBody);
+		}
+		pCollider->ReleaseCollisionShapes(m_vpFreeCollisionShapes);
+	}
 	
 	//Delete Entity
 	delete a_pEntity;
-	--m_iBoidCount;
 }
 
 /// <summary>
@@ -135,35 +212,39 @@ void BoidSpawner::DestroyBoid(Entity* a_pEntity)
 /// <param name="a_iCount"></param>
 void BoidSpawner::DestroyBoids(const unsigned int a_iCount)
 {
-	//Destroy the given number of boids by destroying the
-	//boid at the start of the linked list
-	for(unsigned int  i = 0; i < a_iCount; ++i)
+	//Destroy the given number of boids by destroying the boid at the end of the active
+	//list, so no boids have to be moved. We can't destroy more boids than we have
+	const unsigned int uDestroyCount = std::min(a_iCount, GetBoidCount());
+	m_vpFreeCollisionBodies.reserve(m_vpFreeCollisionBodies.size() + uDestroyCount);
+	m_vpFreeCollisionShapes.reserve(m_vpFreeCollisionShapes.size() + uDestroyCount);
+	for(unsigned int  i = 0; i < uDestroyCount; ++i)
 	{
-		//Get boid at the head of the linked list
-		Entity* currentBoid = m_lpActiveEntities.Search(0);
-
-		//If the boid is a nullptr then the list is empty and thus we cannot destory
-		//anymore boids
-		if(currentBoid == nullptr)
-		{
-			return;
-		}
-
-		//Remove from Linked List and Destroy
-		m_lpActiveEntities.Pop(currentBoid);
-		DestroyBoid(currentBoid);
+		DestroyBoid(m_vpActiveEntities.back());
 	}
 }
 
+/// <summary>
+/// Forget about all of the boids we have spawned, without destroying them. Used when the scene
+/// is deinitialised as it deletes every entity itself, otherwise we would keep hold of deleted boids
+/// and destroy them again the next time the boid count changes. The free collision bodies are
+/// forgotten too as they are destroyed with the collision world
+/// </summary>
+void BoidSpawner::ForgetAllBoids()
+{
+	m_vpActiveEntities.clear();
+	m_viActiveEntityIndices.clear();
+	m_vpFreeCollisionBodies.clear();
+}
+
 /// <summary>
 /// Get a pointer to a boid from a given position in
-/// the boid linked list
+/// the list of active boids
 /// </summary>
-/// <param name="a_iBoidPos">Position in linked list</param>
-/// <returns></returns>
+/// <param name="a_iBoidPos">Position in the active list</param>
+/// <returns>Boid, nullptr if the position is past the end of the list</returns>
 Entity* BoidSpawner::GetBoidInfo(const unsigned int a_iBoidPos)
 {
-	return m_lpActiveEntities.Search(a_iBoidPos);
+	return a_iBoidPos < m_vpActiveEntities.size() ? m_vpActiveEntities[a_iBoidPos] : nullptr;
 }
 
 /// <summary>
@@ -171,14 +252,60 @@ Entity* BoidSpawner::GetBoidInfo(const unsigned int a_iBoidPos)
 /// </summary>
 void BoidSpawner::SetCollisionWorld(rp3d::CollisionWorld* a_pCollisionWorld)
 {
+	//Free bodies belong to the old world
+	if (a_pCollisionWorld != m_pBoidCollisionWorld)
+	{
+		m_vpFreeCollisionBodies.clear();
+	}
 	m_pBoidCollisionWorld = a_pCollisionWorld;
 }
 
 /// <summary>
-/// Load all of the models used by the program
+/// Seed the random numbers that boids are spawned with. The spawn count restarts so that
+/// the same seed always spawns the same boids in the same places
+/// </summary>
+/// <param name="a_uSeed">Seed to spawn boids with</param>
+void BoidSpawner::SetRandomSeed(const unsigned int a_uSeed)
+{
+	m_uRandomKey = CounterRandom::GetKey(a_uSeed, RANDOM_DOMAIN::RANDOM_DOMAIN_SPAWN);
+	m_uSpawnCount = 0u;
+}
+
+/// <summary>
+/// Make sure we have at least a number of free collision bodies, the bodies we are missing
+/// are created together before any boids are spawned rather than as each boid is made
+/// </summary>
+/// <param name="a_iCount">Number of free bodies we need</param>
+void BoidSpawner::ReserveCollisionBodies(const unsigned int a_iCount)
+{
+	if (m_pBoidCollisionWorld == nullptr || m_vpFreeCollisionBodies.size() >= a_iCount)
+	{
+		return;
+	}
+
+	//New bodies go at the front of the list so that the bodies we already have are used first,
+	//and in reverse so they are given to boids in the order they were created
+	const unsigned int uMissingCount = a_iCount - static_cast<unsigned int>(m_vpFreeCollisionBodies.size());
+	std::vector<rp3d::CollisionBody*> vpNewBodies(uMissingCount);
+	for (unsigned int i = 0; i < uMissingCount; ++i)
+	{
+		vpNewBodies[uMissingCount - 1u - i] = m_pBoidCollisionWorld->createCollisionBody(rp3d::Transform::identity());
+	}
+	m_vpFreeCollisionBodies.insert(m_vpFreeCollisionBodies.begin(), vpNewBodies.begin(), vpNewBodies.end());
+}
+
+/// <summary>
+/// Start loading all of the models used by the program in the background, each model's
+/// slot is empty until it has loaded so that boids can be spawned straight away
 /// </summary>
 void BoidSpawner::LoadAllModels()
 {
+	//Don't load the models twice, they are kept when the scene restarts
+	if (!m_vpLoadedModels.empty())
+	{
+		return;
+	}
+
 	/* Model Files are stored in the format
 	 * Fish01, Fish02 etc. so we just loop through
 	 * with the same prefix to load all of the models
@@ -186,29 +313,38 @@ void BoidSpawner::LoadAllModels()
 	const std::string modelFilePrefix = "models/fish/Fish0";
 	const std::string modelFileSuffix = ".obj";
 
-	//Loop until we have loaded all models
+	//Make a slot for every model up front, the slots must not move as
+	//boids keep hold of the list to find their model once it has loaded
+	m_vpLoadedModels.resize(m_iModelCount, nullptr);
+
+	//Loop until we have started loading all models
 	for (int i = 1; i <= m_iModelCount; ++i)
 	{
-		//Generate file name and load model
+		//Generate file name and load model, the model is put in it's slot
+		//on the main thread once it has been uploaded
 		const std::string modelFileName = modelFilePrefix + std::to_string(i) + modelFileSuffix;
-		Model* newModel = new Model(modelFileName);
-
-		if (newModel != nullptr) {
-			//Add to our loaded models
-			m_vpLoadedModels.push_back(newModel);
-		}
+		const int iModelSlot = i - 1;
+		AssetLoader::GetInstance()->LoadModelAsync(modelFileName, [this, iModelSlot](Model* a_pModel)
+		{
+			m_vpLoadedModels[iModelSlot] = a_pModel;
+		});
 	}
 
 }
 
 /// <summary>
-/// Unload all of the models
+/// Unload all of the models, any models that are still loading are thrown away
 /// </summary>
 void BoidSpawner::UnloadAllModels()
 {
-	for (int i = 0; i < m_vpLoadedModels.size(); ++i)
+	AssetLoader::GetInstance()->CancelPendingLoads();
+
+	//Models are made by the model cache, so they are deleted by it to free their textures and GL buffers
+	for (unsigned int i = 0; i < m_vpLoadedModels.size(); ++i)
 	{
-		delete m_vpLoadedModels[i];
+		ModelCache::DestroyModel(m_vpLoadedModels[i]);
 	}
 	m_vpLoadedModels.clear();
+
+	AssetLoader::GetInstance()->ReleasePlaceholderModel();
 }
@@ -0,0 +1,867 @@
+#include "BoidSystem.h"
+
+//C++ Includes
+#include <algorithm>
+
+//Project Incldues
+#include "BrainComponent.h"
+#include "RaycastComponent.h"
+#include "DebugUI.h"
+#include "SpatialHashGrid.h"
+#include "JobSystem.h"
+#include "Entity.h"
+#include "TransformComponent.h"
+#include "ColliderComponent.h"
+#include "Scene.h"
+#include "Profiler.h"
+#include "TraceRecorder.h"
+#include "FlockingKernel.h"
+#include "CounterRandom.h"
+
+/// <summary>
+/// Create the boid system
+/// </summary>
+BoidSystem::BoidSystem() :
+	m_bUseNeighbourLists(false),
+	m_bNeighbourListsDirty(true),
+	m_fNeighbourListRadius(0.0f),
+	m_uNeighbourListRebuildCount(0u),
+	m_uNeighbourListStepCount(0u),
+	m_bCollisionBodiesDirty(false),
+	m_uRandomKey(CounterRandom::GetKey(0u, RANDOM_DOMAIN::RANDOM_DOMAIN_WANDER)),
+	m_uNextRandomStream(0u),
+	m_uRandomStep(0u),
+	m_pDebugUI(DebugUI::GetInstance()),
+	m_fNeighbourRadius(5.0f),
+	m_bAnalyticContainment(true),
+	m_v3ContainmentExtent(0.0f)
+{
+}
+
+/// <summary>
+/// Add a boid to the system, taking it's starting position and
+/// forward from the transform of the brain's owner
+/// </summary>
+/// <param name="a_pBrain">Brain that will own the boid</param>
+/// <returns>Index of the boid in the system</returns>
+unsigned int BoidSystem::AddBoid(BrainComponent* a_pBrain)
+{
+	glm::vec3 v3StartPos(0.f);
+	glm::vec3 v3StartForward(0.f, 0.f, 1.f);
+
+	//Get our starting transform values
+	Entity* pOwner = a_pBrain ? a_pBrain->GetOwnerEntity() : nullptr;
+	if (pOwner)
+	{
+		TransformComponent* pTransform = pOwner->GetComponent<TransformComponent*>();
+		if (pTransform)
+		{
+			v3StartPos = pTransform->GetCurrentPosition();
+			v3StartForward = pTransform->GetEntityMatrixRow(MATRIX_ROW::FORWARD_VECTOR);
+		}
+	}
+
+	m_vV3Positions.push_back(v3StartPos);
+	m_vV3Velocities.push_back(glm::vec3(0.f));
+	m_vV3Forwards.push_back(v3StartForward);
+	m_vV3WanderPoints.push_back(glm::vec3(0.f));
+	m_vpBrains.push_back(a_pBrain);
+	m_vuRandomStreams.push_back(m_uNextRandomStream++);
+
+	//The new boid is not on any neighbour list
+	m_bNeighbourListsDirty = true;
+
+	return GetBoidCount() - 1u;
+}
+
+/// <summary>
+/// Remove a boid from the system. The last boid is moved in to the removed
+/// boid's slot so that the arrays stay tightly packed
+/// </summary>
+/// <param name="a_uBoidIndex">Index of the boid to remove</param>
+void BoidSystem::RemoveBoid(const unsigned int a_uBoidIndex)
+{
+	if (a_uBoidIndex >= GetBoidCount())
+	{
+		return;
+	}
+
+	//Move the last boid in to this slot and tell it's brain where it now lives
+	const unsigned int uLastIndex = GetBoidCount() - 1u;
+	if (a_uBoidIndex != uLastIndex)
+	{
+		m_vV3Positions[a_uBoidIndex] = m_vV3Positions[uLastIndex];
+		m_vV3Velocities[a_uBoidIndex] = m_vV3Velocities[uLastIndex];
+		m_vV3Forwards[a_uBoidIndex] = m_vV3Forwards[uLastIndex];
+		m_vV3WanderPoints[a_uBoidIndex] = m_vV3WanderPoints[uLastIndex];
+		m_vpBrains[a_uBoidIndex] = m_vpBrains[uLastIndex];
+		m_vpBrains[a_uBoidIndex]->SetBoidIndex(a_uBoidIndex);
+		m_vuRandomStreams[a_uBoidIndex] = m_vuRandomStreams[uLastIndex];
+	}
+
+	m_vV3Positions.pop_back();
+	m_vV3Velocities.pop_back();
+	m_vV3Forwards.pop_back();
+	m_vV3WanderPoints.pop_back();
+	m_vpBrains.pop_back();
+	m_vuRandomStreams.pop_back();
+
+	//The last boid has moved, so the lists point to the wrong boid
+	m_bNeighbourListsDirty = true;
+}
+
+/// <summary>
+/// Make room for a total number of boids in all of the arrays, used before
+/// adding a batch of boids so that each array is only grown once
+/// </summary>
+/// <param name="a_uBoidCount">Total number of boids to make room for</param>
+void BoidSystem::ReserveBoids(const unsigned int a_uBoidCount)
+{
+	m_vV3Positions.reserve(a_uBoidCount);
+	m_vV3Velocities.reserve(a_uBoidCount);
+	m_vV3Forwards.reserve(a_uBoidCount);
+	m_vV3WanderPoints.reserve(a_uBoidCount);
+	m_vpBrains.reserve(a_uBoidCount);
+	m_vuRandomStreams.reserve(a_uBoidCount);
+}
+
+/// <summary>
+/// Seed the random numbers that boids wander with. Boids get their random streams in the order they are
+/// added, so the streams and the step count are restarted too, then the same seed and spawn order always
+/// give the same random numbers
+/// </summary>
+/// <param name="a_uSeed">Seed to use</param>
+void BoidSystem::SetRandomSeed(const unsigned int a_uSeed)
+{
+	m_uRandomKey = CounterRandom::GetKey(a_uSeed, RANDOM_DOMAIN::RANDOM_DOMAIN_WANDER);
+	m_uNextRandomStream = 0u;
+	m_uRandomStep = 0u;
+}
+
+/// <summary>
+/// Update all of the boids, calcuating new forces for flocking, steering and
+/// collision avoidance
+/// </summary>
+/// <param name="a_fDeltaTime">Delta Time</param>
+void BoidSystem::Update(const float a_fDeltaTime)
+{
+	PROFILE_SCOPE("Update/Step/Boids");
+
+	//Break if we don't have a UI instance, as we can't
+	//control anything
+	if (!m_pDebugUI)
+	{
+		return;
+	}
+
+	//Get the UI values
+	const UIInputValues* pUIValues = m_pDebugUI->GetUIInputValues();
+
+	//Update Radius
+	m_fNeighbourRadius = pUIValues->fInputNeighbourRadius.value;
+
+	//Update how we contain the boids, the extent comes from the scene as the UI bounds
+	//size does not change the walls until the scene is restarted
+	m_bAnalyticContainment = pUIValues->bAnalyticContainment;
+	m_v3ContainmentExtent = Scene::GetInstance()->GetBoundsInnerExtent();
+
+	//The collision rays must hit the other boids where they are now
+	if (m_bCollisionBodiesDirty)
+	{
+		SyncCollisionBodies();
+	}
+
+	//Make sure every thread has it's own list of neighbour candidates
+	JobSystem* pJobSystem = JobSystem::GetInstance();
+	if (m_vvpNeighbourCandidates.size() < pJobSystem->GetThreadCount())
+	{
+		m_vvpNeighbourCandidates.resize(pJobSystem->GetThreadCount());
+	}
+	if (m_vxFlockingCandidates.size() < pJobSystem->GetThreadCount())
+	{
+		m_vxFlockingCandidates.resize(pJobSystem->GetThreadCount());
+	}
+
+	//Find neighbours either with the neighbour lists, which are only rebuilt when boids have moved far enough,
+	//or by searching the spatial grid
+	m_bUseNeighbourLists = pUIValues->bNeighbourLists;
+	if (m_bUseNeighbourLists)
+	{
+		UpdateNeighbourLists(pUIValues->fNeighbourListSkin.value);
+	}
+	else
+	{
+		//Rebuild the spatial grid from the state at the start of this frame so boids can find their
+		//neighbours, cells are the size of the neighbour radius so a boid only has to search the cells around it
+		PROFILE_SCOPE("Update/Step/Boids/Spatial Grid");
+		SpatialHashGrid::GetInstance()->Rebuild(m_vV3Positions, m_vV3Velocities, m_fNeighbourRadius);
+
+		//The lists are not kept up to date while we are not using them
+		m_bNeighbourListsDirty = true;
+	}
+
+	//Run the behaviour pipeline over every boid, split in to chunks across the job system.
+	//Each boid only writes to it's own state and reads other boids from the grid (last frame's state)
+	//so the chunks can run at the same time
+	pJobSystem->ParallelFor(GetBoidCount(), sc_uBoidsPerJob, [this, a_fDeltaTime, pUIValues](const unsigned int a_uStart, const unsigned int a_uEnd, const unsigned int a_uThreadIndex)
+	{
+		TraceScope xChunkTrace("Boid Chunk", "boids");
+		if (xChunkTrace.IsActive()) {
+			xChunkTrace.SetDetail("boids " + std::to_string(a_uStart) + "-" + std::to_string(a_uEnd - 1));
+		}
+
+		//The job system can give us more than one chunk at once (e.g when it has no workers), so work through them in batches
+		for (unsigned int uBatchStart = a_uStart; uBatchStart < a_uEnd; uBatchStart += sc_uBoidsPerJob)
+		{
+			StepBoidBatch(uBatchStart, std::min(uBatchStart + sc_uBoidsPerJob, a_uEnd), a_uThreadIndex, a_fDeltaTime, pUIValues);
+		}
+	});
+
+	//Boids draw different random numbers next step
+	++m_uRandomStep;
+}
+
+/// <summary>
+/// Move the collision body of every boid to it's transform. The broadphase can not be
+/// updated from more than one thread, so this is done on the calling thread
+/// </summary>
+void BoidSystem::SyncCollisionBodies()
+{
+	PROFILE_SCOPE("Update/Step/Boids/Sync Collision Bodies");
+	TRACE_SCOPE("Sync Collision Bodies", "physics");
+
+	for (unsigned int i = 0; i < GetBoidCount(); ++i)
+	{
+		Entity* pOwner = m_vpBrains[i]->GetOwnerEntity();
+		ColliderComponent* pCollider = pOwner ? pOwner->GetComponent<ColliderComponent*>() : nullptr;
+		if (pCollider)
+		{
+			pCollider->Update(0.0f);
+		}
+	}
+	m_bCollisionBodiesDirty = false;
+}
+
+/// <summary>
+/// Run the behaviour pipeline over a batch of boids, one phase at a time. Each phase is timed once for
+/// the whole batch rather than for every boid, so profiling does not slow down large flocks
+/// </summary>
+/// <param name="a_uBatchStart">Index of the first boid in the batch</param>
+/// <param name="a_uBatchEnd">Index after the last boid in the batch, at most sc_uBoidsPerJob after the start</param>
+/// <param name="a_uThreadIndex">Index of the job system thread that is stepping the batch</param>
+/// <param name="a_fDeltaTime">Delta Time</param>
+/// <param name="a_pUIValues">UI Values used for weighting forces</param>
+void BoidSystem::StepBoidBatch(const unsigned int a_uBatchStart, const unsigned int a_uBatchEnd, const unsigned int a_uThreadIndex, const float a_fDeltaTime, const UIInputValues* a_pUIValues)
+{
+	BoidForces axForces[sc_uBoidsPerJob];
+
+	/*~~~~COLLISION AVOIDANCE~~~~*/
+	//Do the raycasts of the whole batch before steering any boid. Collider bodies are only moved
+	//when the entities update after this, so stepping a boid does not change what the others hit
+	{
+		PROFILE_SCOPE("Update/Step/Boids/Collision Rays");
+		TRACE_SCOPE("Collision Raycasts", "physics");
+		for (unsigned int i = a_uBatchStart; i < a_uBatchEnd; ++i)
+		{
+			BoidForces& xForces = axForces[i - a_uBatchStart];
+			xForces.v3Containment = glm::vec3(0.0f);
+			xForces.v3Avoidance = glm::vec3(0.0f);
+			CalculateCollisionForces(i, xForces.v3Containment, xForces.v3Avoidance);
+		}
+	}
+
+	TRACE_SCOPE("Steering", "boids");
+
+	/*~~~~FLOCKING~~~~*/
+	//Boids only read the flock's state from the start of the frame, so no boid in the batch
+	//has to be integrated before the others find their flocking forces
+	{
+		PROFILE_SCOPE("Update/Step/Boids/Flocking");
+		for (unsigned int i = a_uBatchStart; i < a_uBatchEnd; ++i)
+		{
+			BoidForces& xForces = axForces[i - a_uBatchStart];
+			xForces.v3Separation = glm::vec3(0.f);
+			xForces.v3Alignment = glm::vec3(0.f);
+			xForces.v3Cohesion = glm::vec3(0.f);
+			CalculateFlockingForces(i, a_uThreadIndex, xForces.v3Separation, xForces.v3Alignment, xForces.v3Cohesion);
+			ApplyFlockingWeights(a_pUIValues, xForces.v3Separation, xForces.v3Alignment, xForces.v3Cohesion);
+		}
+	}
+
+	/*~~~~WANDER~~~~*/
+	//Get and weight wander force
+	{
+		PROFILE_SCOPE("Update/Step/Boids/Wander");
+		for (unsigned int i = a_uBatchStart; i < a_uBatchEnd; ++i)
+		{
+			axForces[i - a_uBatchStart].v3Wander = CalculateWanderForce(i, a_pUIValues) * a_pUIValues->fInputWanderForce.value;
+		}
+	}
+
+	/*~~~~INTEGRATION~~~~*/
+	{
+		PROFILE_SCOPE("Update/Step/Boids/Integration");
+		for (unsigned int i = a_uBatchStart; i < a_uBatchEnd; ++i)
+		{
+			IntegrateBoid(i, a_fDeltaTime, a_pUIValues, axForces[i - a_uBatchStart]);
+		}
+	}
+}
+
+/// <summary>
+/// Add up the forces on a single boid in order until it reaches the max force, integrate it's
+/// velocity and position then write the result back to the boid's transform
+/// </summary>
+/// <param name="a_uBoidIndex">Index of the boid to integrate</param>
+/// <param name="a_fDeltaTime">Delta Time</param>
+/// <param name="a_pUIValues">UI Values used for weighting forces</param>
+/// <param name="a_xForces">Forces found for this boid by the earlier phases, collision forces are not weighted yet</param>
+void BoidSystem::IntegrateBoid(const unsigned int a_uBoidIndex, const float a_fDeltaTime, const UIInputValues* a_pUIValues, const BoidForces& a_xForces)
+{
+	//Forces in the order that we want to process them (i.e should they be applied?), kept
+	//on the stack as this runs for every boid on every worker
+	const glm::vec3 aV3WeightedForces[] = {
+		a_xForces.v3Containment * a_pUIValues->fInputContainmentForce.value,
+		a_xForces.v3Avoidance * a_pUIValues->fInputContainmentForce.value,
+		a_xForces.v3Separation,
+		a_xForces.v3Alignment,
+		a_xForces.v3Cohesion,
+		a_xForces.v3Wander
+	};
+
+	//Do weighted sum calcuations. Apply forces with their weighting and then check if
+	//they are over the maximum force
+	glm::vec3 v3FinalForce(0.f);
+	const unsigned int uForceCount = sizeof(aV3WeightedForces) / sizeof(aV3WeightedForces[0]);
+	for (unsigned int i = 0; i < uForceCount; ++i)
+	{
+		//If we are over our max force then break
+		if (glm::length(v3FinalForce) > glm::length(mc_v3MaxForce))
+		{
+			//if we over the max force then break the loop
+			break;
+		}
+
+		//Add forces to our final force
+		v3FinalForce += aV3WeightedForces[i];
+	}
+
+	//Clamp values
+	v3FinalForce = glm::clamp(v3FinalForce, mc_v3MinForce, mc_v3MaxForce);
+
+	//Calculate Speed and direction, apply limits on speed
+	glm::vec3& v3Velocity = m_vV3Velocities[a_uBoidIndex];
+	v3Velocity += v3FinalForce;
+	v3Velocity = glm::clamp(v3Velocity, mc_v3MinVelocity, mc_v3MaxVelocity);
+
+	glm::vec3& v3Position = m_vV3Positions[a_uBoidIndex];
+	glm::vec3& v3Forward = m_vV3Forwards[a_uBoidIndex];
+	v3Position += v3Velocity * a_fDeltaTime;
+	v3Forward = glm::length(v3Velocity) > 0.f ? glm::normalize(v3Velocity) : glm::vec3(0.f, 0.f, 1.f);
+
+	//Write the new state back to the boid's transform so it
+	//can be rendered and collided with
+	Entity* pOwner = m_vpBrains[a_uBoidIndex]->GetOwnerEntity();
+	TransformComponent* pTransform = pOwner ? pOwner->GetComponent<TransformComponent*>() : nullptr;
+	if (pTransform)
+	{
+		//Keep the last state so rendering can interpolate between them
+		pTransform->StorePreviousMatrix();
+
+		pTransform->SetEntityMatrixRow(MATRIX_ROW::FORWARD_VECTOR, v3Forward);
+		pTransform->SetEntityMatrixRow(MATRIX_ROW::POSITION_VECTOR, v3Position);
+
+		//When we update our transform make sure we Orthogonalize the matrix
+		pTransform->Orthogonalize();
+	}
+}
+
+/// <summary>
+/// Calculate the force to seek towards a target position
+/// </summary>
+/// <param name="a_v3Target">Target Position</param>
+/// <param name="a_v3CurrentPos">Current Position</param>
+/// <param name="a_v3CurrentVelocity">Current Velocity</param>
+/// <returns>Force to seek</returns>
+glm::vec3 BoidSystem::CalculateSeekForce(const glm::vec3& a_v3Target, const glm::vec3& a_v3CurrentPos, const glm::vec3& a_v3CurrentVelocity) const
+{
+	//Calculate Target Direction
+	const glm::vec3 v3TargetDir = GetPointDirection(a_v3Target, a_v3CurrentPos);
+
+	//Calc New Velocity
+	const glm::vec3 v3NewVelocity = v3TargetDir;
+
+	//Force is target velocity - current velocity
+	return (v3NewVelocity - a_v3CurrentVelocity);
+}
+
+/// <summary>
+/// Calculate the force to flee from a target position
+/// </summary>
+/// <param name="a_v3Target">Target Position</param>
+/// <param name="a_v3CurrentPos">Current Position</param>
+/// <param name="a_v3CurrentVelocity">Current Velocity</param>
+/// <returns>Force to flee</returns>
+glm::vec3 BoidSystem::CalculateFleeForce(const glm::vec3& a_v3Target, const glm::vec3& a_v3CurrentPos, const glm::vec3& a_v3CurrentVelocity) const
+{
+	//Calculate Target Direction (away from the )
+	const glm::vec3 v3TargetDir = GetPointDirection(a_v3CurrentPos, a_v3Target);
+
+	//Calc New Velocity
+	const glm::vec3 v3NewVelocity = v3TargetDir;
+
+	//Force is target velocity - current velocity
+	return (v3NewVelocity - a_v3CurrentVelocity);
+}
+
+/// <summary>
+/// Calculate the wander force by casting a sphere and choosing a point on it
+/// </summary>
+/// <param name="a_uBoidIndex">Index of the boid to wander</param>
+/// <param name="a_pUIValues">UI Values for the wander sphere</param>
+/// <returns>Force to apply for wander</returns>
+glm::vec3 BoidSystem::CalculateWanderForce(const unsigned int a_uBoidIndex, const UIInputValues* a_pUIValues)
+{
+	//Get our current position and forward
+	const glm::vec3& v3CurrentPos = m_vV3Positions[a_uBoidIndex];
+	const glm::vec3& v3CurrentForward = m_vV3Forwards[a_uBoidIndex];
+	glm::vec3& v3WanderPoint = m_vV3WanderPoints[a_uBoidIndex];
+
+	//Project a point in front of us for the center of our sphere
+	const glm::vec3 v3SphereOrigin = v3CurrentPos + (v3CurrentForward * a_pUIValues->fInputWanderForward.value);
+
+	//Random numbers come from our stream, with 2 draws each step
+	const uint64_t uRandomStream = m_vuRandomStreams[a_uBoidIndex];
+	const uint64_t uRandomCounter = m_uRandomStep * 2u;
+
+	//If the magnitude of the vector is 0 then initalize our
+	//first wander point
+	if (glm::length(v3WanderPoint) == 0.0f)
+	{
+		//Find a random point omn a sphere
+		const glm::vec3 v3RandomPointOnSphere = CounterRandom::GetPointOnSphere(a_pUIValues->fInputWanderRadius.value, m_uRandomKey, uRandomStream, uRandomCounter);
+		//Add this point on a sphere to the sphere we are casting out infront of us
+		v3WanderPoint = v3SphereOrigin + v3RandomPointOnSphere;
+	}
+
+	//Calculate direction to move to
+	const glm::vec3 v3DirectionToTarget = GetPointDirection(v3WanderPoint, v3SphereOrigin) * a_pUIValues->fInputWanderRadius.value;
+	//Find out final target point
+	v3WanderPoint = v3SphereOrigin + v3DirectionToTarget;
+	//Add Jitter
+	v3WanderPoint += CounterRandom::GetPointOnSphere(a_pUIValues->fInputWanderJitter.value, m_uRandomKey, uRandomStream, uRandomCounter + 1u);
+
+	return CalculateSeekForce(v3WanderPoint, v3CurrentPos, m_vV3Velocities[a_uBoidIndex]);
+}
+
+/// <summary>
+/// Gets the direction between 2 points
+/// </summary>
+/// <param name="a_v3Start">Start Point</param>
+/// <param name="a_v3End">End Point</param>
+/// <returns>Direction from Start to End Point </returns>
+glm::vec3 BoidSystem::GetPointDirection(const glm::vec3& a_v3Start, const glm::vec3& a_v3End)
+{
+	//Get vector between 2 points and normalise
+	glm::vec3 targetDir = a_v3Start - a_v3End;
+	targetDir = glm::length(targetDir) > 0 ? glm::normalize(targetDir) : targetDir;
+	return targetDir;
+}
+
+/// <summary>
+/// Keep the state of every boid at the start of the frame for the neighbour lists to read, and
+/// rebuild the lists if a boid may have moved in to the neighbour radius of a boid that is not on it's list
+/// </summary>
+/// <param name="a_fSkin">Extra distance past the neighbour radius that boids are added to the lists</param>
+void BoidSystem::UpdateNeighbourLists(const float a_fSkin)
+{
+	PROFILE_SCOPE("Update/Step/Boids/Neighbour Lists");
+	TRACE_SCOPE("Neighbour Lists", "boids");
+
+	//Boids update their own state during the step, so neighbours are read from a copy
+	m_vV3FramePositions.assign(m_vV3Positions.begin(), m_vV3Positions.end());
+	m_vV3FrameVelocities.assign(m_vV3Velocities.begin(), m_vV3Velocities.end());
+	++m_uNeighbourListStepCount;
+
+	//Rebuild if the boids or the radius have changed
+	const float fListRadius = m_fNeighbourRadius + std::max(a_fSkin, 0.0f);
+	bool bRebuild = m_bNeighbourListsDirty || fListRadius != m_fNeighbourListRadius ||
+		m_vvuNeighbourLists.size() != GetBoidCount() || m_vV3NeighbourListPositions.size() != GetBoidCount();
+
+	//Otherwise only rebuild once a boid has moved more than half of the skin, before then two boids
+	//can't have closed the gap between the radius and the list radius
+	const float fHalfSkin = (fListRadius - m_fNeighbourRadius) * 0.5f;
+	const float fHalfSkinSqr = fHalfSkin * fHalfSkin;
+	for (unsigned int i = 0; i < GetBoidCount() && !bRebuild; ++i)
+	{
+		const glm::vec3 v3Moved = m_vV3Positions[i] - m_vV3NeighbourListPositions[i];
+		bRebuild = glm::dot(v3Moved, v3Moved) > fHalfSkinSqr;
+	}
+
+	if (bRebuild)
+	{
+		RebuildNeighbourLists(fListRadius);
+	}
+}
+
+/// <summary>
+/// Rebuild the neighbour list of every boid, using the spatial grid to find all
+/// of the boids that are within the list radius of each other
+/// </summary>
+/// <param name="a_fListRadius">Radius to add boids to each list, the neighbour radius plus the skin</param>
+void BoidSystem::RebuildNeighbourLists(const float a_fListRadius)
+{
+	PROFILE_SCOPE("Update/Step/Boids/Neighbour Lists/Rebuild");
+	TRACE_SCOPE("Rebuild Neighbour Lists", "boids");
+
+	//Cells are the size of the list radius, so the cells around a boid cover everything on it's list
+	SpatialHashGrid* pSpatialGrid = SpatialHashGrid::GetInstance();
+	pSpatialGrid->Rebuild(m_vV3Positions, m_vV3Velocities, a_fListRadius);
+
+	//Each boid only writes it's own list, the lists keep their memory between rebuilds
+	m_vvuNeighbourLists.resize(GetBoidCount());
+	const float fListRadiusSqr = a_fListRadius * a_fListRadius;
+	JobSystem::GetInstance()->ParallelFor(GetBoidCount(), sc_uBoidsPerJob, [this, pSpatialGrid, fListRadiusSqr](const unsigned int a_uStart, const unsigned int a_uEnd, const unsigned int a_uThreadIndex)
+	{
+		std::vector<const SpatialGridEntry*>& vpNeighbourCandidates = m_vvpNeighbourCandidates[a_uThreadIndex];
+		for (unsigned int i = a_uStart; i < a_uEnd; ++i)
+		{
+			const glm::vec3 v3OwnerPos = m_vV3Positions[i];
+			std::vector<unsigned int>& vuNeighbourList = m_vvuNeighbourLists[i];
+			vuNeighbourList.clear();
+
+			pSpatialGrid->QueryNeighbours(v3OwnerPos, vpNeighbourCandidates);
+			for (unsigned int j = 0; j < vpNeighbourCandidates.size(); ++j)
+			{
+				const SpatialGridEntry* pCandidate = vpNeighbourCandidates[j];
+				const glm::vec3 v3Offset = pCandidate->m_v3Position - v3OwnerPos;
+				if (pCandidate->m_uBoidIndex != i && glm::dot(v3Offset, v3Offset) < fListRadiusSqr)
+				{
+					vuNeighbourList.push_back(pCandidate->m_uBoidIndex);
+				}
+			}
+		}
+	});
+
+	m_vV3NeighbourListPositions.assign(m_vV3Positions.begin(), m_vV3Positions.end());
+	m_fNeighbourListRadius = a_fListRadius;
+	m_bNeighbourListsDirty = false;
+	++m_uNeighbourListRebuildCount;
+}
+
+/// <summary>
+/// Calculates all of the flocking forces
+/// Does not take in to account any weighting of values
+/// from the UI
+/// </summary>
+/// <param name="a_uBoidIndex">Index of the boid to calculate forces for</param>
+/// <param name="a_uThreadIndex">Index of the thread calculating the forces, used to pick the candidate list</param>
+/// <param name="a_v3SeparationForce">ByRef Separation Force to fill with value</param>
+/// <param name="a_v3AlignmentForce">ByRef Alignment Force to fill with value</param>
+/// <param name="a_v3CohesionForce">ByRef Cohesion Force to fill with value</param>
+/// <returns>Total (unweighted) force</returns>
+glm::vec3 BoidSystem::CalculateFlockingForces(const unsigned int a_uBoidIndex, const unsigned int a_uThreadIndex, glm::vec3& a_v3SeparationForce, glm::vec3& a_v3AlignmentForce, glm::vec3& a_v3CohesionForce)
+{
+	//Store the number of neighbours we are interacted with - so we can avg. forces
+	int iNeighbourCount = 0;
+
+	//Get our position it is the only part of our state we use
+	const glm::vec3 v3OwnerPos = m_vV3Positions[a_uBoidIndex];
+
+	//Gather the state of every boid that could be our neighbour at the start of the frame, so every boid
+	//sees the same state of the flock, in to arrays that the kernel can test 8 at a time
+	FlockingCandidates& xCandidates = m_vxFlockingCandidates[a_uThreadIndex];
+	if (m_bUseNeighbourLists)
+	{
+		xCandidates.Clear();
+
+		//Every boid on our neighbour list could be within our radius
+		const std::vector<unsigned int>& vuNeighbourList = m_vvuNeighbourLists[a_uBoidIndex];
+		for (unsigned int i = 0; i < vuNeighbourList.size(); ++i)
+		{
+			const unsigned int uNeighbourIndex = vuNeighbourList[i];
+			xCandidates.Add(m_vV3FramePositions[uNeighbourIndex], m_vV3FrameVelocities[uNeighbourIndex]);
+		}
+	}
+	else
+	{
+		//Get all of the other boids in the cells around us from the spatial grid
+		SpatialHashGrid::GetInstance()->QueryNeighbours(v3OwnerPos, a_uBoidIndex, xCandidates);
+	}
+
+	/*Calculate Separation, Alignment, Cohesion forces from the candidates within our radius*/
+	xCandidates.Pad();
+	const FlockingSums xSums = FlockingKernel::Accumulate(v3OwnerPos, m_fNeighbourRadius, xCandidates);
+	a_v3SeparationForce += xSums.v3Separation; //Replusion force
+	a_v3AlignmentForce += xSums.v3Alignment; //Align our velocity to others
+	a_v3CohesionForce += xSums.v3Cohesion; //Bring us closer to other boids
+	iNeighbourCount = xSums.iNeighbourCount;
+
+	//Our forces should be an average all of the influences we have so we need to
+	//divide the current value by the number of influences we had
+	if (iNeighbourCount > 0)
+	{
+		a_v3SeparationForce /= iNeighbourCount;
+		a_v3AlignmentForce /= iNeighbourCount;
+
+
+		a_v3SeparationForce = glm::length(a_v3SeparationForce) != 0 ? glm::normalize(a_v3SeparationForce) : a_v3SeparationForce;
+		a_v3AlignmentForce = glm::length(a_v3AlignmentForce) != 0 ? glm::normalize(a_v3AlignmentForce) : a_v3AlignmentForce;
+
+		if (glm::length(a_v3CohesionForce))
+		{
+			a_v3CohesionForce /= iNeighbourCount;
+			a_v3CohesionForce = glm::normalize(a_v3CohesionForce - v3OwnerPos);
+		}
+	}
+
+	//Return the final total force
+	return a_v3SeparationForce + a_v3AlignmentForce + a_v3CohesionForce;
+}
+
+/// <summary>
+/// Apply Flocking weights (that we get from the debug UI) to the given force values
+/// </summary>
+/// <param name="a_pUIValues">UI Values to get weights from</param>
+/// <param name="a_v3SeparationForce">ByRef Separation Force to modify</param>
+/// <param name="a_v3AlignmentForce">ByRef Alignment Force to modify</param>
+/// <param name="a_v3CohesionForce">ByRef Cohesion Force to modify</param>
+void BoidSystem::ApplyFlockingWeights(const UIInputValues* a_pUIValues, glm::vec3& a_v3SeparationForce, glm::vec3& a_v3AlignmentForce, glm::vec3& a_v3CohesionForce) const
+{
+	//Apply the UI weights to the forces
+	a_v3SeparationForce *= a_pUIValues->fInputSeparationForce.value;
+	a_v3AlignmentForce *= a_pUIValues->fInputAlignmentForce.value;
+	a_v3CohesionForce *= a_pUIValues->fInputCohesionForce.value;
+}
+
+/// <summary>
+/// Calculates both the containment and collision avoidance forces using a shared
+/// raycast between both. When using analytic containment the walls are not raycast and
+/// the containment force is worked out from the bounds size instead
+/// </summary>
+/// <returns>(Unweighted) The sum of the containent and collision avoidance forces</returns>
+glm::vec3 BoidSystem::CalculateCollisionForces(const unsigned int a_uBoidIndex, glm::vec3& a_v3ContainmentForce, glm::vec3& a_v3CollisionAvoidForce) const
+{
+	//Mask of what our rays can hit, we do not need to hit the walls
+	//if we already know where they are
+	unsigned short uRayCategoryMask = static_cast<unsigned short>(COLLISION_CATEGORY::COLLISION_CATEGORY_ALL);
+	if (m_bAnalyticContainment)
+	{
+		a_v3ContainmentForce = CalculateBoundsContainmentForce(a_uBoidIndex);
+		uRayCategoryMask &= ~static_cast<unsigned short>(COLLISION_CATEGORY::COLLISION_CATEGORY_CONTAINER);
+	}
+
+	//Check we have a raycast component
+	Entity* pOwner = m_vpBrains[a_uBoidIndex]->GetOwnerEntity();
+	RaycastComponent* pRayCaster = pOwner ? pOwner->GetComponent<RaycastComponent*>() : nullptr;
+	if (pRayCaster == nullptr)
+	{
+		return a_v3CollisionAvoidForce + a_v3ContainmentForce;
+	}
+
+	/*
+	 * Do all of the raycats out and store their results then
+	 * process pass the reults to the contain/avoid function
+	 * so that they can check for indiviual types of collision
+	 * (i.e containters for containment and obstacles for avoidance)
+	 */
+	glm::vec3 aV3RayEndPoints[sc_uCollisionRayCount];
+	const unsigned int uRayCount = GetCollisionRays(a_uBoidIndex, aV3RayEndPoints);
+
+	//Hits are gathered in to a buffer on the stack, so that no memory is allocated
+	//for rays or hits however many boids we are updating
+	RayCastHitsInfo rayHits;
+	pRayCaster->MutiRayCast(m_vV3Positions[a_uBoidIndex], aV3RayEndPoints, uRayCount, rayHits, uRayCategoryMask);
+
+	//Get forces from functions
+	if (!m_bAnalyticContainment)
+	{
+		a_v3ContainmentForce = CalculateContainmentForce(rayHits);
+	}
+	a_v3CollisionAvoidForce = CalculateAvoidanceForce(rayHits);
+
+	return a_v3CollisionAvoidForce + a_v3ContainmentForce;
+}
+
+/// <summary>
+/// Calulates the amount of force needed to keep the boid
+/// within the containment volume
+/// </summary>
+/// <returns>(Unweighted) force to turn away from hitting a container</returns>
+glm::vec3 BoidSystem::CalculateContainmentForce(const RayCastHitsInfo& a_rayCastHits) const
+{
+	//Store our containment force - init to 0 so we can return this var if we don't hit
+	glm::vec3 v3ContainmentForce(0.0f, 0.0f, 0.0f);
+
+	//Infomation about what we hit
+	const RayCastHit* containerHit = nullptr;
+	float closestHitDist = 0.f; //Store the closest collision distance with the wall
+	bool bHeadingForCollision = false;
+
+	//Check our raycast hits if they have hit a containter then check it is the closest collision
+	for (unsigned int i = 0; i < a_rayCastHits.GetHitCount(); ++i)
+	{
+		const RayCastHit* currentHit = &a_rayCastHits.GetHit(i);
+		if (currentHit->m_pHitEntity->GetEntityType() == ENTITY_TYPE::ENTITY_TYPE_CONTAINER)
+		{
+			//Get the closest collision so we don't end up getting
+			//the normal of the otherside of the containing wall
+			const float hitDist = currentHit->m_fHitFraction;
+			if (hitDist > closestHitDist)
+			{
+				containerHit = currentHit;
+				bHeadingForCollision = true;
+				closestHitDist = hitDist;
+			}
+		}
+	}
+
+	//If we have hit a container then calculate our force otherwise we will just return 0
+	if (bHeadingForCollision)
+	{
+		//Get the normal and return our force in that direction so we turn away from the object,
+		//mutiply it by the distance to the wall, so our force gets more agressive the closer we get
+		//Invert the m_fHitFraction because 1 means it is a the very end of the ray, we want the opposite multiplication
+		v3ContainmentForce = containerHit->m_v3HitNormal;
+		v3ContainmentForce = glm::length(v3ContainmentForce) != 0 ? glm::normalize(v3ContainmentForce) : v3ContainmentForce;
+	}
+
+	return v3ContainmentForce;
+}
+
+/// <summary>
+/// Calulates the amount of force needed to keep the boid within the
+/// world bounds, using the boid's position relative to the walls instead of raycasting them.
+/// Walls are felt from the same distance as the collision rays reach (the neighbour radius)
+/// </summary>
+/// <param name="a_uBoidIndex">Index of the boid to contain</param>
+/// <returns>(Unweighted) force to turn away from the walls</returns>
+glm::vec3 BoidSystem::CalculateBoundsContainmentForce(const unsigned int a_uBoidIndex) const
+{
+	const glm::vec3& v3Position = m_vV3Positions[a_uBoidIndex];
+	const glm::vec3& v3Velocity = m_vV3Velocities[a_uBoidIndex];
+
+	glm::vec3 v3ContainmentForce(0.0f, 0.0f, 0.0f);
+
+	//Check the nearest wall on each axis, the walls are axis aligned so the
+	//normal of each wall is just the inverse of that axis
+	for (int iAxis = 0; iAxis < 3; ++iAxis)
+	{
+		const float fWallSide = v3Position[iAxis] >= 0.f ? 1.f : -1.f;
+		const float fWallDistance = m_v3ContainmentExtent[iAxis] - (v3Position[iAxis] * fWallSide);
+
+		//Ignore walls that are out of range, or that we are already moving away
+		//from (unless we have ended up outside of the bounds)
+		if (fWallDistance > m_fNeighbourRadius)
+		{
+			continue;
+		}
+		if (fWallDistance > 0.f && v3Velocity[iAxis] * fWallSide < 0.f)
+		{
+			continue;
+		}
+
+		//Push away from the wall harder the closer we are to it
+		const float fWallCloseness = 1.f - (glm::max(fWallDistance, 0.f) / m_fNeighbourRadius);
+		v3ContainmentForce[iAxis] = -fWallSide * fWallCloseness;
+	}
+
+	//Normalise so the force is the same strength as the raycast containment force
+	return glm::length(v3ContainmentForce) != 0 ? glm::normalize(v3ContainmentForce) : v3ContainmentForce;
+}
+
+/// <summary>
+/// Calculate the force needed to avoid any collision with obstacles
+/// </summary>
+/// <returns>(Unweighted) Force to avoid any collision</returns>
+glm::vec3 BoidSystem::CalculateAvoidanceForce(const RayCastHitsInfo& a_rayCastHits) const
+{
+	glm::vec3 v3AvoidForce(0.f);
+
+	//Infomation about what we hit
+	const RayCastHit* containerHit = nullptr;
+	float closestHitDist = 0.f; //Store the closest collision distance with the wall
+
+	//Check our raycast hits if they have hit a containter then check it is the closest collision
+	for (unsigned int i = 0; i < a_rayCastHits.GetHitCount(); ++i)
+	{
+		const RayCastHit* currentHit = &a_rayCastHits.GetHit(i);
+		const ENTITY_TYPE hitType = currentHit->m_pHitEntity->GetEntityType();
+		if (hitType == ENTITY_TYPE::ENTITY_TYPE_OBSTACLE || hitType == ENTITY_TYPE::ENTITY_TYPE_BOID)
+		{
+			//Get the closest collision so we don't end up getting
+			//the normal of the otherside of the obstacle
+			const float hitDist = currentHit->m_fHitFraction;
+			if (hitDist > closestHitDist)
+			{
+				containerHit = currentHit;
+				closestHitDist = hitDist;
+			}
+		}
+	}
+
+	//If we have hit a container then calculate our force otherwise we will just return 0
+	if (containerHit != nullptr)
+	{
+		//Get the normal and return our force in that direction so we turn away from the object,
+		//mutiply it by the distance to the wall, so our force gets more agressive the closer we get
+		//Invert the m_fHitFraction because 1 means it is a the very end of the ray, we want the opposite multiplication
+		v3AvoidForce = containerHit->m_v3HitNormal * (1 - containerHit->m_fHitFraction);
+		v3AvoidForce = glm::length(v3AvoidForce) != 0 ? glm::normalize(v3AvoidForce) : v3AvoidForce;
+	}
+
+
+	return v3AvoidForce;
+}
+
+/// <summary>
+/// Generates the rays to use when checking for collisions
+/// </summary>
+/// <param name="a_uBoidIndex">Index of the boid to generate rays for</param>
+/// <param name="a_aV3RayEndPoints">Array to fill with the end point of each ray, all rays start at the boid's position</param>
+/// <returns>Number of rays that were generated</returns>
+unsigned int BoidSystem::GetCollisionRays(const unsigned int a_uBoidIndex, glm::vec3 (&a_aV3RayEndPoints)[sc_uCollisionRayCount]) const
+{
+	//Null Check and get transform, we use it for our right and up directions
+	Entity* pOwner = m_vpBrains[a_uBoidIndex]->GetOwnerEntity();
+	if (!pOwner)
+	{
+		return 0;
+	}
+	TransformComponent* pTransform = pOwner->GetComponent<TransformComponent*>();
+	if (!pTransform)
+	{
+		return 0;
+	}
+
+	//Get our current position, so we can make our rays relative
+	const glm::vec3 v3CurrentPos = m_vV3Positions[a_uBoidIndex];
+
+	//Get all of the directions that we want to cast in
+	const glm::vec3 v3Forward = m_vV3Forwards[a_uBoidIndex];
+	const glm::vec3 v3Right = pTransform->GetEntityMatrixRow(MATRIX_ROW::RIGHT_VECTOR);
+	const glm::vec3 v3Up = pTransform->GetEntityMatrixRow(MATRIX_ROW::UP_VECTOR);
+	glm::vec3 vV3PositiveDirections[3] = { v3Forward,v3Right,v3Up };
+
+	//Loop through the directions and mutiply half of them by -1 so we have the inverse's
+	for (unsigned int i = 0; i < sc_uCollisionRayCount; ++i)
+	{
+		//Divide the current direction by 2 so that we grab
+		//the direction twice and on 1 of those times * it by -1 so
+		//we get the inverse
+		const unsigned int uCurrentDirectionIndex = i / 2;
+
+		glm::vec3 v3CurrentRayDir = vV3PositiveDirections[uCurrentDirectionIndex];
+
+		//If the index is odd then divide by 2 so we get the inerse
+		if (i % 2 != 0)
+		{
+			v3CurrentRayDir *= -1;
+		}
+
+		//End pos is direction * distance, in this case our neighbourbood radius
+		a_aV3RayEndPoints[i] = v3CurrentPos + (v3CurrentRayDir * m_fNeighbourRadius);
+	}
+
+	return sc_uCollisionRayCount;
+}
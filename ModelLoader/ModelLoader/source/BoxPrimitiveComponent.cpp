@@ -10,6 +10,9 @@
 //Typedefs
 typedef PrimitiveComponent PARENT;
 
+//Allocate from a pool
+DEFINE_POOLED_ALLOCATION(BoxPrimitiveComponent)
+
 /// <summary>
 /// Create a box primitive
 /// </summary>
@@ -9,6 +9,9 @@
 //Typedefs
 typedef Component PARENT;
 
+//Allocate from a pool
+DEFINE_POOLED_ALLOCATION(CameraComponent)
+
 //Declare Camera Statics - default values
 const glm::vec3 CameraComponent::sc_v3DefaultPosition = glm::vec3(0.f);
 const glm::vec3 CameraComponent::sc_v3DefaultUp = glm::vec3(0.0f, 1.0f, 0.0f);
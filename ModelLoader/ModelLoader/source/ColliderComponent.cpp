@@ -12,15 +12,21 @@
 //Typedefs
 typedef Component PARENT;
 
+//Allocate from a pool
+DEFINE_POOLED_ALLOCATION(ColliderComponent)
+
 /// <summary>
 /// Create a collider component within a given collision world
 /// </summary>
 /// <param name="a_pOwner">Owner Entity</param>
 /// <param name="a_pCollisionWorld">Collision World this collider exists in</param>
-ColliderComponent::ColliderComponent(Entity* a_pOwner, rp3d::CollisionWorld* a_pCollisionWorld) :
+/// <param name="a_pCollisionBody">Existing body in the collision world to use, that has no shapes.
+/// A new body is created if this is nullptr</param>
+ColliderComponent::ColliderComponent(Entity* a_pOwner, rp3d::CollisionWorld* a_pCollisionWorld, rp3d::CollisionBody* a_pCollisionBody) :
 	PARENT(a_pOwner),
 	m_pCollisionWorld(a_pCollisionWorld),
-	m_pCollisionBody(nullptr)
+	m_pCollisionBody(nullptr),
+	m_eCollisionCategory(COLLISION_CATEGORY::COLLISION_CATEGORY_DEFAULT)
 {
 	/*
 	* Create the collision body, used by rp3d at the transform of
@@ -32,12 +38,21 @@ ColliderComponent::ColliderComponent(Entity* a_pOwner, rp3d::CollisionWorld* a_p
 	if (m_pCollisionWorld != nullptr) {
 		if (m_pOwnerEntity != nullptr) {
 			TransformComponent* pLocalTransform = m_pOwnerEntity->GetComponent<TransformComponent*>();
-			if (pLocalTransform) {
+			if (a_pCollisionBody) {
+				//Reuse the body we have been given, moving it to our transform
+				m_pCollisionBody = a_pCollisionBody;
+				m_pCollisionBody->setIsActive(true);
+				m_pCollisionBody->setTransform(pLocalTransform ? rp3d::Transform(pLocalTransform) : rp3d::Transform::identity());
+			}
+			else if (pLocalTransform) {
 				m_pCollisionBody = m_pCollisionWorld->createCollisionBody(pLocalTransform);
 			}else
 			{
 				m_pCollisionBody = m_pCollisionWorld->createCollisionBody(rp3d::Transform::identity());
 			}
+
+			//Store our owner in the body so we can go straight from a hit body to it's entity
+			m_pCollisionBody->setUserData(m_pOwnerEntity);
 		}
 	}
 }
@@ -55,7 +70,10 @@ ColliderComponent::~ColliderComponent()
 	}
 	m_apCollisionShapes.clear();
 	
-	m_pCollisionWorld->destroyCollisionBody(m_pCollisionBody);
+	//Our body may have been released to be used by another collider
+	if (m_pCollisionWorld && m_pCollisionBody) {
+		m_pCollisionWorld->destroyCollisionBody(m_pCollisionBody);
+	}
 
 	//Proxy and Collision Shapes are removed by React Physics, we do not need to delete them here
 	/* It is not necessary to manually remove all the collision shapes from a body at the end of your application.
@@ -65,6 +83,48 @@ ColliderComponent::~ColliderComponent()
 	 */
 }
 
+/// <summary>
+/// Take the collision body away from this collider so that it can be given to a new collider,
+/// destroying a body in rp3d has to search every body in the world so it is quicker to reuse them.
+/// The body has all of it's shapes removed and is made inactive so raycasts do not hit it
+/// </summary>
+/// <returns>Collision Body, nullptr if we do not have one</returns>
+rp3d::CollisionBody* ColliderComponent::ReleaseCollisionBody()
+{
+	rp3d::CollisionBody* pCollisionBody = m_pCollisionBody;
+	if (pCollisionBody) {
+		for (unsigned int i = 0; i < m_apProxyShapes.size(); ++i)
+		{
+			pCollisionBody->removeCollisionShape(m_apProxyShapes[i]);
+		}
+		pCollisionBody->setIsActive(false);
+		pCollisionBody->setUserData(nullptr);
+	}
+
+	//Proxy shapes are destroyed when they are removed, the shapes themselves are still ours to delete
+	m_apProxyShapes.clear();
+	m_pCollisionBody = nullptr;
+	return pCollisionBody;
+}
+
+/// <summary>
+/// Take the collision shapes away from this collider so that they can be given to a new collider,
+/// rather than deleting them and making them again. Shapes can only be released once they have been
+/// removed from our body by ReleaseCollisionBody, and are no longer deleted by this collider
+/// </summary>
+/// <param name="a_vpCollisionShapes">ByRef List to add our shapes to</param>
+void ColliderComponent::ReleaseCollisionShapes(std::vector<rp3d::CollisionShape*>& a_vpCollisionShapes)
+{
+	//Shapes are still used by the proxies on our body
+	if (!m_apProxyShapes.empty())
+	{
+		return;
+	}
+
+	a_vpCollisionShapes.insert(a_vpCollisionShapes.end(), m_apCollisionShapes.begin(), m_apCollisionShapes.end());
+	m_apCollisionShapes.clear();
+}
+
 /// <summary>
 /// Update the transform of the collider
 /// </summary>
@@ -145,15 +205,7 @@ void ColliderComponent::AddBoxCollider(const glm::vec3 a_v3BoxSize, const glm::v
 	//Create a rp3d vector to store the extends (which are half the box size)
 	//then create the box shape itself
 	const rp3d::Vector3 v3BoxExtends(a_v3BoxSize);
-	rp3d::BoxShape* pBoxShape = new rp3d::BoxShape(v3BoxExtends);
-
-	//Create a proxy shape to link the transform with the box
-	const rp3d::Transform boxTransform(a_v3Offset, rp3d::Quaternion::identity());
-	rp3d::ProxyShape* pBoxProxyState = m_pCollisionBody->addCollisionShape(pBoxShape, boxTransform);
-	
-	//Add the box and proxy shape to our list
-	m_apCollisionShapes.push_back(pBoxShape);
-	m_apProxyShapes.push_back(pBoxProxyState);
+	AddCollisionShape(new rp3d::BoxShape(v3BoxExtends), a_v3Offset);
 }
 
 /// <summary>
@@ -169,15 +221,46 @@ void ColliderComponent::AddSphereCollider(const float a_fSphereSize, const glm::
 	}
 	
 	//Create the sphere shape
-	rp3d::SphereShape* pSphereShape = new rp3d::SphereShape(a_fSphereSize);
+	AddCollisionShape(new rp3d::SphereShape(a_fSphereSize), a_v3Offset);
+}
 
-	//Create a proxy shape to link the transform with the box
-	const rp3d::Transform sphereTransform(a_v3Offset, rp3d::Quaternion::identity());
-	rp3d::ProxyShape* pSphereProxyShape = m_pCollisionBody->addCollisionShape(pSphereShape, sphereTransform);
+/// <summary>
+/// Add a collision shape that has already been made to the collision component,
+/// the shape belongs to this collider and is deleted with it unless it is released
+/// </summary>
+/// <param name="a_pCollisionShape">Shape to add</param>
+/// <param name="a_v3Offset">Local Offset from the center of the object to put the collider</param>
+void ColliderComponent::AddCollisionShape(rp3d::CollisionShape* a_pCollisionShape, const glm::vec3 a_v3Offset)
+{
+	if (!m_pCollisionBody || !m_pCollisionWorld || !a_pCollisionShape)
+	{
+		return;
+	}
 
-	//Add the sphere and proxy shape to our list
-	m_apCollisionShapes.push_back(pSphereShape);
-	m_apProxyShapes.push_back(pSphereProxyShape);
+	//Create a proxy shape to link the transform with the shape
+	const rp3d::Transform shapeTransform(a_v3Offset, rp3d::Quaternion::identity());
+	rp3d::ProxyShape* pProxyShape = m_pCollisionBody->addCollisionShape(a_pCollisionShape, shapeTransform);
+	pProxyShape->setCollisionCategoryBits(static_cast<unsigned short>(m_eCollisionCategory));
+
+	//Add the shape and proxy shape to our list
+	m_apCollisionShapes.push_back(a_pCollisionShape);
+	m_apProxyShapes.push_back(pProxyShape);
+}
+
+/// <summary>
+/// Set the category that this collider is in, raycasts and collision
+/// checks can use the category to filter what they hit
+/// </summary>
+/// <param name="a_eCategory">Category to put all of the collider shapes in</param>
+void ColliderComponent::SetCollisionCategory(const COLLISION_CATEGORY a_eCategory)
+{
+	m_eCollisionCategory = a_eCategory;
+
+	//Update all of the shapes we already have, any added later will use the new category
+	for (unsigned int i = 0; i < m_apProxyShapes.size(); ++i)
+	{
+		m_apProxyShapes[i]->setCollisionCategoryBits(static_cast<unsigned short>(m_eCollisionCategory));
+	}
 }
 
 /// <summary>
@@ -188,15 +271,14 @@ void ColliderComponent::AddSphereCollider(const float a_fSphereSize, const glm::
 /// <returns>If we are colliding with any other object in the scene</returns>
 bool ColliderComponent::IsColliding(const bool a_bUseAABB) const
 {
-	//Create a map to itterate through all of our entities
-	const std::map<const unsigned int, Entity*>& xEntityMap = Entity::GetEntityMap();
-	std::map<const unsigned int, Entity*>::const_iterator xIter;
+	//Get the list of all of our entities to itterate through
+	const std::vector<Entity*>& vpEntities = Entity::GetEntityRegistry().GetEntities();
 
 	//Loop through all of the entites that we have
-	for (xIter = xEntityMap.begin(); xIter != xEntityMap.end(); ++xIter)
+	for (unsigned int i = 0; i < vpEntities.size(); ++i)
 	{
 		//Get the current entity that are on and check that it is not nullptr
-		const Entity* pTarget = xIter->second;
+		const Entity* pTarget = vpEntities[i];
 		if (!pTarget) {
 			continue;
 		}
@@ -264,15 +346,14 @@ std::vector<CollisionInfo*> ColliderComponent::GetCollisionInfo() const
 	//Store the current collision info in a vector
 	std::vector<CollisionInfo*> vObjectCollisions;
 	
-	//Create a map to itterate through all of our entities
-	const std::map<const unsigned int, Entity*>& xEntityMap = Entity::GetEntityMap();
-	std::map<const unsigned int, Entity*>::const_iterator xIter;
+	//Get the list of all of our entities to itterate through
+	const std::vector<Entity*>& vpEntities = Entity::GetEntityRegistry().GetEntities();
 
 	//Loop through all of the entites that we have
-	for (xIter = xEntityMap.begin(); xIter != xEntityMap.end(); ++xIter)
+	for (unsigned int i = 0; i < vpEntities.size(); ++i)
 	{
 		//Get the current entity that are on and check that it is not nullptr
-		const Entity* pTarget = xIter->second;
+		const Entity* pTarget = vpEntities[i];
 		if (!pTarget) {
 			continue;
 		}
@@ -360,48 +441,17 @@ bool ColliderComponent::IsCollisionCheckValid(ColliderComponent* a_pOtherCollide
 /// </summary>
 /// <param name="a_collisionBody">Collision Body to get entity from</param>
 /// <returns>Entity attached to collision body</returns>
-Entity* ColliderComponent::GetEntityFromCollisionBody(rp3d::CollisionBody* a_collisionBody)
+Entity* ColliderComponent::GetEntityFromCollisionBody(const rp3d::CollisionBody* a_collisionBody)
 {
-	//Create a map to itterate through all of our entities
-	const std::map<const unsigned int, Entity*>& xEntityMap = Entity::GetEntityMap();
-	std::map<const unsigned int, Entity*>::const_iterator xIter;
-
 	//Null check the collision body
 	if(a_collisionBody == nullptr)
 	{
 		return nullptr;
 	}
-	
-	//Loop through all of the entites that we have
-	for (xIter = xEntityMap.begin(); xIter != xEntityMap.end(); ++xIter)
-	{
-		//Get the current entity that are on and check that it is not nullptr
-		Entity* pTarget = xIter->second;
-		if (!pTarget) {
-			continue;
-		}
-
-		//Get the collider component
-		ColliderComponent* pTargetCollider = pTarget->GetComponent<ColliderComponent*>();
-		if (pTargetCollider == nullptr) {
-			continue;
-		}
-		if(pTargetCollider->m_pCollisionBody == nullptr)
-		{
-			continue;
-		}
-
-		//If this object's collider component's physics body matches the one we
-		//are looking for then return it
-		if (a_collisionBody == pTargetCollider->m_pCollisionBody)
-		{
-			return pTarget;
-		}
-
-	}
 
-	//There is no entity attached to this collision body
-	return nullptr;
+	//Every body is created by a collider component which stores it's owner as the
+	//user data, bodies without an owner return nullptr
+	return static_cast<Entity*>(a_collisionBody->getUserData());
 }
 
 /// <summary>
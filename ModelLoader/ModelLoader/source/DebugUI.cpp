@@ -6,22 +6,46 @@
 
 //c++ Includes
 #include <iostream>
+#include <vector>
 
 //Project Includes
 #include "BoidSpawner.h"
+#include "BoidSystem.h"
 #include "Scene.h"
 #include "Entity.h"
+#include "JobSystem.h"
+#include "InstancedRenderer.h"
+#include "AssetLoader.h"
+#include "Profiler.h"
+#include "TraceRecorder.h"
+#include "SimulationSnapshot.h"
+#include "TrajectoryRecorder.h"
+#include "TrajectoryPlayer.h"
+
+/// <summary>
+/// Create the debug UI
+/// </summary>
+DebugUI::DebugUI() : Singleton()
+{
+	//Start the thread count at however many threads the job system is using
+	m_uiValues.iThreadCount.value = static_cast<int>(JobSystem::GetInstance()->GetThreadCount());
+}
 
 /// <summary>
 /// Updates the UI by passing ImGUI elements to draw
 /// </summary>
 void DebugUI::Update() {
 
+	PROFILE_SCOPE("Update/Debug UI");
+
 	//Draw general UI
 	DrawDebugUI();
 	
 	//Draw Inspector Window
 	DrawInspector();
+
+	//Draw Profiler Window
+	DrawProfiler();
 }
 
 /// <summary>
@@ -63,6 +87,31 @@ void DebugUI::DrawDebugUI()
 
 		ImGui::Spacing();
 
+		//Fixed simulation tick, the simulation runs at this rate whatever the frame rate is
+		ImGui::Text("Simulation Steps Last Frame: %i", Scene::GetInstance()->GetStepsLastFrame());
+		ImGui::SliderFloat("Simulation Time Step", &m_uiValues.fFixedTimeStep.value, m_uiValues.fFixedTimeStep.min, m_uiValues.fFixedTimeStep.max, "%.4f s");
+		ImGui::SliderInt("Max Steps Per Frame", &m_uiValues.iMaxSubSteps.value, m_uiValues.iMaxSubSteps.min, m_uiValues.iMaxSubSteps.max);
+		ImGui::Checkbox("Interpolate Transforms", &m_uiValues.bInterpolateTransforms);
+
+		ImGui::Spacing();
+
+		//Rendering, the draw call count is from the last frame as we have not rendered this one yet
+		ImGui::Text("Model Draw Calls: %u", InstancedRenderer::GetInstance()->GetDrawCallCount());
+		ImGui::Checkbox("Instanced Rendering", &m_uiValues.bInstancedRendering);
+		ImGui::Text("Models Loading: %u", AssetLoader::GetInstance()->GetPendingLoadCount());
+
+		ImGui::Spacing();
+
+		//Threads used to update the boids
+		ImGui::Text("Job System Threads: %u (%u hardware threads)", JobSystem::GetInstance()->GetThreadCount(), JobSystem::GetHardwareThreadCount());
+		if (ImGui::SliderInt("Thread Count", &m_uiValues.iThreadCount.value, m_uiValues.iThreadCount.min, m_uiValues.iThreadCount.max))
+		{
+			//Restart the job system with the new number of threads
+			JobSystem::GetInstance()->SetThreadCount(static_cast<unsigned int>(m_uiValues.iThreadCount.value));
+		}
+
+		ImGui::Spacing();
+
 		//Tickbox to draw colliders
 		ImGui::Checkbox("Draw Collider Bounds", &m_uiValues.bShowColliders);
 
@@ -75,6 +124,65 @@ void DebugUI::DrawDebugUI()
 			Scene::GetInstance()->DeInitialize(false);
 			Scene::GetInstance()->Initialize(false);
 		}
+
+		//Buttons to save the simulation and carry on from it later
+		if (ImGui::Button("Save Snapshot"))
+		{
+			SimulationSnapshot::Save(m_szSnapshotPath);
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Load Snapshot"))
+		{
+			SimulationSnapshot::Load(m_szSnapshotPath);
+		}
+
+		//Button to record every step of the boids to a file
+		TrajectoryRecorder* pTrajectoryRecorder = TrajectoryRecorder::GetInstance();
+		if (!pTrajectoryRecorder->IsRecording())
+		{
+			if (ImGui::Button("Record Trajectory"))
+			{
+				pTrajectoryRecorder->StartRecording(m_szTrajectoryPath, m_uiValues.fFixedTimeStep.value);
+			}
+		}
+		else
+		{
+			if (ImGui::Button("Stop Recording Trajectory"))
+			{
+				pTrajectoryRecorder->StopRecording();
+			}
+			ImGui::SameLine();
+			ImGui::Text("%u frames", pTrajectoryRecorder->GetFrameCount());
+		}
+
+		//Replay a recorded trajectory instead of simulating, the scene is restarted once we stop
+		//as the boids no longer match the simulation
+		TrajectoryPlayer* pTrajectoryPlayer = TrajectoryPlayer::GetInstance();
+		if (!pTrajectoryPlayer->IsOpen())
+		{
+			if (ImGui::Button("Replay Trajectory"))
+			{
+				pTrajectoryPlayer->Open(m_szTrajectoryPath);
+			}
+		}
+		else
+		{
+			if (ImGui::Button(pTrajectoryPlayer->IsPlaying() ? "Pause" : "Play"))
+			{
+				pTrajectoryPlayer->SetPlaying(!pTrajectoryPlayer->IsPlaying());
+			}
+			ImGui::SameLine();
+			if (ImGui::Button("Stop Replay"))
+			{
+				Scene::GetInstance()->DeInitialize(false);
+				Scene::GetInstance()->Initialize(false);
+			}
+			int iFrame = static_cast<int>(pTrajectoryPlayer->GetCurrentFrame());
+			if (ImGui::SliderInt("Frame", &iFrame, 0, static_cast<int>(pTrajectoryPlayer->GetFrameCount()) - 1))
+			{
+				pTrajectoryPlayer->SeekFrame(static_cast<unsigned int>(iFrame));
+			}
+		}
 	}
 
 	if (ImGui::CollapsingHeader("Controls")) {
@@ -93,6 +201,18 @@ void DebugUI::DrawDebugUI()
 		//Nehbourhood Radius
 		ImGui::SliderFloat("Neighbourhood Radius", &m_uiValues.fInputNeighbourRadius.value, m_uiValues.fInputNeighbourRadius.min, m_uiValues.fInputNeighbourRadius.max);
 
+		//Verlet neighbour lists, a bigger skin means the lists are rebuilt less often but are longer
+		ImGui::Checkbox("Verlet Neighbour Lists", &m_uiValues.bNeighbourLists);
+		if (m_uiValues.bNeighbourLists) {
+			ImGui::SliderFloat("Neighbour List Skin", &m_uiValues.fNeighbourListSkin.value, m_uiValues.fNeighbourListSkin.min, m_uiValues.fNeighbourListSkin.max);
+
+			const BoidSystem* pBoidSystem = BoidSystem::GetInstance();
+			const unsigned int uRebuildCount = pBoidSystem->GetNeighbourListRebuildCount();
+			const unsigned int uStepCount = pBoidSystem->GetNeighbourListStepCount();
+			ImGui::Text("List Rebuilds: %u in %u steps (every %.1f steps)", uRebuildCount, uStepCount,
+				uRebuildCount > 0 ? static_cast<float>(uStepCount) / uRebuildCount : 0.0f);
+		}
+
 		ImGui::Spacing();
 
 		//Collision Avoidance Forces
@@ -126,6 +246,8 @@ void DebugUI::DrawDebugUI()
 		ImGui::Text("Adjust the world bounds size (Requires Scene Restart)");
 
 		ImGui::SliderInt("World Bounds Size", &m_uiValues.iInputWorldBounds.value, m_uiValues.iInputWorldBounds.min, m_uiValues.iInputWorldBounds.max);
+		//Containment mode, either work out the containment force from the bounds size or raycast the walls
+		ImGui::Checkbox("Analytic Containment", &m_uiValues.bAnalyticContainment);
 		//Boid Count
 		if (ImGui::SliderInt("Boid Count", &m_uiValues.iBoidCount.value, m_uiValues.iBoidCount.min, m_uiValues.iBoidCount.max))
 		{
@@ -157,7 +279,7 @@ void DebugUI::DrawInspector() const
 	ImGui::InputInt("Boid ID:", &iSelectedEntityID);
 
 	//Get entity info
-	Entity* pEntity = Entity::GetEntityMap().find(iSelectedEntityID)->second;
+	Entity* pEntity = iSelectedEntityID >= 0 ? Entity::GetEntityRegistry().GetInSlot(static_cast<unsigned int>(iSelectedEntityID)) : nullptr;
 	if (pEntity != nullptr) {
 
 		//Show Entity ID Type
@@ -193,3 +315,83 @@ void DebugUI::DrawInspector() const
 	
 	ImGui::End();
 }
+
+/// <summary>
+/// Draw the profiler window, shows how long each part of the frame takes
+/// as a tree of scopes with a bar for how much of the frame each scope takes.
+/// Also lets us record a trace of the next frames
+/// </summary>
+void DebugUI::DrawProfiler()
+{
+	//Setup Imgui window size and position, start collapsed so it does not cover the scene
+	ImGui::SetNextWindowPos(m_v2ProfilerPos, ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowSize(m_v2ProfilerSize, ImGuiCond_FirstUseEver);
+	ImGui::SetNextWindowCollapsed(true, ImGuiCond_FirstUseEver);
+
+	//Begin the drawing of the Window
+	if (!ImGui::Begin("Profiler")) {
+		ImGui::End();
+		return;
+	}
+
+	//Trace recording, traces can be opened in chrome://tracing or ui.perfetto.dev
+	TraceRecorder* pTraceRecorder = TraceRecorder::GetInstance();
+	if (pTraceRecorder->IsRecording()) {
+		ImGui::Text("Recording Trace: %u frames left", pTraceRecorder->GetFramesRemaining());
+	}
+	else {
+		ImGui::SliderInt("Trace Frames", &m_uiValues.iTraceFrames.value, m_uiValues.iTraceFrames.min, m_uiValues.iTraceFrames.max);
+		if (ImGui::Button("Record Trace")) {
+			pTraceRecorder->StartRecording(static_cast<unsigned int>(m_uiValues.iTraceFrames.value), m_szTracePath);
+		}
+	}
+	ImGui::Separator();
+
+#ifdef ENABLE_PROFILER
+	Profiler* pProfiler = Profiler::GetInstance();
+
+	ImGui::Text("Last %u frames (boid phases are summed over all threads)", pProfiler->GetHistoryFrameCount());
+	if (ImGui::Button("Dump to File")) {
+		pProfiler->WriteReport(m_szProfilerReportPath);
+	}
+	ImGui::SameLine();
+	if (ImGui::Button("Reset")) {
+		pProfiler->Reset();
+	}
+
+	std::vector<Profiler::ScopeStats> vStats;
+	pProfiler->GetStats(vStats);
+
+	//The frame is the time spent updating and rendering, the bars show how much of it each scope takes
+	double fFrameMs = 0.0;
+	for (const Profiler::ScopeStats& xStats : vStats)
+	{
+		if (xStats.szPath == "Update" || xStats.szPath == "Render") {
+			fFrameMs += xStats.fAvgMs;
+		}
+	}
+
+	ImGui::Columns(5, "ProfilerColumns");
+	ImGui::Text("Scope"); ImGui::NextColumn();
+	ImGui::Text("Min ms"); ImGui::NextColumn();
+	ImGui::Text("Avg ms"); ImGui::NextColumn();
+	ImGui::Text("P99 ms"); ImGui::NextColumn();
+	ImGui::Text("Frame"); ImGui::NextColumn();
+	ImGui::Separator();
+
+	for (const Profiler::ScopeStats& xStats : vStats)
+	{
+		ImGui::Text("%*s%s", static_cast<int>(xStats.uDepth * 2), "", xStats.szName.c_str()); ImGui::NextColumn();
+		ImGui::Text("%.3f", xStats.fMinMs); ImGui::NextColumn();
+		ImGui::Text("%.3f", xStats.fAvgMs); ImGui::NextColumn();
+		ImGui::Text("%.3f", xStats.fP99Ms); ImGui::NextColumn();
+		const float fFrameFraction = fFrameMs > 0.0 ? static_cast<float>(xStats.fAvgMs / fFrameMs) : 0.0f;
+		ImGui::ProgressBar(fFrameFraction, ImVec2(-1.0f, 0.0f), ""); ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+#else
+	ImGui::Text("Profiling is compiled out, use the Debug or Profile configuration to enable it");
+#endif
+
+	ImGui::End();
+}
@@ -1,22 +1,48 @@
 #include "Entity.h"
 
-//Typedefs
-typedef std::pair<const unsigned int, Entity*> EntityPair;
+//Project Includes
+#include "Profiler.h"
 
 //Initialize Statics
-unsigned int Entity::s_uNextEntityID = 0;
-std::map<const unsigned int, Entity*> Entity::s_xEntityMap;
+EntityRegistry Entity::s_xEntityRegistry;
+
+#ifdef ENABLE_PROFILER
+namespace
+{
+	/// <summary>
+	/// Get the profiler scope that updates of a type of component are timed with, components
+	/// are updated from the simulation step and the camera so they are timed in their own group
+	/// </summary>
+	unsigned int GetComponentUpdateScope(const Component* a_pComponent)
+	{
+		static unsigned int s_auScopeIds[static_cast<int>(COMPONENT_TYPE::COMPONENT_TYPE_COUNT)];
+		static bool s_abRegistered[static_cast<int>(COMPONENT_TYPE::COMPONENT_TYPE_COUNT)] = {};
+
+		const int iType = static_cast<int>(a_pComponent->GetComponentType());
+		if (!s_abRegistered[iType]) {
+			s_auScopeIds[iType] = Profiler::GetInstance()->RegisterScope(std::string("Components/") + a_pComponent->GetComponentName());
+			s_abRegistered[iType] = true;
+		}
+		return s_auScopeIds[iType];
+	}
+}
+#endif
+
+//Allocate from a pool
+DEFINE_POOLED_ALLOCATION(Entity)
 
 /// <summary>
 /// Create an entity
 /// </summary>
 Entity::Entity() :
-	m_eEntityType(ENTITY_TYPE::ENTITY_TYPE_UNDEFINED)
+	m_eEntityType(ENTITY_TYPE::ENTITY_TYPE_UNDEFINED),
+	m_apComponentSlots{}
 {
-	//Increment entity count and add to entity list
-	m_uEntityID = s_uNextEntityID++;
-	s_xEntityMap.insert(EntityPair(m_uEntityID, this));
-	
+	//Add to the entity registry, which gives us our ID
+	m_xHandle = s_xEntityRegistry.Add(this);
+
+	//Make room for a component of every type up front, so adding them does not keep growing the list
+	m_apComponentList.reserve(static_cast<unsigned int>(COMPONENT_TYPE::COMPONENT_TYPE_COUNT));
 }
 
 /// <summary>
@@ -31,12 +57,13 @@ Entity::~Entity()
 		delete m_apComponentList[i];
 	}
 	m_apComponentList.clear();
-
-	//Remove this entity from the entity map and
-	//reduce entity count
-	if (s_xEntityMap.count(m_uEntityID) > 0) {
-		s_xEntityMap.erase(m_uEntityID);
+	for (unsigned int i = 0; i < static_cast<unsigned int>(COMPONENT_TYPE::COMPONENT_TYPE_COUNT); ++i)
+	{
+		m_apComponentSlots[i] = nullptr;
 	}
+
+	//Remove this entity from the entity registry
+	s_xEntityRegistry.Remove(m_xHandle);
 }
 
 /// <summary>
@@ -47,11 +74,12 @@ Entity::~Entity()
 void Entity::Update(float a_fDeltaTime)
 {
 	//Loop through all of the components and update
-	std::vector<Component*>::iterator xIter;
+	ComponentList::iterator xIter;
 	for (xIter = m_apComponentList.begin(); xIter < m_apComponentList.end(); ++xIter) 
 	{
 		Component* pComponent = *xIter;
 		if (pComponent) {
+			PROFILE_SCOPE_ID(GetComponentUpdateScope(pComponent));
 			pComponent->Update(a_fDeltaTime);
 		}
 	}
@@ -64,7 +92,7 @@ void Entity::Update(float a_fDeltaTime)
 void Entity::Draw(Shader* a_pShader)
 {
 	//Loop through all of the components and draw
-	std::vector<Component*>::const_iterator xIter;
+	ComponentList::const_iterator xIter;
 	for (xIter = m_apComponentList.begin(); xIter < m_apComponentList.end(); ++xIter)
 	{
 		Component* pComponent = *xIter;
@@ -127,6 +155,14 @@ void Entity::AddComponent(Component* a_pComponentToAdd)
 {
 	//Add component to our component list
 	m_apComponentList.push_back(a_pComponentToAdd);
+
+	//Put the component in the slot for it's type, if we already have
+	//a component of this type then the first one added is kept
+	const unsigned int uSlot = static_cast<unsigned int>(a_pComponentToAdd->GetComponentType());
+	if (m_apComponentSlots[uSlot] == nullptr)
+	{
+		m_apComponentSlots[uSlot] = a_pComponentToAdd;
+	}
 }
 
 /// <summary>
@@ -136,9 +172,19 @@ void Entity::AddComponent(Component* a_pComponentToAdd)
 /// <param name="a_bDeleteComponent">If we should delete this component after it is removed</param>
 void Entity::RemoveComponent(Component* a_pComponentToRemove, const bool a_bDeleteComponent /*= false*/)
 {
+	//Clear the component from it's slot, we check every slot rather than
+	//using the component type as this can be called from the component's destructor
+	for (unsigned int i = 0; i < static_cast<unsigned int>(COMPONENT_TYPE::COMPONENT_TYPE_COUNT); ++i)
+	{
+		if (m_apComponentSlots[i] == a_pComponentToRemove)
+		{
+			m_apComponentSlots[i] = nullptr;
+		}
+	}
+
 	//Loop through all of the components and check to see if we
 	//have the component if we do the remove it
-	std::vector<Component*>::const_iterator xIter;
+	ComponentList::const_iterator xIter;
 	for (xIter = m_apComponentList.begin(); xIter < m_apComponentList.end(); ++xIter)
 	{
 		Component* pComponent = *xIter;
@@ -161,5 +207,5 @@ void Entity::RemoveComponent(Component* a_pComponentToRemove, const bool a_bDele
 /// <returns></returns>
 std::vector<Component*> Entity::GetComponentList()
 {
-	return m_apComponentList;
+	return std::vector<Component*>(m_apComponentList.begin(), m_apComponentList.end());
 }
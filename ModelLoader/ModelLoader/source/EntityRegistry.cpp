@@ -0,0 +1,87 @@
+#include "EntityRegistry.h"
+
+/// <summary>
+/// Add an entity to the registry, reusing a free slot if we have one
+/// </summary>
+/// <param name="a_pEntity">Entity to add</param>
+/// <returns>Handle to the entity</returns>
+EntityHandle EntityRegistry::Add(Entity* a_pEntity)
+{
+	unsigned int uSlot;
+	if (!m_vuFreeSlots.empty()) {
+		uSlot = m_vuFreeSlots.back();
+		m_vuFreeSlots.pop_back();
+	}
+	else {
+		uSlot = static_cast<unsigned int>(m_vSlots.size());
+		m_vSlots.push_back(Slot{ 0u, 0u, false });
+	}
+
+	Slot& xSlot = m_vSlots[uSlot];
+	xSlot.uPackedIndex = static_cast<unsigned int>(m_vpEntities.size());
+	xSlot.bInUse = true;
+
+	m_vpEntities.push_back(a_pEntity);
+	m_vuEntitySlots.push_back(uSlot);
+
+	return EntityHandle{ uSlot, xSlot.uGeneration };
+}
+
+/// <summary>
+/// Remove an entity from the registry. The last entity in the packed array is
+/// moved in to the gap so the array stays packed
+/// </summary>
+/// <param name="a_xHandle">Handle of the entity to remove</param>
+void EntityRegistry::Remove(const EntityHandle a_xHandle)
+{
+	if (!Get(a_xHandle)) {
+		return;
+	}
+
+	Slot& xSlot = m_vSlots[a_xHandle.uSlot];
+	const unsigned int uPackedIndex = xSlot.uPackedIndex;
+	const unsigned int uLastIndex = static_cast<unsigned int>(m_vpEntities.size() - 1);
+	if (uPackedIndex != uLastIndex) {
+		m_vpEntities[uPackedIndex] = m_vpEntities[uLastIndex];
+		m_vuEntitySlots[uPackedIndex] = m_vuEntitySlots[uLastIndex];
+		m_vSlots[m_vuEntitySlots[uPackedIndex]].uPackedIndex = uPackedIndex;
+	}
+	m_vpEntities.pop_back();
+	m_vuEntitySlots.pop_back();
+
+	//Change the generation so any handles to this entity no longer find the slot
+	++xSlot.uGeneration;
+	xSlot.bInUse = false;
+	m_vuFreeSlots.push_back(a_xHandle.uSlot);
+}
+
+/// <summary>
+/// Get the entity of a handle
+/// </summary>
+/// <param name="a_xHandle">Handle of the entity</param>
+/// <returns>Entity, nullptr if it has been removed</returns>
+Entity* EntityRegistry::Get(const EntityHandle a_xHandle) const
+{
+	if (a_xHandle.uSlot >= m_vSlots.size()) {
+		return nullptr;
+	}
+
+	const Slot& xSlot = m_vSlots[a_xHandle.uSlot];
+	if (!xSlot.bInUse || xSlot.uGeneration != a_xHandle.uGeneration) {
+		return nullptr;
+	}
+	return m_vpEntities[xSlot.uPackedIndex];
+}
+
+/// <summary>
+/// Get the entity that is in a slot, used when all we have is an entity ID
+/// </summary>
+/// <param name="a_uSlot">Slot of the entity</param>
+/// <returns>Entity, nullptr if the slot is not in use</returns>
+Entity* EntityRegistry::GetInSlot(const unsigned int a_uSlot) const
+{
+	if (a_uSlot >= m_vSlots.size() || !m_vSlots[a_uSlot].bInUse) {
+		return nullptr;
+	}
+	return m_vpEntities[m_vSlots[a_uSlot].uPackedIndex];
+}
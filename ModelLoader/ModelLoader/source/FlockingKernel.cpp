@@ -0,0 +1,455 @@
+#include "FlockingKernel.h"
+
+//C++ Includes
+#include <limits>
+
+//Intrinsics, the SIMD kernels are only built for x86 and x64
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define FLOCKING_KERNEL_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#endif
+
+//MSVC lets any function use AVX2 intrinsics, GCC and Clang have to be told which functions may use them
+#if defined(FLOCKING_KERNEL_X86) && !defined(_MSC_VER)
+#define FLOCKING_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define FLOCKING_TARGET_AVX2
+#endif
+
+namespace
+{
+	constexpr unsigned int sc_uLaneCount = FlockingKernel::sc_uLaneCount;
+	typedef FlockingCandidates::BLOCK_VALUE BLOCK_VALUE;
+
+	/// <summary>
+	/// Per lane sums of the kernel, each lane sums every 8th candidate
+	/// </summary>
+	struct LaneSums
+	{
+		float afSeparationX[sc_uLaneCount];
+		float afSeparationY[sc_uLaneCount];
+		float afSeparationZ[sc_uLaneCount];
+		float afAlignmentX[sc_uLaneCount];
+		float afAlignmentY[sc_uLaneCount];
+		float afAlignmentZ[sc_uLaneCount];
+		float afCohesionX[sc_uLaneCount];
+		float afCohesionY[sc_uLaneCount];
+		float afCohesionZ[sc_uLaneCount];
+		int aiNeighbourCount[sc_uLaneCount];
+	};
+
+	/// <summary>
+	/// Add the lanes together, in the same order that the SIMD kernels add their registers together
+	/// (the top half on to the bottom half, until one lane is left) so every kernel gives the same result
+	/// </summary>
+	/// <param name="a_afLanes">Value of each lane</param>
+	/// <returns>Sum of the lanes</returns>
+	float SumLanes(const float (&a_afLanes)[sc_uLaneCount])
+	{
+		const float fSum0 = a_afLanes[0] + a_afLanes[4];
+		const float fSum1 = a_afLanes[1] + a_afLanes[5];
+		const float fSum2 = a_afLanes[2] + a_afLanes[6];
+		const float fSum3 = a_afLanes[3] + a_afLanes[7];
+		return (fSum0 + fSum2) + (fSum1 + fSum3);
+	}
+
+	/// <summary>
+	/// Add all of the lanes of the scalar kernel together to get the final sums
+	/// </summary>
+	/// <param name="a_xLanes">Per lane sums</param>
+	/// <returns>Flocking Sums</returns>
+	FlockingSums ReduceLanes(const LaneSums& a_xLanes)
+	{
+		FlockingSums xSums;
+		xSums.v3Separation = glm::vec3(SumLanes(a_xLanes.afSeparationX), SumLanes(a_xLanes.afSeparationY), SumLanes(a_xLanes.afSeparationZ));
+		xSums.v3Alignment = glm::vec3(SumLanes(a_xLanes.afAlignmentX), SumLanes(a_xLanes.afAlignmentY), SumLanes(a_xLanes.afAlignmentZ));
+		xSums.v3Cohesion = glm::vec3(SumLanes(a_xLanes.afCohesionX), SumLanes(a_xLanes.afCohesionY), SumLanes(a_xLanes.afCohesionZ));
+		xSums.iNeighbourCount = 0;
+		for (unsigned int i = 0; i < sc_uLaneCount; ++i)
+		{
+			xSums.iNeighbourCount += a_xLanes.aiNeighbourCount[i];
+		}
+		return xSums;
+	}
+
+	/// <summary>
+	/// Scalar kernel, works through the candidates one at a time but keeps the same 8 lanes as the SIMD kernels
+	/// </summary>
+	FlockingSums AccumulateScalar(const glm::vec3& a_v3OwnerPos, const float a_fRadiusSqr, const FlockingCandidates& a_xCandidates)
+	{
+		LaneSums xLanes = {};
+		const unsigned int uBlockCount = a_xCandidates.GetBlockCount();
+		for (unsigned int b = 0; b < uBlockCount; ++b)
+		{
+			const float* pPositionX = a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_POSITION_X);
+			const float* pPositionY = a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_POSITION_Y);
+			const float* pPositionZ = a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_POSITION_Z);
+			const float* pVelocityX = a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_VELOCITY_X);
+			const float* pVelocityY = a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_VELOCITY_Y);
+			const float* pVelocityZ = a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_VELOCITY_Z);
+			for (unsigned int l = 0; l < sc_uLaneCount; ++l)
+			{
+				const float fDX = pPositionX[l] - a_v3OwnerPos.x;
+				const float fDY = pPositionY[l] - a_v3OwnerPos.y;
+				const float fDZ = pPositionZ[l] - a_v3OwnerPos.z;
+				const float fDistanceSqr = fDX * fDX + fDY * fDY + fDZ * fDZ;
+				if (fDistanceSqr < a_fRadiusSqr)
+				{
+					xLanes.afSeparationX[l] += a_v3OwnerPos.x - pPositionX[l];
+					xLanes.afSeparationY[l] += a_v3OwnerPos.y - pPositionY[l];
+					xLanes.afSeparationZ[l] += a_v3OwnerPos.z - pPositionZ[l];
+					xLanes.afAlignmentX[l] += pVelocityX[l];
+					xLanes.afAlignmentY[l] += pVelocityY[l];
+					xLanes.afAlignmentZ[l] += pVelocityZ[l];
+					xLanes.afCohesionX[l] += pPositionX[l];
+					xLanes.afCohesionY[l] += pPositionY[l];
+					xLanes.afCohesionZ[l] += pPositionZ[l];
+					++xLanes.aiNeighbourCount[l];
+				}
+			}
+		}
+		return ReduceLanes(xLanes);
+	}
+
+#ifdef FLOCKING_KERNEL_X86
+	/// <summary>
+	/// Add the 8 lanes held in two SSE registers together, in the same order as SumLanes
+	/// </summary>
+	/// <param name="a_v4Low">Lanes 0-3</param>
+	/// <param name="a_v4High">Lanes 4-7</param>
+	/// <returns>Sum of the lanes</returns>
+	inline float SumLanesSSE2(const __m128 a_v4Low, const __m128 a_v4High)
+	{
+		__m128 v4Sum = _mm_add_ps(a_v4Low, a_v4High);
+		v4Sum = _mm_add_ps(v4Sum, _mm_movehl_ps(v4Sum, v4Sum));
+		v4Sum = _mm_add_ss(v4Sum, _mm_shuffle_ps(v4Sum, v4Sum, _MM_SHUFFLE(1, 1, 1, 1)));
+		return _mm_cvtss_f32(v4Sum);
+	}
+
+	/// <summary>
+	/// Add the 8 lanes of neighbour counts held in two SSE registers together
+	/// </summary>
+	inline int SumLanesSSE2(const __m128i a_v4Low, const __m128i a_v4High)
+	{
+		__m128i v4Sum = _mm_add_epi32(a_v4Low, a_v4High);
+		v4Sum = _mm_add_epi32(v4Sum, _mm_shuffle_epi32(v4Sum, _MM_SHUFFLE(1, 0, 3, 2)));
+		v4Sum = _mm_add_epi32(v4Sum, _mm_shuffle_epi32(v4Sum, _MM_SHUFFLE(2, 3, 0, 1)));
+		return _mm_cvtsi128_si32(v4Sum);
+	}
+
+	/// <summary>
+	/// SSE2 kernel, tests 8 candidates at once as two halves of 4
+	/// </summary>
+	FlockingSums AccumulateSSE2(const glm::vec3& a_v3OwnerPos, const float a_fRadiusSqr, const FlockingCandidates& a_xCandidates)
+	{
+		const __m128 v4OwnerX = _mm_set1_ps(a_v3OwnerPos.x);
+		const __m128 v4OwnerY = _mm_set1_ps(a_v3OwnerPos.y);
+		const __m128 v4OwnerZ = _mm_set1_ps(a_v3OwnerPos.z);
+		const __m128 v4RadiusSqr = _mm_set1_ps(a_fRadiusSqr);
+
+		//Sums of the low and high halves of the 8 lanes
+		__m128 av4SeparationX[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+		__m128 av4SeparationY[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+		__m128 av4SeparationZ[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+		__m128 av4AlignmentX[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+		__m128 av4AlignmentY[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+		__m128 av4AlignmentZ[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+		__m128 av4CohesionX[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+		__m128 av4CohesionY[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+		__m128 av4CohesionZ[2] = { _mm_setzero_ps(), _mm_setzero_ps() };
+		__m128i av4NeighbourCount[2] = { _mm_setzero_si128(), _mm_setzero_si128() };
+
+		const unsigned int uBlockCount = a_xCandidates.GetBlockCount();
+		for (unsigned int b = 0; b < uBlockCount; ++b)
+		{
+			for (unsigned int h = 0; h < 2; ++h)
+			{
+				const unsigned int uLane = h * 4u;
+				const __m128 v4PositionX = _mm_loadu_ps(a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_POSITION_X) + uLane);
+				const __m128 v4PositionY = _mm_loadu_ps(a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_POSITION_Y) + uLane);
+				const __m128 v4PositionZ = _mm_loadu_ps(a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_POSITION_Z) + uLane);
+
+				//Distance test without a square root, masks are all 1s for the candidates in range
+				const __m128 v4DX = _mm_sub_ps(v4PositionX, v4OwnerX);
+				const __m128 v4DY = _mm_sub_ps(v4PositionY, v4OwnerY);
+				const __m128 v4DZ = _mm_sub_ps(v4PositionZ, v4OwnerZ);
+				const __m128 v4DistanceSqr = _mm_add_ps(_mm_add_ps(_mm_mul_ps(v4DX, v4DX), _mm_mul_ps(v4DY, v4DY)), _mm_mul_ps(v4DZ, v4DZ));
+				const __m128 v4InRange = _mm_cmplt_ps(v4DistanceSqr, v4RadiusSqr);
+
+				//Masked adds, candidates out of range add 0
+				av4SeparationX[h] = _mm_add_ps(av4SeparationX[h], _mm_and_ps(_mm_sub_ps(v4OwnerX, v4PositionX), v4InRange));
+				av4SeparationY[h] = _mm_add_ps(av4SeparationY[h], _mm_and_ps(_mm_sub_ps(v4OwnerY, v4PositionY), v4InRange));
+				av4SeparationZ[h] = _mm_add_ps(av4SeparationZ[h], _mm_and_ps(_mm_sub_ps(v4OwnerZ, v4PositionZ), v4InRange));
+				av4AlignmentX[h] = _mm_add_ps(av4AlignmentX[h], _mm_and_ps(_mm_loadu_ps(a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_VELOCITY_X) + uLane), v4InRange));
+				av4AlignmentY[h] = _mm_add_ps(av4AlignmentY[h], _mm_and_ps(_mm_loadu_ps(a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_VELOCITY_Y) + uLane), v4InRange));
+				av4AlignmentZ[h] = _mm_add_ps(av4AlignmentZ[h], _mm_and_ps(_mm_loadu_ps(a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_VELOCITY_Z) + uLane), v4InRange));
+				av4CohesionX[h] = _mm_add_ps(av4CohesionX[h], _mm_and_ps(v4PositionX, v4InRange));
+				av4CohesionY[h] = _mm_add_ps(av4CohesionY[h], _mm_and_ps(v4PositionY, v4InRange));
+				av4CohesionZ[h] = _mm_add_ps(av4CohesionZ[h], _mm_and_ps(v4PositionZ, v4InRange));
+				//The mask is -1 for candidates in range, so subtracting it counts them
+				av4NeighbourCount[h] = _mm_sub_epi32(av4NeighbourCount[h], _mm_castps_si128(v4InRange));
+			}
+		}
+
+		FlockingSums xSums;
+		xSums.v3Separation = glm::vec3(SumLanesSSE2(av4SeparationX[0], av4SeparationX[1]), SumLanesSSE2(av4SeparationY[0], av4SeparationY[1]), SumLanesSSE2(av4SeparationZ[0], av4SeparationZ[1]));
+		xSums.v3Alignment = glm::vec3(SumLanesSSE2(av4AlignmentX[0], av4AlignmentX[1]), SumLanesSSE2(av4AlignmentY[0], av4AlignmentY[1]), SumLanesSSE2(av4AlignmentZ[0], av4AlignmentZ[1]));
+		xSums.v3Cohesion = glm::vec3(SumLanesSSE2(av4CohesionX[0], av4CohesionX[1]), SumLanesSSE2(av4CohesionY[0], av4CohesionY[1]), SumLanesSSE2(av4CohesionZ[0], av4CohesionZ[1]));
+		xSums.iNeighbourCount = SumLanesSSE2(av4NeighbourCount[0], av4NeighbourCount[1]);
+		return xSums;
+	}
+
+	/// <summary>
+	/// Add the 8 lanes of an AVX register together, in the same order as SumLanes
+	/// </summary>
+	FLOCKING_TARGET_AVX2 inline float SumLanesAVX2(const __m256 a_v8Lanes)
+	{
+		return SumLanesSSE2(_mm256_castps256_ps128(a_v8Lanes), _mm256_extractf128_ps(a_v8Lanes, 1));
+	}
+
+	/// <summary>
+	/// AVX2 kernel, tests 8 candidates at once
+	/// </summary>
+	FLOCKING_TARGET_AVX2 FlockingSums AccumulateAVX2(const glm::vec3& a_v3OwnerPos, const float a_fRadiusSqr, const FlockingCandidates& a_xCandidates)
+	{
+		const __m256 v8OwnerX = _mm256_set1_ps(a_v3OwnerPos.x);
+		const __m256 v8OwnerY = _mm256_set1_ps(a_v3OwnerPos.y);
+		const __m256 v8OwnerZ = _mm256_set1_ps(a_v3OwnerPos.z);
+		const __m256 v8RadiusSqr = _mm256_set1_ps(a_fRadiusSqr);
+
+		__m256 v8SeparationX = _mm256_setzero_ps();
+		__m256 v8SeparationY = _mm256_setzero_ps();
+		__m256 v8SeparationZ = _mm256_setzero_ps();
+		__m256 v8AlignmentX = _mm256_setzero_ps();
+		__m256 v8AlignmentY = _mm256_setzero_ps();
+		__m256 v8AlignmentZ = _mm256_setzero_ps();
+		__m256 v8CohesionX = _mm256_setzero_ps();
+		__m256 v8CohesionY = _mm256_setzero_ps();
+		__m256 v8CohesionZ = _mm256_setzero_ps();
+		__m256i v8NeighbourCount = _mm256_setzero_si256();
+
+		const unsigned int uBlockCount = a_xCandidates.GetBlockCount();
+		for (unsigned int b = 0; b < uBlockCount; ++b)
+		{
+			const __m256 v8PositionX = _mm256_loadu_ps(a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_POSITION_X));
+			const __m256 v8PositionY = _mm256_loadu_ps(a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_POSITION_Y));
+			const __m256 v8PositionZ = _mm256_loadu_ps(a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_POSITION_Z));
+
+			//Distance test without a square root, masks are all 1s for the candidates in range
+			const __m256 v8DX = _mm256_sub_ps(v8PositionX, v8OwnerX);
+			const __m256 v8DY = _mm256_sub_ps(v8PositionY, v8OwnerY);
+			const __m256 v8DZ = _mm256_sub_ps(v8PositionZ, v8OwnerZ);
+			const __m256 v8DistanceSqr = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(v8DX, v8DX), _mm256_mul_ps(v8DY, v8DY)), _mm256_mul_ps(v8DZ, v8DZ));
+			const __m256 v8InRange = _mm256_cmp_ps(v8DistanceSqr, v8RadiusSqr, _CMP_LT_OQ);
+
+			//Masked adds, candidates out of range add 0
+			v8SeparationX = _mm256_add_ps(v8SeparationX, _mm256_and_ps(_mm256_sub_ps(v8OwnerX, v8PositionX), v8InRange));
+			v8SeparationY = _mm256_add_ps(v8SeparationY, _mm256_and_ps(_mm256_sub_ps(v8OwnerY, v8PositionY), v8InRange));
+			v8SeparationZ = _mm256_add_ps(v8SeparationZ, _mm256_and_ps(_mm256_sub_ps(v8OwnerZ, v8PositionZ), v8InRange));
+			v8AlignmentX = _mm256_add_ps(v8AlignmentX, _mm256_and_ps(_mm256_loadu_ps(a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_VELOCITY_X)), v8InRange));
+			v8AlignmentY = _mm256_add_ps(v8AlignmentY, _mm256_and_ps(_mm256_loadu_ps(a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_VELOCITY_Y)), v8InRange));
+			v8AlignmentZ = _mm256_add_ps(v8AlignmentZ, _mm256_and_ps(_mm256_loadu_ps(a_xCandidates.GetBlockValues(b, BLOCK_VALUE::BLOCK_VALUE_VELOCITY_Z)), v8InRange));
+			v8CohesionX = _mm256_add_ps(v8CohesionX, _mm256_and_ps(v8PositionX, v8InRange));
+			v8CohesionY = _mm256_add_ps(v8CohesionY, _mm256_and_ps(v8PositionY, v8InRange));
+			v8CohesionZ = _mm256_add_ps(v8CohesionZ, _mm256_and_ps(v8PositionZ, v8InRange));
+			//The mask is -1 for candidates in range, so subtracting it counts them
+			v8NeighbourCount = _mm256_sub_epi32(v8NeighbourCount, _mm256_castps_si256(v8InRange));
+		}
+
+		FlockingSums xSums;
+		xSums.v3Separation = glm::vec3(SumLanesAVX2(v8SeparationX), SumLanesAVX2(v8SeparationY), SumLanesAVX2(v8SeparationZ));
+		xSums.v3Alignment = glm::vec3(SumLanesAVX2(v8AlignmentX), SumLanesAVX2(v8AlignmentY), SumLanesAVX2(v8AlignmentZ));
+		xSums.v3Cohesion = glm::vec3(SumLanesAVX2(v8CohesionX), SumLanesAVX2(v8CohesionY), SumLanesAVX2(v8CohesionZ));
+		xSums.iNeighbourCount = SumLanesSSE2(_mm256_castsi256_si128(v8NeighbourCount), _mm256_extracti128_si256(v8NeighbourCount, 1));
+
+		//Clear the upper halves of the registers before going back to SSE code, or every SSE
+		//instruction after this waits on them
+		_mm256_zeroupper();
+		return xSums;
+	}
+#endif
+
+	typedef FlockingSums (*AccumulateFunction)(const glm::vec3&, float, const FlockingCandidates&);
+
+	/// <summary>
+	/// Get the function of a kernel
+	/// </summary>
+	AccumulateFunction GetKernelFunction(const FLOCKING_KERNEL a_eKernel)
+	{
+		switch (a_eKernel)
+		{
+#ifdef FLOCKING_KERNEL_X86
+		case FLOCKING_KERNEL::FLOCKING_KERNEL_AVX2:
+			return &AccumulateAVX2;
+		case FLOCKING_KERNEL::FLOCKING_KERNEL_SSE2:
+			return &AccumulateSSE2;
+#endif
+		default:
+			return &AccumulateScalar;
+		}
+	}
+}
+
+//Widest kernel the CPU supports, found when the program starts so the boid threads never race to pick it
+FLOCKING_KERNEL FlockingKernel::s_eKernel = FlockingKernel::DetectKernel();
+
+/// <summary>
+/// Make sure there is memory for the block that the next candidate starts. The blocks keep their
+/// memory when cleared so once they have grown to fit the most candidates a boid has this does not allocate
+/// </summary>
+void FlockingCandidates::AddBlock()
+{
+	const size_t uBlockEnd = static_cast<size_t>(uCount / FlockingKernel::sc_uLaneCount + 1u) * sc_uBlockSize;
+	if (uBlockEnd > vfBlocks.size())
+	{
+		vfBlocks.resize(uBlockEnd);
+	}
+}
+
+/// <summary>
+/// Fill the rest of the last block, so the kernel never has to deal with a partial block.
+/// Padding is as far away as a float can be so it is never within the radius
+/// </summary>
+void FlockingCandidates::Pad()
+{
+	const float fFarAway = std::numeric_limits<float>::max();
+	while (uCount % FlockingKernel::sc_uLaneCount != 0u)
+	{
+		Add(glm::vec3(fFarAway), glm::vec3(0.f));
+	}
+}
+
+/// <summary>
+/// Sum the separation, alignment and cohesion of every candidate that is within the radius of the owner.
+/// The candidates must have been padded
+/// </summary>
+/// <param name="a_v3OwnerPos">Position of the boid we are flocking for</param>
+/// <param name="a_fRadius">Neighbour radius</param>
+/// <param name="a_xCandidates">Padded neighbour candidates, not including the owner</param>
+/// <returns>Sums of the candidates in range</returns>
+FlockingSums FlockingKernel::Accumulate(const glm::vec3& a_v3OwnerPos, const float a_fRadius, const FlockingCandidates& a_xCandidates)
+{
+	return GetKernelFunction(s_eKernel)(a_v3OwnerPos, a_fRadius * a_fRadius, a_xCandidates);
+}
+
+/// <summary>
+/// Get the instruction set the kernel is using
+/// </summary>
+/// <returns>Kernel</returns>
+FLOCKING_KERNEL FlockingKernel::GetKernel()
+{
+	return s_eKernel;
+}
+
+/// <summary>
+/// Set the instruction set the kernel uses, used to compare the kernels. Should not be called while boids are updating
+/// </summary>
+/// <param name="a_eKernel">Kernel to use</param>
+/// <returns>If the CPU supports the kernel, the kernel is not changed if it does not</returns>
+bool FlockingKernel::SetKernel(const FLOCKING_KERNEL a_eKernel)
+{
+	if (!IsKernelSupported(a_eKernel))
+	{
+		return false;
+	}
+
+	s_eKernel = a_eKernel;
+	return true;
+}
+
+/// <summary>
+/// Get if the CPU supports a kernel
+/// </summary>
+/// <param name="a_eKernel">Kernel to check</param>
+/// <returns>If it can be used</returns>
+bool FlockingKernel::IsKernelSupported(const FLOCKING_KERNEL a_eKernel)
+{
+	if (a_eKernel == FLOCKING_KERNEL::FLOCKING_KERNEL_COUNT)
+	{
+		return false;
+	}
+	return static_cast<int>(a_eKernel) <= static_cast<int>(DetectKernel());
+}
+
+/// <summary>
+/// Get the text name of a kernel
+/// </summary>
+/// <param name="a_eKernel">Kernel</param>
+/// <returns>Name</returns>
+const char* FlockingKernel::GetKernelName(const FLOCKING_KERNEL a_eKernel)
+{
+	switch (a_eKernel)
+	{
+	case FLOCKING_KERNEL::FLOCKING_KERNEL_SCALAR:
+		return "Scalar";
+	case FLOCKING_KERNEL::FLOCKING_KERNEL_SSE2:
+		return "SSE2";
+	case FLOCKING_KERNEL::FLOCKING_KERNEL_AVX2:
+		return "AVX2";
+	default:
+		return "Unknown";
+	}
+}
+
+/// <summary>
+/// Use CPUID to find the widest instruction set the CPU supports. AVX2 also needs the OS to save
+/// the 256 bit registers, which is checked with XGETBV
+/// </summary>
+/// <returns>Widest supported kernel</returns>
+FLOCKING_KERNEL FlockingKernel::DetectKernel()
+{
+#ifdef FLOCKING_KERNEL_X86
+	unsigned int auRegisters[4] = { 0u, 0u, 0u, 0u }; //EAX, EBX, ECX, EDX
+#ifdef _MSC_VER
+	int aiRegisters[4];
+	__cpuid(aiRegisters, 0);
+	const unsigned int uMaxLeaf = static_cast<unsigned int>(aiRegisters[0]);
+	__cpuid(aiRegisters, 1);
+	for (unsigned int i = 0; i < 4u; ++i) { auRegisters[i] = static_cast<unsigned int>(aiRegisters[i]); }
+#else
+	const unsigned int uMaxLeaf = __get_cpuid_max(0u, nullptr);
+	__get_cpuid(1u, &auRegisters[0], &auRegisters[1], &auRegisters[2], &auRegisters[3]);
+#endif
+	const bool bSSE2 = (auRegisters[3] & (1u << 26)) != 0u;
+	const bool bOSXSave = (auRegisters[2] & (1u << 27)) != 0u;
+	const bool bAVX = (auRegisters[2] & (1u << 28)) != 0u;
+
+	//The OS has to save the SSE and AVX registers when switching threads
+	bool bOSSavesAVX = false;
+	if (bOSXSave && bAVX) {
+#ifdef _MSC_VER
+		const unsigned long long uXCR0 = _xgetbv(0);
+#else
+		unsigned int uXCR0Low, uXCR0High;
+		__asm__ volatile("xgetbv" : "=a"(uXCR0Low), "=d"(uXCR0High) : "c"(0u));
+		const unsigned long long uXCR0 = (static_cast<unsigned long long>(uXCR0High) << 32) | uXCR0Low;
+#endif
+		bOSSavesAVX = (uXCR0 & 0x6u) == 0x6u;
+	}
+
+	//AVX2 is in the extended features
+	bool bAVX2 = false;
+	if (uMaxLeaf >= 7u) {
+#ifdef _MSC_VER
+		__cpuidex(aiRegisters, 7, 0);
+		bAVX2 = (static_cast<unsigned int>(aiRegisters[1]) & (1u << 5)) != 0u;
+#else
+		__cpuid_count(7u, 0u, auRegisters[0], auRegisters[1], auRegisters[2], auRegisters[3]);
+		bAVX2 = (auRegisters[1] & (1u << 5)) != 0u;
+#endif
+	}
+
+	if (bAVX2 && bOSSavesAVX) {
+		return FLOCKING_KERNEL::FLOCKING_KERNEL_AVX2;
+	}
+	if (bSSE2) {
+		return FLOCKING_KERNEL::FLOCKING_KERNEL_SSE2;
+	}
+#endif
+	return FLOCKING_KERNEL::FLOCKING_KERNEL_SCALAR;
+}
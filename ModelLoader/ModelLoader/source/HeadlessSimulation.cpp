@@ -0,0 +1,114 @@
+#include "HeadlessSimulation.h"
+
+//C++ Includes
+#include <chrono>
+#include <iostream>
+
+//Project Includes
+#include "Scene.h"
+#include "DebugUI.h"
+#include "JobSystem.h"
+#include "BoidSystem.h"
+#include "FlockingKernel.h"
+#include "SimulationSettings.h"
+#include "TraceRecorder.h"
+#include "SimulationSnapshot.h"
+#include "TrajectoryRecorder.h"
+
+/// <summary>
+/// Run the simulation headless. Creates the scene without a window, steps it
+/// the number of times given in the settings and prints how long it took
+/// </summary>
+/// <param name="a_xSettings">Settings to run the simulation with</param>
+/// <returns>Exit code for the program</returns>
+int HeadlessSimulation::Run(const SimulationSettings& a_xSettings)
+{
+	//Put our settings in to the UI values, this is where the
+	//scene and boids get their settings from
+	UIInputValues* pUIValues = DebugUI::GetInstance()->GetUIInputValues();
+	pUIValues->iBoidCount.value = a_xSettings.iBoidCount;
+	pUIValues->iInputWorldBounds.value = a_xSettings.iWorldBounds;
+	pUIValues->bNeighbourLists = a_xSettings.bNeighbourLists;
+	pUIValues->fNeighbourListSkin.value = a_xSettings.fNeighbourListSkin;
+
+	//Set the number of threads, 0 uses all of them
+	const unsigned int uThreadCount = a_xSettings.iThreadCount > 0 ? static_cast<unsigned int>(a_xSettings.iThreadCount) : JobSystem::GetHardwareThreadCount();
+	JobSystem::GetInstance()->SetThreadCount(uThreadCount);
+
+	Scene* pScene = Scene::GetInstance();
+	if (!pScene || !pScene->InitializeHeadless(a_xSettings.uSeed))
+	{
+		std::cout << "Failed to initialize headless scene" << std::endl;
+		return 1;
+	}
+
+	//Carry on from a saved simulation if we were given one
+	if (!a_xSettings.szLoadSnapshotPath.empty() && !SimulationSnapshot::Load(a_xSettings.szLoadSnapshotPath))
+	{
+		pScene->DeInitialize(true);
+		delete pScene;
+		return 1;
+	}
+
+	const unsigned int uBoidCount = BoidSystem::GetInstance()->GetBoidCount();
+	std::cout << "Running headless: " << uBoidCount << " boids, bounds " << a_xSettings.iWorldBounds
+		<< ", " << a_xSettings.iStepCount << " steps of " << a_xSettings.fTimeStep << "s, seed " << a_xSettings.uSeed
+		<< ", " << JobSystem::GetInstance()->GetThreadCount() << " threads, "
+		<< FlockingKernel::GetKernelName(FlockingKernel::GetKernel()) << " flocking kernel" << std::endl;
+
+	//Record a trace of the first steps if asked to, each step counts as a frame
+	TraceRecorder* pTraceRecorder = TraceRecorder::GetInstance();
+	pTraceRecorder->StartRecording(static_cast<unsigned int>(a_xSettings.iTraceFrames), a_xSettings.szTracePath);
+
+	//Record every step of the boids if asked to
+	TrajectoryRecorder* pTrajectoryRecorder = TrajectoryRecorder::GetInstance();
+	if (!a_xSettings.szTrajectoryPath.empty() && !pTrajectoryRecorder->StartRecording(a_xSettings.szTrajectoryPath, a_xSettings.fTimeStep))
+	{
+		pScene->DeInitialize(true);
+		delete pScene;
+		return 1;
+	}
+
+	//Step the simulation and time how long it takes
+	const std::chrono::steady_clock::time_point xStartTime = std::chrono::steady_clock::now();
+	for (int i = 0; i < a_xSettings.iStepCount; ++i)
+	{
+		pScene->Step(a_xSettings.fTimeStep);
+		pTraceRecorder->EndFrame();
+	}
+	const std::chrono::steady_clock::time_point xEndTime = std::chrono::steady_clock::now();
+
+	//Write the trace if we finished before recording all of the frames we were asked for
+	pTraceRecorder->StopRecording();
+
+	//Finish the trajectory, this waits for the frames still being written
+	pTrajectoryRecorder->StopRecording();
+
+	//Save where we got to, so the run can be carried on later
+	const bool bSnapshotSaved = a_xSettings.szSaveSnapshotPath.empty() || SimulationSnapshot::Save(a_xSettings.szSaveSnapshotPath);
+
+	//Report throughput
+	const double fElapsedSeconds = std::chrono::duration<double>(xEndTime - xStartTime).count();
+	const double fStepsPerSecond = fElapsedSeconds > 0.0 ? a_xSettings.iStepCount / fElapsedSeconds : 0.0;
+	std::cout << "Elapsed: " << fElapsedSeconds << "s" << std::endl;
+	std::cout << "Steps/sec: " << fStepsPerSecond << std::endl;
+	std::cout << "Boid-steps/sec: " << fStepsPerSecond * uBoidCount << std::endl;
+
+	//Report how often the neighbour lists had to be rebuilt
+	const BoidSystem* pBoidSystem = BoidSystem::GetInstance();
+	if (pBoidSystem->GetNeighbourListStepCount() > 0u)
+	{
+		const unsigned int uRebuildCount = pBoidSystem->GetNeighbourListRebuildCount();
+		std::cout << "Neighbour list rebuilds: " << uRebuildCount << " in " << pBoidSystem->GetNeighbourListStepCount() << " steps";
+		if (uRebuildCount > 0u)
+		{
+			std::cout << " (every " << static_cast<double>(pBoidSystem->GetNeighbourListStepCount()) / uRebuildCount << " steps)";
+		}
+		std::cout << std::endl;
+	}
+
+	pScene->DeInitialize(true);
+	delete pScene;
+
+	return bSnapshotSaved ? 0 : 1;
+}
@@ -0,0 +1,200 @@
+#include "InstancedRenderer.h"
+
+//GL Includes
+#include <glad/glad.h>
+
+//Lib Includes
+#include <learnopengl/shader.h>
+#include <learnopengl/model.h>
+
+/// <summary>
+/// Create the instanced renderer
+/// </summary>
+InstancedRenderer::InstancedRenderer() :
+	m_uDrawCallCount(0)
+{
+}
+
+/// <summary>
+/// Start a new frame, removes all of the instances submitted last frame (keeping
+/// the memory so we do not reallocate every frame) and resets the draw call count
+/// </summary>
+void InstancedRenderer::BeginFrame()
+{
+	std::map<Model*, ModelBatch>::iterator xIter;
+	for (xIter = m_mBatches.begin(); xIter != m_mBatches.end(); ++xIter)
+	{
+		xIter->second.vM4Instances.clear();
+	}
+
+	m_uDrawCallCount = 0;
+}
+
+/// <summary>
+/// Add an instance of a model to be drawn when we flush
+/// </summary>
+/// <param name="a_pModel">Model to draw</param>
+/// <param name="a_m4ModelMatrix">Model matrix to draw the instance with</param>
+void InstancedRenderer::Submit(Model* a_pModel, const glm::mat4& a_m4ModelMatrix)
+{
+	if (!a_pModel) {
+		return;
+	}
+
+	m_mBatches[a_pModel].vM4Instances.push_back(a_m4ModelMatrix);
+}
+
+/// <summary>
+/// Draw all of the instances that have been submitted this frame. Each model uploads
+/// all of it's instance matrices in one go, then each of it's meshes is drawn with a single
+/// instanced draw call
+/// </summary>
+/// <param name="a_pShader">Instanced shader to draw with, projection and view should already be set</param>
+void InstancedRenderer::Flush(Shader* a_pShader)
+{
+	//Null Check shader
+	if (!a_pShader) {
+		return;
+	}
+
+	a_pShader->use();
+
+	std::map<Model*, ModelBatch>::iterator xIter;
+	for (xIter = m_mBatches.begin(); xIter != m_mBatches.end(); ++xIter)
+	{
+		Model* pModel = xIter->first;
+		ModelBatch& batch = xIter->second;
+		const unsigned int uInstanceCount = static_cast<unsigned int>(batch.vM4Instances.size());
+		if (uInstanceCount == 0) {
+			continue;
+		}
+
+		//Make sure we have a buffer to put instances in and know where to put our textures
+		if (batch.uInstanceBuffer == 0) {
+			CreateInstanceBuffer(pModel, batch);
+		}
+		if (batch.uSamplerShaderID != a_pShader->ID) {
+			FindSamplerLocations(pModel, batch, a_pShader);
+		}
+
+		//Upload this frame's matrices, only growing the buffer when we have more instances than it can hold
+		glBindBuffer(GL_ARRAY_BUFFER, batch.uInstanceBuffer);
+		if (uInstanceCount > batch.uInstanceCapacity) {
+			glBufferData(GL_ARRAY_BUFFER, uInstanceCount * sizeof(glm::mat4), batch.vM4Instances.data(), GL_STREAM_DRAW);
+			batch.uInstanceCapacity = uInstanceCount;
+		}
+		else {
+			glBufferSubData(GL_ARRAY_BUFFER, 0, uInstanceCount * sizeof(glm::mat4), batch.vM4Instances.data());
+		}
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		//Draw every instance of each mesh in one go
+		for (unsigned int uMeshIndex = 0; uMeshIndex < pModel->meshes.size(); ++uMeshIndex)
+		{
+			const Mesh& mesh = pModel->meshes[uMeshIndex];
+			const std::vector<int>& viSamplerLocations = batch.vviSamplerLocations[uMeshIndex];
+
+			//Bind the textures to the texture units the samplers use
+			for (unsigned int uTextureIndex = 0; uTextureIndex < mesh.textures.size(); ++uTextureIndex)
+			{
+				glActiveTexture(GL_TEXTURE0 + uTextureIndex);
+				glUniform1i(viSamplerLocations[uTextureIndex], uTextureIndex);
+				glBindTexture(GL_TEXTURE_2D, mesh.textures[uTextureIndex].id);
+			}
+
+			glBindVertexArray(mesh.VAO);
+			glDrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(mesh.indices.size()), GL_UNSIGNED_INT, nullptr, static_cast<GLsizei>(uInstanceCount));
+			++m_uDrawCallCount;
+		}
+
+		glBindVertexArray(0);
+		glActiveTexture(GL_TEXTURE0);
+	}
+}
+
+/// <summary>
+/// Delete the GL buffers of every model. The batches are removed as well, as
+/// the models they are for are about to be deleted
+/// </summary>
+void InstancedRenderer::ReleaseBuffers()
+{
+	std::map<Model*, ModelBatch>::iterator xIter;
+	for (xIter = m_mBatches.begin(); xIter != m_mBatches.end(); ++xIter)
+	{
+		if (xIter->second.uInstanceBuffer != 0) {
+			glDeleteBuffers(1, &xIter->second.uInstanceBuffer);
+		}
+	}
+	m_mBatches.clear();
+}
+
+/// <summary>
+/// Create the instance matrix buffer of a model and add it to the vertex array of each of the model's
+/// meshes, so each instance reads the next matrix from the buffer
+/// </summary>
+/// <param name="a_pModel">Model to create the buffer for</param>
+/// <param name="a_batch">Batch to store the buffer in</param>
+void InstancedRenderer::CreateInstanceBuffer(Model* a_pModel, ModelBatch& a_batch) const
+{
+	glGenBuffers(1, &a_batch.uInstanceBuffer);
+	a_batch.uInstanceCapacity = 0;
+
+	for (unsigned int uMeshIndex = 0; uMeshIndex < a_pModel->meshes.size(); ++uMeshIndex)
+	{
+		glBindVertexArray(a_pModel->meshes[uMeshIndex].VAO);
+		glBindBuffer(GL_ARRAY_BUFFER, a_batch.uInstanceBuffer);
+
+		//A mat4 attribute takes up 4 locations, one vec4 for each column
+		for (unsigned int uColumn = 0; uColumn < 4; ++uColumn)
+		{
+			const unsigned int uLocation = sc_uInstanceMatrixLocation + uColumn;
+			glEnableVertexAttribArray(uLocation);
+			glVertexAttribPointer(uLocation, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4), reinterpret_cast<void*>(uColumn * sizeof(glm::vec4)));
+			glVertexAttribDivisor(uLocation, 1);
+		}
+	}
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+/// <summary>
+/// Find the uniform location of the sampler for every texture of every mesh of a model, using
+/// the same naming as Mesh::Draw (i.e texture_diffuse1) so that we do not look them up by name every frame
+/// </summary>
+/// <param name="a_pModel">Model to find the samplers for</param>
+/// <param name="a_batch">Batch to store the locations in</param>
+/// <param name="a_pShader">Shader to find the locations in</param>
+void InstancedRenderer::FindSamplerLocations(Model* a_pModel, ModelBatch& a_batch, const Shader* a_pShader) const
+{
+	a_batch.vviSamplerLocations.clear();
+	a_batch.vviSamplerLocations.resize(a_pModel->meshes.size());
+
+	for (unsigned int uMeshIndex = 0; uMeshIndex < a_pModel->meshes.size(); ++uMeshIndex)
+	{
+		const Mesh& mesh = a_pModel->meshes[uMeshIndex];
+
+		unsigned int uDiffuseNr = 1;
+		unsigned int uSpecularNr = 1;
+		unsigned int uNormalNr = 1;
+		unsigned int uHeightNr = 1;
+		for (unsigned int uTextureIndex = 0; uTextureIndex < mesh.textures.size(); ++uTextureIndex)
+		{
+			//Get the number of this texture type (the N in texture_diffuseN)
+			const std::string& szType = mesh.textures[uTextureIndex].type;
+			std::string szNumber;
+			if (szType == "texture_diffuse")
+				szNumber = std::to_string(uDiffuseNr++);
+			else if (szType == "texture_specular")
+				szNumber = std::to_string(uSpecularNr++);
+			else if (szType == "texture_normal")
+				szNumber = std::to_string(uNormalNr++);
+			else if (szType == "texture_height")
+				szNumber = std::to_string(uHeightNr++);
+
+			a_batch.vviSamplerLocations[uMeshIndex].push_back(glGetUniformLocation(a_pShader->ID, (szType + szNumber).c_str()));
+		}
+	}
+
+	a_batch.uSamplerShaderID = a_pShader->ID;
+}
@@ -0,0 +1,213 @@
+#include "JobSystem.h"
+
+//C++ Includes
+#include <algorithm>
+#include <memory>
+
+//Project Includes
+#include "Profiler.h"
+#include "TraceRecorder.h"
+
+/// <summary>
+/// Create the job system, by default we use every hardware thread
+/// </summary>
+JobSystem::JobSystem() :
+	m_bStopWorkers(false)
+{
+	//Workers use the trace recorder and profiler as soon as they start. Singletons are created
+	//without a lock, so they must exist before there is more than one thread to create them
+	TraceRecorder::GetInstance();
+#ifdef ENABLE_PROFILER
+	Profiler::GetInstance();
+#endif
+
+	StartWorkers(GetHardwareThreadCount() - 1u);
+}
+
+/// <summary>
+/// Destroy the job system, waiting for all of the worker threads to finish
+/// </summary>
+JobSystem::~JobSystem()
+{
+	StopWorkers();
+}
+
+/// <summary>
+/// Set the number of threads that jobs are run on, including the main thread
+/// </summary>
+/// <param name="a_uThreadCount">Number of threads to use</param>
+void JobSystem::SetThreadCount(const unsigned int a_uThreadCount)
+{
+	const unsigned int uThreadCount = std::max(a_uThreadCount, 1u);
+	if (uThreadCount == GetThreadCount())
+	{
+		return;
+	}
+
+	//Restart the workers with the new count
+	StopWorkers();
+	StartWorkers(uThreadCount - 1u);
+}
+
+/// <summary>
+/// Gets the number of threads that the hardware can run at once
+/// </summary>
+/// <returns>Hardware Thread Count, always at least 1</returns>
+unsigned int JobSystem::GetHardwareThreadCount()
+{
+	return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/// <summary>
+/// Split the range [0, a_uCount) in to chunks and run the job on each chunk across all of the
+/// threads. The main thread takes chunks too, this function does not return until every chunk is done
+/// </summary>
+/// <param name="a_uCount">Number of items in the range</param>
+/// <param name="a_uChunkSize">Number of items in each chunk</param>
+/// <param name="a_fnJob">Job to run for each chunk</param>
+void JobSystem::ParallelFor(const unsigned int a_uCount, const unsigned int a_uChunkSize, const ParallelForJob& a_fnJob)
+{
+	if (a_uCount == 0)
+	{
+		return;
+	}
+
+	const unsigned int uChunkSize = std::max(a_uChunkSize, 1u);
+	const unsigned int uChunkCount = (a_uCount + uChunkSize - 1u) / uChunkSize;
+
+	//If we only have one chunk or no workers then there is no point waking anyone
+	if (uChunkCount == 1u || m_vWorkerThreads.empty())
+	{
+		a_fnJob(0u, a_uCount, 0u);
+		return;
+	}
+
+	//State shared between all of the threads taking part, this is shared so that
+	//helpers that start after the loop is finished can still safely see there is no work left
+	struct ParallelForState
+	{
+		std::atomic<unsigned int> uNextChunk;
+		std::atomic<unsigned int> uChunksDone;
+	};
+	std::shared_ptr<ParallelForState> pState = std::make_shared<ParallelForState>();
+	pState->uNextChunk = 0u;
+	pState->uChunksDone = 0u;
+
+	//Take chunks until there are none left
+	const ParallelForJob* pJob = &a_fnJob;
+	auto fnRunChunks = [pState, pJob, a_uCount, uChunkSize, uChunkCount](const unsigned int a_uThreadIndex)
+	{
+		unsigned int uChunk = pState->uNextChunk.fetch_add(1u);
+		while (uChunk < uChunkCount)
+		{
+			const unsigned int uStart = uChunk * uChunkSize;
+			const unsigned int uEnd = std::min(uStart + uChunkSize, a_uCount);
+			(*pJob)(uStart, uEnd, a_uThreadIndex);
+
+			pState->uChunksDone.fetch_add(1u);
+			uChunk = pState->uNextChunk.fetch_add(1u);
+		}
+	};
+
+	//Ask each worker to help, we never need more helpers than chunks
+	const unsigned int uHelperCount = std::min(static_cast<unsigned int>(m_vWorkerThreads.size()), uChunkCount - 1u);
+	{
+		std::lock_guard<std::mutex> xLock(m_xQueueMutex);
+		for (unsigned int i = 0; i < uHelperCount; ++i)
+		{
+			m_xJobQueue.push_back(fnRunChunks);
+		}
+	}
+	m_xJobAvailable.notify_all();
+
+	//Take chunks on the main thread, then wait for the chunks other threads are still running
+	fnRunChunks(0u);
+	while (pState->uChunksDone.load() < uChunkCount)
+	{
+		std::this_thread::yield();
+	}
+}
+
+/// <summary>
+/// Run a job on a worker thread without waiting for it, used for long running work
+/// like loading assets. If there are no workers the job is run straight away on this thread
+/// </summary>
+/// <param name="a_fnJob">Job to run</param>
+void JobSystem::Schedule(const std::function<void()>& a_fnJob)
+{
+	if (m_vWorkerThreads.empty())
+	{
+		a_fnJob();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> xLock(m_xQueueMutex);
+		m_xJobQueue.push_back([a_fnJob](unsigned int) { a_fnJob(); });
+	}
+	m_xJobAvailable.notify_one();
+}
+
+/// <summary>
+/// Start the worker threads
+/// </summary>
+/// <param name="a_uWorkerCount">Number of workers to start</param>
+void JobSystem::StartWorkers(const unsigned int a_uWorkerCount)
+{
+	m_bStopWorkers = false;
+	for (unsigned int i = 0; i < a_uWorkerCount; ++i)
+	{
+		//Thread 0 is the main thread so workers start from 1
+		m_vWorkerThreads.emplace_back(&JobSystem::WorkerLoop, this, i + 1u);
+	}
+}
+
+/// <summary>
+/// Stop all of the worker threads, any jobs that are already queued are finished first
+/// </summary>
+void JobSystem::StopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> xLock(m_xQueueMutex);
+		m_bStopWorkers = true;
+	}
+	m_xJobAvailable.notify_all();
+
+	for (unsigned int i = 0; i < m_vWorkerThreads.size(); ++i)
+	{
+		m_vWorkerThreads[i].join();
+	}
+	m_vWorkerThreads.clear();
+}
+
+/// <summary>
+/// Loop run by each of the worker threads, waits for jobs to be added
+/// to the queue and runs them
+/// </summary>
+/// <param name="a_uThreadIndex">Index of this thread</param>
+void JobSystem::WorkerLoop(const unsigned int a_uThreadIndex)
+{
+	TraceRecorder::GetInstance()->SetThreadName("Job Worker " + std::to_string(a_uThreadIndex));
+	PROFILE_THREAD_INDEX(a_uThreadIndex);
+
+	while (true)
+	{
+		std::function<void(unsigned int)> fnJob;
+		{
+			//Wait until we have a job or are told to stop
+			std::unique_lock<std::mutex> xLock(m_xQueueMutex);
+			m_xJobAvailable.wait(xLock, [this]() { return m_bStopWorkers || !m_xJobQueue.empty(); });
+
+			if (m_xJobQueue.empty())
+			{
+				//Stopping with no work left
+				return;
+			}
+
+			fnJob = std::move(m_xJobQueue.front());
+			m_xJobQueue.pop_front();
+		}
+
+		fnJob(a_uThreadIndex);
+	}
+}
@@ -0,0 +1,124 @@
+#include "MappedFile.h"
+
+//OS Includes
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// <summary>
+/// Create a mapped file with no file open
+/// </summary>
+MappedFile::MappedFile() :
+	m_pData(nullptr),
+	m_uSize(0),
+#ifdef _WIN32
+	m_pFileHandle(INVALID_HANDLE_VALUE),
+	m_pMappingHandle(nullptr)
+#else
+	m_iFileDescriptor(-1)
+#endif
+{
+}
+
+/// <summary>
+/// Destroy the mapped file, unmapping the file if it is open
+/// </summary>
+MappedFile::~MappedFile()
+{
+	Close();
+}
+
+/// <summary>
+/// Map a whole file in to memory, closes any file that is already open
+/// </summary>
+/// <param name="a_szPath">Path of the file to map</param>
+/// <returns>If the file was mapped, empty files can not be mapped</returns>
+bool MappedFile::Open(const std::string& a_szPath)
+{
+	Close();
+
+#ifdef _WIN32
+	m_pFileHandle = CreateFileA(a_szPath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (m_pFileHandle == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER xFileSize;
+	if (!GetFileSizeEx(m_pFileHandle, &xFileSize) || xFileSize.QuadPart == 0) {
+		Close();
+		return false;
+	}
+
+	m_pMappingHandle = CreateFileMappingA(m_pFileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_pMappingHandle == nullptr) {
+		Close();
+		return false;
+	}
+
+	m_pData = static_cast<const unsigned char*>(MapViewOfFile(m_pMappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (m_pData == nullptr) {
+		Close();
+		return false;
+	}
+	m_uSize = static_cast<size_t>(xFileSize.QuadPart);
+#else
+	m_iFileDescriptor = open(a_szPath.c_str(), O_RDONLY);
+	if (m_iFileDescriptor < 0) {
+		return false;
+	}
+
+	struct stat xFileStat;
+	if (fstat(m_iFileDescriptor, &xFileStat) != 0 || xFileStat.st_size == 0) {
+		Close();
+		return false;
+	}
+
+	void* pMapping = mmap(nullptr, static_cast<size_t>(xFileStat.st_size), PROT_READ, MAP_PRIVATE, m_iFileDescriptor, 0);
+	if (pMapping == MAP_FAILED) {
+		Close();
+		return false;
+	}
+	m_pData = static_cast<const unsigned char*>(pMapping);
+	m_uSize = static_cast<size_t>(xFileStat.st_size);
+#endif
+
+	return true;
+}
+
+/// <summary>
+/// Unmap the file and release the OS handles
+/// </summary>
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (m_pData != nullptr) {
+		UnmapViewOfFile(m_pData);
+	}
+	if (m_pMappingHandle != nullptr) {
+		CloseHandle(m_pMappingHandle);
+		m_pMappingHandle = nullptr;
+	}
+	if (m_pFileHandle != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_pFileHandle);
+		m_pFileHandle = INVALID_HANDLE_VALUE;
+	}
+#else
+	if (m_pData != nullptr) {
+		munmap(const_cast<unsigned char*>(m_pData), m_uSize);
+	}
+	if (m_iFileDescriptor >= 0) {
+		close(m_iFileDescriptor);
+		m_iFileDescriptor = -1;
+	}
+#endif
+
+	m_pData = nullptr;
+	m_uSize = 0;
+}
@@ -1,17 +1,35 @@
 #include "MathsUtils.h"
 
-//Project Includes
+//C++ Includes
+#include <atomic>
 #include <ctime>
 
-/// /// <summary>
-/// Seeds the RNG if neccessary
+//Project Includes
+#include "CounterRandom.h"
+
+namespace
+{
+	//Key of the global random numbers, seeded with the time until a seed is set.
+	//Each call takes the next counter, so calls from different threads never get the same number
+	uint64_t s_uRandomKey = CounterRandom::GetKey(static_cast<uint64_t>(time(nullptr)), RANDOM_DOMAIN::RANDOM_DOMAIN_GLOBAL);
+	std::atomic<uint64_t> s_uRandomCounter(0u);
+}
+
+/// <summary>
+/// Seeds the RNG with the given seed
+/// </summary>
+/// <param name="a_uSeed">Seed to use</param>
+void MathsUtils::SetSeed(const unsigned int a_uSeed)
+{
+	s_uRandomKey = CounterRandom::GetKey(a_uSeed, RANDOM_DOMAIN::RANDOM_DOMAIN_GLOBAL);
+	s_uRandomCounter = 0u;
+}
+
+/// <summary>
+/// Get the next random bits from the global counter
 /// </summary>
-void MathsUtils::SeedRandom()
-{	//Seed if 1st time random has been called
-	static bool isSeeded = false;
-	if (!isSeeded)
-	{
-		srand(time(nullptr));
-		isSeeded = true;
-	}
-}
\ No newline at end of file
+/// <returns>64 Random Bits</returns>
+uint64_t MathsUtils::NextRandomBits()
+{
+	return CounterRandom::GetBits(s_uRandomKey, 0u, s_uRandomCounter++);
+}
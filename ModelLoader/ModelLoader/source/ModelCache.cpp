@@ -0,0 +1,706 @@
+#include "ModelCache.h"
+
+//C++ Includes
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <vector>
+
+//OS Includes
+#include <sys/types.h>
+#include <sys/stat.h>
+
+//Lib Includes
+#include <learnopengl/model.h>
+
+//Project Includes
+#include "MappedFile.h"
+
+namespace
+{
+	/*
+	 * Cache file layout, all values are little endian:
+	 * CacheHeader
+	 * For each mesh:
+	 *		CacheMeshHeader
+	 *		CacheVertex[uVertexCount] (interleaved position, normal and texture coords)
+	 *		uint32_t[uIndexCount]
+	 *		For each texture: CacheTextureHeader, type chars, path chars (padded to 4 bytes)
+	 */
+	constexpr uint32_t sc_uCacheMagic = 0x4843444D; //"MDCH"
+	constexpr uint32_t sc_uCacheVersion = 2u;
+
+	struct CacheHeader
+	{
+		uint32_t uMagic;
+		uint32_t uVersion;
+		uint64_t uSourceSize; //Size of the source file the cache was built from
+		int64_t iSourceModifiedTime; //Modified time of the source file the cache was built from
+		uint64_t uSourceHash; //Hash of the source file the cache was built from
+		uint64_t uMaterialSize; //Size of the material file the cache was built from, 0 if there was none
+		int64_t iMaterialModifiedTime; //Modified time of the material file the cache was built from
+		uint64_t uMaterialHash; //Hash of the material file the cache was built from
+		uint32_t uMeshCount;
+		uint32_t uPadding;
+	};
+
+	struct CacheMeshHeader
+	{
+		uint32_t uVertexCount;
+		uint32_t uIndexCount;
+		uint32_t uTextureCount;
+		uint32_t uPadding;
+	};
+
+	struct CacheVertex
+	{
+		float afPosition[3];
+		float afNormal[3];
+		float afTexCoords[2];
+	};
+
+	struct CacheTextureHeader
+	{
+		uint32_t uTypeLength;
+		uint32_t uPathLength;
+	};
+
+	static_assert(sizeof(CacheHeader) == 64, "Cache header must have no hidden padding");
+	static_assert(sizeof(CacheMeshHeader) == 16, "Cache mesh header must have no hidden padding");
+	static_assert(sizeof(CacheVertex) == 32, "Cache vertex must have no hidden padding");
+	static_assert(sizeof(CacheTextureHeader) == 8, "Cache texture header must have no hidden padding");
+
+	/// <summary>
+	/// Reads values from the mapped cache, checking we never read past the end of the file
+	/// </summary>
+	class CacheReader
+	{
+	public:
+		CacheReader(const unsigned char* a_pData, const size_t a_uSize) : m_pData(a_pData), m_uRemaining(a_uSize) {}
+
+		bool Read(void* a_pDestination, const size_t a_uSize)
+		{
+			const unsigned char* pSource = Skip(a_uSize);
+			if (!pSource) {
+				return false;
+			}
+			memcpy(a_pDestination, pSource, a_uSize);
+			return true;
+		}
+
+		//Move past some data, returning where it starts so it can be read in place
+		const unsigned char* Skip(const size_t a_uSize)
+		{
+			if (a_uSize > m_uRemaining) {
+				return nullptr;
+			}
+			const unsigned char* pStart = m_pData;
+			m_pData += a_uSize;
+			m_uRemaining -= a_uSize;
+			return pStart;
+		}
+
+		size_t GetRemaining() const { return m_uRemaining; }
+
+	private:
+		const unsigned char* m_pData;
+		size_t m_uRemaining;
+	};
+
+	/// <summary>
+	/// Check a source file matches the info stored in the cache, the modified time can change without the
+	/// contents changing (i.e when checking out the file) so check the hash before giving up
+	/// </summary>
+	bool IsSourceUnchanged(const uint64_t a_uCachedSize, const int64_t a_iCachedModifiedTime, const uint64_t a_uCachedHash,
+		const uint64_t a_uSize, const int64_t a_iModifiedTime, const std::function<uint64_t()>& a_fnHashFile)
+	{
+		if (a_uCachedSize != a_uSize) {
+			return false;
+		}
+		return a_iCachedModifiedTime == a_iModifiedTime || a_uCachedHash == a_fnHashFile();
+	}
+
+	//Number of bytes needed to pad a size to 4 bytes
+	size_t GetPadding(const size_t a_uSize)
+	{
+		return (4 - (a_uSize % 4)) % 4;
+	}
+
+	//Add raw bytes to the end of a write buffer
+	void Append(std::vector<unsigned char>& a_vBuffer, const void* a_pData, const size_t a_uSize)
+	{
+		const unsigned char* pBytes = static_cast<const unsigned char*>(a_pData);
+		a_vBuffer.insert(a_vBuffer.end(), pBytes, pBytes + a_uSize);
+	}
+}
+
+/// <summary>
+/// Load a model, using the cache if it is up to date. If there is no cache or the source
+/// file has changed then the model is loaded with Assimp and a new cache is written
+/// </summary>
+/// <param name="a_szModelPath">Path of the source model file</param>
+/// <returns>Loaded Model, or nullptr if it could not be loaded</returns>
+Model* ModelCache::LoadModel(const std::string& a_szModelPath)
+{
+	ModelData xModelData;
+	if (!LoadModelData(a_szModelPath, xModelData)) {
+		return nullptr;
+	}
+
+	return CreateModel(xModelData);
+}
+
+/// <summary>
+/// Load a model's meshes from the cache (or the source file if the cache is out of date) and
+/// decode all of the textures it uses. Nothing is sent to the GPU so this can be run on a worker thread
+/// </summary>
+/// <param name="a_szModelPath">Path of the source model file</param>
+/// <param name="a_xModelData">Model data to fill</param>
+/// <returns>If the model was loaded</returns>
+bool ModelCache::LoadModelData(const std::string& a_szModelPath, ModelData& a_xModelData)
+{
+	const std::string szCachePath = GetCachePath(a_szModelPath);
+	a_xModelData.szDirectory = GetDirectory(a_szModelPath);
+
+	//If we can't find the source file then we can't check the cache is up to date,
+	//let Assimp try and load it so it reports the error
+	SourceFileInfo xSourceInfo;
+	if (!GetSourceFileInfo(a_szModelPath, xSourceInfo)) {
+		return ParseModel(a_szModelPath, a_xModelData);
+	}
+
+	xSourceInfo.szPath = a_szModelPath;
+
+	//Texture paths come from the material file, so the cache is also out of date if that changes.
+	//A model with no material file (or one that is missing) is cached with empty material info
+	SourceFileInfo xMaterialInfo;
+	xMaterialInfo.szPath = GetMaterialPath(a_szModelPath);
+	if (xMaterialInfo.szPath.empty() || !GetSourceFileInfo(xMaterialInfo.szPath, xMaterialInfo)) {
+		xMaterialInfo = SourceFileInfo();
+	}
+
+	//Try the cache first, if there is no usable cache parse the model and cache it for next time
+	if (!ReadCache(szCachePath, xSourceInfo, xMaterialInfo, a_xModelData)) {
+		a_xModelData.vMeshes.clear();
+		if (!ParseModel(a_szModelPath, a_xModelData)) {
+			return false;
+		}
+		if (!a_xModelData.vMeshes.empty()) {
+			WriteCache(a_xModelData, szCachePath, xSourceInfo, xMaterialInfo);
+		}
+	}
+
+	DecodeImages(a_xModelData);
+	return true;
+}
+
+/// <summary>
+/// Create a model from loaded model data, creating the mesh buffers and textures
+/// </summary>
+/// <param name="a_xModelData">Data of the model to create</param>
+/// <returns>Created Model</returns>
+Model* ModelCache::CreateModel(const ModelData& a_xModelData)
+{
+	Model* pModel = new Model();
+	pModel->directory = a_xModelData.szDirectory;
+
+	//Upload each texture once for the whole model
+	for (unsigned int i = 0; i < a_xModelData.vImages.size(); ++i)
+	{
+		Texture xTexture;
+		xTexture.id = UploadImage(a_xModelData.vImages[i]);
+		xTexture.path = a_xModelData.vImages[i].szPath;
+		pModel->textures_loaded.push_back(xTexture);
+	}
+
+	for (unsigned int uMeshIndex = 0; uMeshIndex < a_xModelData.vMeshes.size(); ++uMeshIndex)
+	{
+		const ModelData::MeshData& xMeshData = a_xModelData.vMeshes[uMeshIndex];
+
+		//Point each of the mesh's textures at the uploaded texture with the same path
+		std::vector<Texture> vTextures = xMeshData.vTextures;
+		for (unsigned int i = 0; i < vTextures.size(); ++i)
+		{
+			for (unsigned int j = 0; j < pModel->textures_loaded.size(); ++j)
+			{
+				if (pModel->textures_loaded[j].path == vTextures[i].path) {
+					vTextures[i].id = pModel->textures_loaded[j].id;
+					break;
+				}
+			}
+		}
+
+		pModel->meshes.push_back(Mesh(xMeshData.vVertices, xMeshData.vIndices, vTextures));
+	}
+
+	return pModel;
+}
+
+/// <summary>
+/// Delete a model created by CreateModel, and everything it put on the GPU. Mesh only exposes it's
+/// vertex array, so the vertex and index buffers are found from the vertex array's bindings
+/// </summary>
+/// <param name="a_pModel">Model to delete, can be nullptr</param>
+void ModelCache::DestroyModel(Model* a_pModel)
+{
+	if (!a_pModel) {
+		return;
+	}
+
+	for (unsigned int i = 0; i < a_pModel->textures_loaded.size(); ++i)
+	{
+		glDeleteTextures(1, &a_pModel->textures_loaded[i].id);
+	}
+
+	for (unsigned int i = 0; i < a_pModel->meshes.size(); ++i)
+	{
+		//Vertex attribute 0 (position) reads from the vertex buffer
+		GLint iVertexBuffer = 0;
+		GLint iIndexBuffer = 0;
+		glBindVertexArray(a_pModel->meshes[i].VAO);
+		glGetVertexAttribiv(0, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &iVertexBuffer);
+		glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &iIndexBuffer);
+		glBindVertexArray(0);
+
+		const GLuint auBuffers[] = { static_cast<GLuint>(iVertexBuffer), static_cast<GLuint>(iIndexBuffer) };
+		glDeleteBuffers(2, auBuffers);
+		glDeleteVertexArrays(1, &a_pModel->meshes[i].VAO);
+	}
+
+	delete a_pModel;
+}
+
+/// <summary>
+/// Read a model from a cache file, the cache is mapped in to memory and the meshes
+/// are read straight from the mapped data
+/// </summary>
+/// <param name="a_szCachePath">Path of the cache file</param>
+/// <param name="a_xSourceInfo">Current info of the source file, to check the cache is up to date</param>
+/// <param name="a_xMaterialInfo">Current info of the material file, to check the cache is up to date</param>
+/// <param name="a_xModelData">Model data to fill</param>
+/// <returns>If the model was read, false if the cache is missing, out of date or invalid</returns>
+bool ModelCache::ReadCache(const std::string& a_szCachePath, const SourceFileInfo& a_xSourceInfo, const SourceFileInfo& a_xMaterialInfo, ModelData& a_xModelData)
+{
+	MappedFile xCacheFile;
+	if (!xCacheFile.Open(a_szCachePath)) {
+		return false;
+	}
+
+	CacheReader xReader(xCacheFile.GetData(), xCacheFile.GetSize());
+	CacheHeader xHeader;
+	if (!xReader.Read(&xHeader, sizeof(xHeader)) || xHeader.uMagic != sc_uCacheMagic || xHeader.uVersion != sc_uCacheVersion) {
+		return false;
+	}
+
+	//Check the source and material files have not changed
+	if (!IsSourceUnchanged(xHeader.uSourceSize, xHeader.iSourceModifiedTime, xHeader.uSourceHash, a_xSourceInfo.uSize,
+			a_xSourceInfo.iModifiedTime, [&a_xSourceInfo]() { return HashFile(a_xSourceInfo.szPath); }) ||
+		!IsSourceUnchanged(xHeader.uMaterialSize, xHeader.iMaterialModifiedTime, xHeader.uMaterialHash, a_xMaterialInfo.uSize,
+			a_xMaterialInfo.iModifiedTime, [&a_xMaterialInfo]() { return HashFile(a_xMaterialInfo.szPath); })) {
+		return false;
+	}
+
+	//Every count is checked against what is left of the file before anything is allocated with it,
+	//so a corrupt cache is a cache miss rather than a huge allocation
+	if (xHeader.uMeshCount > xReader.GetRemaining() / sizeof(CacheMeshHeader)) {
+		return false;
+	}
+	a_xModelData.vMeshes.resize(xHeader.uMeshCount);
+	for (uint32_t uMeshIndex = 0; uMeshIndex < xHeader.uMeshCount; ++uMeshIndex)
+	{
+		ModelData::MeshData& xMeshData = a_xModelData.vMeshes[uMeshIndex];
+
+		CacheMeshHeader xMeshHeader;
+		if (!xReader.Read(&xMeshHeader, sizeof(xMeshHeader))) {
+			return false;
+		}
+
+		if (xMeshHeader.uVertexCount > xReader.GetRemaining() / sizeof(CacheVertex) ||
+			xMeshHeader.uIndexCount > xReader.GetRemaining() / sizeof(uint32_t) ||
+			xMeshHeader.uTextureCount > xReader.GetRemaining() / sizeof(CacheTextureHeader)) {
+			return false;
+		}
+
+		//Vertices, expanded to the vertex format meshes use
+		const unsigned char* pVertexData = xReader.Skip(static_cast<size_t>(xMeshHeader.uVertexCount) * sizeof(CacheVertex));
+		const unsigned char* pIndexData = xReader.Skip(static_cast<size_t>(xMeshHeader.uIndexCount) * sizeof(uint32_t));
+		if (!pVertexData || !pIndexData) {
+			return false;
+		}
+
+		xMeshData.vVertices.resize(xMeshHeader.uVertexCount);
+		for (uint32_t i = 0; i < xMeshHeader.uVertexCount; ++i)
+		{
+			CacheVertex xCacheVertex;
+			memcpy(&xCacheVertex, pVertexData + i * sizeof(CacheVertex), sizeof(CacheVertex));
+			Vertex& vertex = xMeshData.vVertices[i];
+			vertex.Position = glm::vec3(xCacheVertex.afPosition[0], xCacheVertex.afPosition[1], xCacheVertex.afPosition[2]);
+			vertex.Normal = glm::vec3(xCacheVertex.afNormal[0], xCacheVertex.afNormal[1], xCacheVertex.afNormal[2]);
+			vertex.TexCoords = glm::vec2(xCacheVertex.afTexCoords[0], xCacheVertex.afTexCoords[1]);
+			vertex.Tangent = glm::vec3(0.0f);
+			vertex.Bitangent = glm::vec3(0.0f);
+		}
+
+		xMeshData.vIndices.resize(xMeshHeader.uIndexCount);
+		if (xMeshHeader.uIndexCount > 0) {
+			memcpy(xMeshData.vIndices.data(), pIndexData, xMeshData.vIndices.size() * sizeof(uint32_t));
+		}
+
+		for (uint32_t uTextureIndex = 0; uTextureIndex < xMeshHeader.uTextureCount; ++uTextureIndex)
+		{
+			CacheTextureHeader xTextureHeader;
+			if (!xReader.Read(&xTextureHeader, sizeof(xTextureHeader))) {
+				return false;
+			}
+			//Each length is checked on it's own and added as a size_t, so a corrupt length can not wrap the sum
+			const size_t uTypeLength = xTextureHeader.uTypeLength;
+			const size_t uPathLength = xTextureHeader.uPathLength;
+			if (uTypeLength > xReader.GetRemaining() || uPathLength > xReader.GetRemaining() - uTypeLength) {
+				return false;
+			}
+			const size_t uStringsSize = uTypeLength + uPathLength;
+			const char* pStrings = reinterpret_cast<const char*>(xReader.Skip(uStringsSize + GetPadding(uStringsSize)));
+			if (!pStrings) {
+				return false;
+			}
+
+			Texture xTexture;
+			xTexture.id = 0;
+			xTexture.type.assign(pStrings, uTypeLength);
+			xTexture.path.assign(pStrings + uTypeLength, uPathLength);
+			xMeshData.vTextures.push_back(xTexture);
+		}
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Write a model to a cache file. The cache is written to a temporary file first then
+/// renamed, so a cache is never left half written
+/// </summary>
+/// <param name="a_xModelData">Model to cache</param>
+/// <param name="a_szCachePath">Path of the cache file</param>
+/// <param name="a_xSourceInfo">Info of the source file the model was loaded from</param>
+/// <param name="a_xMaterialInfo">Info of the material file the model was loaded from</param>
+/// <returns>If the cache was written</returns>
+bool ModelCache::WriteCache(const ModelData& a_xModelData, const std::string& a_szCachePath, const SourceFileInfo& a_xSourceInfo, const SourceFileInfo& a_xMaterialInfo)
+{
+	std::vector<unsigned char> vBuffer;
+
+	CacheHeader xHeader;
+	xHeader.uMagic = sc_uCacheMagic;
+	xHeader.uVersion = sc_uCacheVersion;
+	xHeader.uSourceSize = a_xSourceInfo.uSize;
+	xHeader.iSourceModifiedTime = a_xSourceInfo.iModifiedTime;
+	xHeader.uSourceHash = HashFile(a_xSourceInfo.szPath);
+	xHeader.uMaterialSize = a_xMaterialInfo.uSize;
+	xHeader.iMaterialModifiedTime = a_xMaterialInfo.iModifiedTime;
+	xHeader.uMaterialHash = HashFile(a_xMaterialInfo.szPath);
+	xHeader.uMeshCount = static_cast<uint32_t>(a_xModelData.vMeshes.size());
+	xHeader.uPadding = 0;
+	Append(vBuffer, &xHeader, sizeof(xHeader));
+
+	for (unsigned int uMeshIndex = 0; uMeshIndex < a_xModelData.vMeshes.size(); ++uMeshIndex)
+	{
+		const ModelData::MeshData& xMeshData = a_xModelData.vMeshes[uMeshIndex];
+
+		CacheMeshHeader xMeshHeader;
+		xMeshHeader.uVertexCount = static_cast<uint32_t>(xMeshData.vVertices.size());
+		xMeshHeader.uIndexCount = static_cast<uint32_t>(xMeshData.vIndices.size());
+		xMeshHeader.uTextureCount = static_cast<uint32_t>(xMeshData.vTextures.size());
+		xMeshHeader.uPadding = 0;
+		Append(vBuffer, &xMeshHeader, sizeof(xMeshHeader));
+
+		for (unsigned int i = 0; i < xMeshData.vVertices.size(); ++i)
+		{
+			const Vertex& vertex = xMeshData.vVertices[i];
+			const CacheVertex xCacheVertex = { { vertex.Position.x, vertex.Position.y, vertex.Position.z },
+											   { vertex.Normal.x, vertex.Normal.y, vertex.Normal.z },
+											   { vertex.TexCoords.x, vertex.TexCoords.y } };
+			Append(vBuffer, &xCacheVertex, sizeof(xCacheVertex));
+		}
+
+		for (unsigned int i = 0; i < xMeshData.vIndices.size(); ++i)
+		{
+			const uint32_t uIndex = xMeshData.vIndices[i];
+			Append(vBuffer, &uIndex, sizeof(uIndex));
+		}
+
+		for (unsigned int i = 0; i < xMeshData.vTextures.size(); ++i)
+		{
+			const Texture& texture = xMeshData.vTextures[i];
+			CacheTextureHeader xTextureHeader;
+			xTextureHeader.uTypeLength = static_cast<uint32_t>(texture.type.size());
+			xTextureHeader.uPathLength = static_cast<uint32_t>(texture.path.size());
+			Append(vBuffer, &xTextureHeader, sizeof(xTextureHeader));
+			Append(vBuffer, texture.type.data(), texture.type.size());
+			Append(vBuffer, texture.path.data(), texture.path.size());
+			vBuffer.resize(vBuffer.size() + GetPadding(texture.type.size() + texture.path.size()), 0);
+		}
+	}
+
+	//Write to a temporary file and swap it in once it is complete
+	const std::string szTempPath = a_szCachePath + ".tmp";
+	FILE* pFile = fopen(szTempPath.c_str(), "wb");
+	if (!pFile) {
+		std::cout << ("MODELCACHE::FAILED TO WRITE: " + a_szCachePath + "\n");
+		return false;
+	}
+	const bool bWritten = fwrite(vBuffer.data(), 1, vBuffer.size(), pFile) == vBuffer.size();
+	fclose(pFile);
+
+	remove(a_szCachePath.c_str());
+	if (!bWritten || rename(szTempPath.c_str(), a_szCachePath.c_str()) != 0) {
+		remove(szTempPath.c_str());
+		std::cout << ("MODELCACHE::FAILED TO WRITE: " + a_szCachePath + "\n");
+		return false;
+	}
+
+	std::cout << ("MODELCACHE::WROTE: " + a_szCachePath + "\n");
+	return true;
+}
+
+/// <summary>
+/// Load the source model file with Assimp
+/// </summary>
+/// <param name="a_szModelPath">Path of the source model file</param>
+/// <param name="a_xModelData">Model data to fill</param>
+/// <returns>If the model was loaded</returns>
+bool ModelCache::ParseModel(const std::string& a_szModelPath, ModelData& a_xModelData)
+{
+	//Each load has it's own importer, so models can be parsed on multiple threads at once
+	Assimp::Importer importer;
+	const aiScene* pScene = importer.ReadFile(a_szModelPath, aiProcess_Triangulate | aiProcess_FlipUVs);
+	if (!pScene || pScene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !pScene->mRootNode) {
+		std::cout << ("ERROR::ASSIMP:: " + std::string(importer.GetErrorString()) + "\n");
+		return false;
+	}
+
+	ParseNode(pScene->mRootNode, pScene, a_xModelData);
+	return true;
+}
+
+/// <summary>
+/// Read the meshes of a node and all of it's children
+/// </summary>
+/// <param name="a_pNode">Node to read</param>
+/// <param name="a_pScene">Scene the node is in</param>
+/// <param name="a_xModelData">Model data to add the meshes to</param>
+void ModelCache::ParseNode(const aiNode* a_pNode, const aiScene* a_pScene, ModelData& a_xModelData)
+{
+	//Texture types we use and the sampler name they are given in the shaders
+	static const std::pair<aiTextureType, const char*> sc_axTextureTypes[] = {
+		{ aiTextureType_DIFFUSE, "texture_diffuse" },
+		{ aiTextureType_SPECULAR, "texture_specular" },
+		{ aiTextureType_HEIGHT, "texture_normal" },
+		{ aiTextureType_AMBIENT, "texture_height" }
+	};
+
+	for (unsigned int uMeshIndex = 0; uMeshIndex < a_pNode->mNumMeshes; ++uMeshIndex)
+	{
+		const aiMesh* pMesh = a_pScene->mMeshes[a_pNode->mMeshes[uMeshIndex]];
+		a_xModelData.vMeshes.emplace_back();
+		ModelData::MeshData& xMeshData = a_xModelData.vMeshes.back();
+
+		xMeshData.vVertices.resize(pMesh->mNumVertices);
+		for (unsigned int i = 0; i < pMesh->mNumVertices; ++i)
+		{
+			Vertex& vertex = xMeshData.vVertices[i];
+			vertex.Position = glm::vec3(pMesh->mVertices[i].x, pMesh->mVertices[i].y, pMesh->mVertices[i].z);
+			vertex.Normal = pMesh->mNormals ? glm::vec3(pMesh->mNormals[i].x, pMesh->mNormals[i].y, pMesh->mNormals[i].z) : glm::vec3(0.0f);
+			vertex.TexCoords = pMesh->mTextureCoords[0] ? glm::vec2(pMesh->mTextureCoords[0][i].x, pMesh->mTextureCoords[0][i].y) : glm::vec2(0.0f);
+			vertex.Tangent = glm::vec3(0.0f);
+			vertex.Bitangent = glm::vec3(0.0f);
+		}
+
+		for (unsigned int i = 0; i < pMesh->mNumFaces; ++i)
+		{
+			const aiFace& face = pMesh->mFaces[i];
+			xMeshData.vIndices.insert(xMeshData.vIndices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+		}
+
+		const aiMaterial* pMaterial = a_pScene->mMaterials[pMesh->mMaterialIndex];
+		for (const std::pair<aiTextureType, const char*>& xTextureType : sc_axTextureTypes)
+		{
+			for (unsigned int i = 0; i < pMaterial->GetTextureCount(xTextureType.first); ++i)
+			{
+				aiString szPath;
+				pMaterial->GetTexture(xTextureType.first, i, &szPath);
+
+				Texture xTexture;
+				xTexture.id = 0;
+				xTexture.type = xTextureType.second;
+				xTexture.path = szPath.C_Str();
+				xMeshData.vTextures.push_back(xTexture);
+			}
+		}
+	}
+
+	for (unsigned int i = 0; i < a_pNode->mNumChildren; ++i)
+	{
+		ParseNode(a_pNode->mChildren[i], a_pScene, a_xModelData);
+	}
+}
+
+/// <summary>
+/// Decode every texture used by the model's meshes, each file is only decoded once
+/// </summary>
+/// <param name="a_xModelData">Model to decode the textures of</param>
+void ModelCache::DecodeImages(ModelData& a_xModelData)
+{
+	for (unsigned int uMeshIndex = 0; uMeshIndex < a_xModelData.vMeshes.size(); ++uMeshIndex)
+	{
+		const std::vector<Texture>& vTextures = a_xModelData.vMeshes[uMeshIndex].vTextures;
+		for (unsigned int i = 0; i < vTextures.size(); ++i)
+		{
+			bool bAlreadyDecoded = false;
+			for (unsigned int j = 0; j < a_xModelData.vImages.size(); ++j)
+			{
+				if (a_xModelData.vImages[j].szPath == vTextures[i].path) {
+					bAlreadyDecoded = true;
+					break;
+				}
+			}
+			if (bAlreadyDecoded) {
+				continue;
+			}
+
+			ModelData::ImageData xImage;
+			xImage.szPath = vTextures[i].path;
+			const std::string szFilePath = a_xModelData.szDirectory + '/' + xImage.szPath;
+			unsigned char* pPixels = stbi_load(szFilePath.c_str(), &xImage.iWidth, &xImage.iHeight, &xImage.iComponents, 0);
+			if (pPixels) {
+				xImage.vPixels.assign(pPixels, pPixels + static_cast<size_t>(xImage.iWidth) * xImage.iHeight * xImage.iComponents);
+				stbi_image_free(pPixels);
+			}
+			else {
+				std::cout << ("Texture failed to load at path: " + xImage.szPath + "\n");
+			}
+			a_xModelData.vImages.push_back(std::move(xImage));
+		}
+	}
+}
+
+/// <summary>
+/// Create a texture from decoded pixels, if the image failed to decode an
+/// empty texture is created in the same way that Model does
+/// </summary>
+/// <param name="a_xImage">Image to upload</param>
+/// <returns>GL Texture ID</returns>
+unsigned int ModelCache::UploadImage(const ModelData::ImageData& a_xImage)
+{
+	unsigned int uTextureID;
+	glGenTextures(1, &uTextureID);
+
+	if (a_xImage.vPixels.empty()) {
+		return uTextureID;
+	}
+
+	GLenum format = GL_RGB;
+	if (a_xImage.iComponents == 1) {
+		format = GL_RED;
+	}
+	else if (a_xImage.iComponents == 4) {
+		format = GL_RGBA;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, uTextureID);
+	glTexImage2D(GL_TEXTURE_2D, 0, format, a_xImage.iWidth, a_xImage.iHeight, 0, format, GL_UNSIGNED_BYTE, a_xImage.vPixels.data());
+	glGenerateMipmap(GL_TEXTURE_2D);
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+	return uTextureID;
+}
+
+/// <summary>
+/// Get the size and modified time of a source file
+/// </summary>
+/// <param name="a_szPath">Path of the file</param>
+/// <param name="a_xSourceInfo">Info to fill</param>
+/// <returns>If the file exists</returns>
+bool ModelCache::GetSourceFileInfo(const std::string& a_szPath, SourceFileInfo& a_xSourceInfo)
+{
+	struct stat xFileStat;
+	if (stat(a_szPath.c_str(), &xFileStat) != 0) {
+		return false;
+	}
+
+	a_xSourceInfo.uSize = static_cast<uint64_t>(xFileStat.st_size);
+	a_xSourceInfo.iModifiedTime = static_cast<int64_t>(xFileStat.st_mtime);
+	return true;
+}
+
+/// <summary>
+/// Find the material file a model uses, from the first mtllib line of the model file
+/// </summary>
+/// <param name="a_szModelPath">Path of the source model file</param>
+/// <returns>Path of the material file, empty if the model does not use one</returns>
+std::string ModelCache::GetMaterialPath(const std::string& a_szModelPath)
+{
+	MappedFile xFile;
+	if (!xFile.Open(a_szModelPath)) {
+		return std::string();
+	}
+
+	static const char sc_szMaterialKeyword[] = "mtllib ";
+	const size_t uKeywordLength = sizeof(sc_szMaterialKeyword) - 1;
+	const char* pData = reinterpret_cast<const char*>(xFile.GetData());
+	const char* pEnd = pData + xFile.GetSize();
+	for (const char* pLine = pData; pLine < pEnd;)
+	{
+		const char* pLineEnd = static_cast<const char*>(memchr(pLine, '\n', pEnd - pLine));
+		if (!pLineEnd) {
+			pLineEnd = pEnd;
+		}
+
+		if (static_cast<size_t>(pLineEnd - pLine) > uKeywordLength && memcmp(pLine, sc_szMaterialKeyword, uKeywordLength) == 0)
+		{
+			//Trim the whitespace (and windows line endings) around the file name
+			const char* pNameStart = pLine + uKeywordLength;
+			const char* pNameEnd = pLineEnd;
+			while (pNameStart < pNameEnd && isspace(static_cast<unsigned char>(*pNameStart))) {
+				++pNameStart;
+			}
+			while (pNameEnd > pNameStart && isspace(static_cast<unsigned char>(pNameEnd[-1]))) {
+				--pNameEnd;
+			}
+			if (pNameEnd > pNameStart) {
+				return GetDirectory(a_szModelPath) + '/' + std::string(pNameStart, pNameEnd);
+			}
+		}
+
+		pLine = pLineEnd + 1;
+	}
+
+	return std::string();
+}
+
+/// <summary>
+/// Hash the contents of a file (64 bit FNV-1a)
+/// </summary>
+/// <param name="a_szPath">Path of the file to hash</param>
+/// <returns>Hash of the file, 0 if the file could not be read</returns>
+uint64_t ModelCache::HashFile(const std::string& a_szPath)
+{
+	MappedFile xFile;
+	if (!xFile.Open(a_szPath)) {
+		return 0;
+	}
+
+	uint64_t uHash = 14695981039346656037ull;
+	const unsigned char* pData = xFile.GetData();
+	for (size_t i = 0; i < xFile.GetSize(); ++i)
+	{
+		uHash ^= pData[i];
+		uHash *= 1099511628211ull;
+	}
+
+	return uHash;
+}
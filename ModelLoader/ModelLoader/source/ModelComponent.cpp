@@ -3,6 +3,10 @@
 //Project Includes
 #include "TransformComponent.h"
 #include "Entity.h"
+#include "Scene.h"
+#include "DebugUI.h"
+#include "InstancedRenderer.h"
+#include "AssetLoader.h"
 
 //Lib Includes
 #include <learnopengl/shader.h>
@@ -14,6 +18,9 @@
 //Typedefs
 typedef Component PARENT;
 
+//Allocate from a pool
+DEFINE_POOLED_ALLOCATION(ModelComponent)
+
 /// <summary>
 /// Create a model coponent
 /// </summary>
@@ -21,6 +28,8 @@ typedef Component PARENT;
 ModelComponent::ModelComponent(Entity* a_pOwner): 
 	PARENT(a_pOwner),
 	m_pModelData(nullptr),
+	m_pvpModelChoices(nullptr),
+	m_uModelIndex(0u),
 	m_fModelScale(0.0f)																
 {
 }
@@ -37,7 +46,8 @@ void ModelComponent::Draw(Shader* a_pShader)
 	}
 
 	//Check for model data
-	if (!m_pModelData) {
+	Model* pModelData = GetModel();
+	if (!pModelData) {
 		return;
 	}
 
@@ -48,30 +58,55 @@ void ModelComponent::Draw(Shader* a_pShader)
 	}
 
 	
-	glm::mat4 modelMatrix = pTransform->GetEntityMatrix();
+	//Draw between the last two simulation states, so we move smoothly
+	//when we render faster than the simulation ticks
+	glm::mat4 modelMatrix = pTransform->GetInterpolatedMatrix(Scene::GetInstance()->GetInterpolationAlpha());
 	modelMatrix = glm::scale(modelMatrix, glm::vec3(m_fModelScale, m_fModelScale, m_fModelScale));
-	a_pShader->setMat4("model", modelMatrix);
-	m_pModelData->Draw(*a_pShader);
+
+	//When instancing, add ourselves to our model's batch which is drawn once all of
+	//the entities have been drawn. Otherwise draw the model on it's own
+	if (DebugUI::GetInstance()->GetUIInputValues()->bInstancedRendering) {
+		InstancedRenderer::GetInstance()->Submit(pModelData, modelMatrix);
+	}
+	else {
+		a_pShader->setMat4("model", modelMatrix);
+		pModelData->Draw(*a_pShader);
+		InstancedRenderer::GetInstance()->AddDrawCalls(static_cast<unsigned int>(pModelData->meshes.size()));
+	}
 }
 
 /// <summary>
-/// Chooses a random model for a given list
+/// Chooses a random model for a given list. Models in the list can still be
+/// loading (nullptr), we draw a placeholder until they are ready
 /// </summary>
-void ModelComponent::ChooseRandomModel(std::vector<Model*>& a_vpModels)
+void ModelComponent::ChooseRandomModel(const std::vector<Model*>& a_vpModels)
 {
 	if (!a_vpModels.empty()) {
 		//Select a Random Model from our list
-		const int chosenIndex = MathsUtils::RandomRange<int>(0, a_vpModels.size());
-		//Lets Choose A Model
-		Model* selectedModel = a_vpModels[chosenIndex];
-
-		if (selectedModel != nullptr)
-		{
-			SetModel(selectedModel);
-		}
+		m_uModelIndex = static_cast<unsigned int>(MathsUtils::RandomRange<int>(0, a_vpModels.size()));
+		m_pvpModelChoices = &a_vpModels;
+		m_pModelData = nullptr;
 	}
 }
 
+/// <summary>
+/// Get the model to draw, if we chose a model that has not finished
+/// loading then we draw the placeholder model
+/// </summary>
+/// <returns>Model to draw</returns>
+Model* ModelComponent::GetModel() const
+{
+	if (!m_pvpModelChoices) {
+		return m_pModelData;
+	}
+
+	if (m_uModelIndex < m_pvpModelChoices->size() && (*m_pvpModelChoices)[m_uModelIndex] != nullptr) {
+		return (*m_pvpModelChoices)[m_uModelIndex];
+	}
+
+	return AssetLoader::GetInstance()->GetPlaceholderModel();
+}
+
 /// <summary>
 /// Get the name of the component to display in text
 /// </summary>
@@ -0,0 +1,156 @@
+#include "ObjectPool.h"
+
+//C++ Includes
+#include <algorithm>
+#include <new>
+
+/// <summary>
+/// Create an object pool, no memory is allocated until the first object is
+/// </summary>
+/// <param name="a_szName">Name of the type that the pool holds</param>
+/// <param name="a_uObjectSize">Size of each object</param>
+/// <param name="a_uAlignment">Alignment of each object</param>
+/// <param name="a_uObjectsPerBlock">Number of objects allocated each time the pool grows</param>
+ObjectPool::ObjectPool(const char* a_szName, const size_t a_uObjectSize, const size_t a_uAlignment, const unsigned int a_uObjectsPerBlock) :
+	m_szName(a_szName),
+	m_uObjectSize(a_uObjectSize),
+	m_uAlignment(std::max(a_uAlignment, alignof(void*))),
+	m_uObjectsPerBlock(std::max(a_uObjectsPerBlock, 1u)),
+	m_pFreeList(nullptr),
+	m_uLiveCount(0u),
+	m_uPeakLiveCount(0u),
+	m_uAllocationCount(0u)
+{
+	const size_t uSize = std::max(a_uObjectSize, sizeof(void*));
+	m_uSlotSize = (uSize + m_uAlignment - 1) / m_uAlignment * m_uAlignment;
+
+	GetPools().push_back(this);
+}
+
+/// <summary>
+/// Destroy the pool and free all of it's blocks. If objects are still alive
+/// (e.g they are owned by something that is destroyed later at exit) the blocks are left alone
+/// </summary>
+ObjectPool::~ObjectPool()
+{
+	std::vector<ObjectPool*>& vpPools = GetPools();
+	vpPools.erase(std::remove(vpPools.begin(), vpPools.end(), this), vpPools.end());
+
+	if (m_uLiveCount == 0u) {
+		for (unsigned int i = 0; i < m_vpBlocks.size(); ++i)
+		{
+			::operator delete(m_vpBlocks[i]);
+		}
+	}
+	m_vpBlocks.clear();
+	m_pFreeList = nullptr;
+}
+
+/// <summary>
+/// Allocate memory for a single object, the pool grows by a block if there are no free objects
+/// </summary>
+/// <returns>Memory for the object</returns>
+void* ObjectPool::Allocate()
+{
+	if (!m_pFreeList) {
+		AllocateBlock();
+	}
+
+	void* pMemory = m_pFreeList;
+	m_pFreeList = *static_cast<void**>(pMemory);
+
+	++m_uLiveCount;
+	++m_uAllocationCount;
+	m_uPeakLiveCount = std::max(m_uPeakLiveCount, m_uLiveCount);
+	return pMemory;
+}
+
+/// <summary>
+/// Give the memory of an object back to the pool so it can be reused
+/// </summary>
+/// <param name="a_pMemory">Memory that was allocated from this pool</param>
+void ObjectPool::Free(void* a_pMemory)
+{
+	if (!a_pMemory) {
+		return;
+	}
+
+	*static_cast<void**>(a_pMemory) = m_pFreeList;
+	m_pFreeList = a_pMemory;
+	--m_uLiveCount;
+}
+
+/// <summary>
+/// Get the counters of this pool
+/// </summary>
+/// <returns>Pool Stats</returns>
+ObjectPoolStats ObjectPool::GetStats() const
+{
+	ObjectPoolStats xStats;
+	xStats.szName = m_szName;
+	xStats.uObjectSize = m_uObjectSize;
+	xStats.uLiveCount = m_uLiveCount;
+	xStats.uPeakLiveCount = m_uPeakLiveCount;
+	xStats.uCapacity = static_cast<unsigned int>(m_vpBlocks.size()) * m_uObjectsPerBlock;
+	xStats.uAllocationCount = m_uAllocationCount;
+	xStats.uBlockAllocationCount = m_vpBlocks.size();
+	return xStats;
+}
+
+/// <summary>
+/// Get the counters of every pool that exists, pools are created the first time their type is allocated
+/// </summary>
+/// <param name="a_vStats">List to fill with the stats</param>
+void ObjectPool::GetAllStats(std::vector<ObjectPoolStats>& a_vStats)
+{
+	a_vStats.clear();
+	const std::vector<ObjectPool*>& vpPools = GetPools();
+	for (unsigned int i = 0; i < vpPools.size(); ++i)
+	{
+		a_vStats.push_back(vpPools[i]->GetStats());
+	}
+}
+
+/// <summary>
+/// Get the number of blocks that every pool has allocated from the heap
+/// </summary>
+/// <returns>Total Block Allocations</returns>
+uint64_t ObjectPool::GetTotalBlockAllocationCount()
+{
+	uint64_t uCount = 0u;
+	const std::vector<ObjectPool*>& vpPools = GetPools();
+	for (unsigned int i = 0; i < vpPools.size(); ++i)
+	{
+		uCount += vpPools[i]->m_vpBlocks.size();
+	}
+	return uCount;
+}
+
+/// <summary>
+/// Allocate a block of objects from the heap and put them all on the free list
+/// </summary>
+void ObjectPool::AllocateBlock()
+{
+	//Objects are only as aligned as the default new makes them, which is enough for any type without an over-aligned alignas
+	unsigned char* pBlock = static_cast<unsigned char*>(::operator new(m_uSlotSize * m_uObjectsPerBlock));
+	m_vpBlocks.push_back(pBlock);
+
+	//Link the objects in reverse so that they are handed out in address order
+	for (unsigned int i = m_uObjectsPerBlock; i > 0; --i)
+	{
+		void* pObject = pBlock + (i - 1) * m_uSlotSize;
+		*static_cast<void**>(pObject) = m_pFreeList;
+		m_pFreeList = pObject;
+	}
+}
+
+/// <summary>
+/// Get the list of every pool that exists, created on first use so it
+/// exists before any pool is constructed
+/// </summary>
+/// <returns>List of Pools</returns>
+std::vector<ObjectPool*>& ObjectPool::GetPools()
+{
+	static std::vector<ObjectPool*> s_vpPools;
+	return s_vpPools;
+}
@@ -12,6 +12,9 @@
 //Typedefs
 typedef Component PARENT;
 
+//Allocate from a pool
+DEFINE_POOLED_ALLOCATION(ObstacleSpawnerComponent)
+
 //Declare Statics - Spawner Defaults
 const float ObstacleSpawnerComponent::sc_fDefaultSpawnDistance = 3.0f;
 const float ObstacleSpawnerComponent::sc_fDefaultObstacleRadius = 1.f;
@@ -49,7 +52,7 @@ void ObstacleSpawnerComponent::Update(float a_fDeltaTime)
 	//If we have released the button this frame then spawn the obsticle
 	if(m_bSpawnBtnLastFrame && !m_bSpawnBtnThisFrame)
 	{
-		SpawnObstacle(GetObstacleSpawnPos());
+		SpawnObstacle(GetObstacleSpawnPos(), m_fObstacleRadius);
 	}
 	
 	//End of frame - set button state from this frame
@@ -74,7 +77,9 @@ void ObstacleSpawnerComponent::Draw(Shader* a_pShader)
 /// Spawns an obstacle at a given position
 /// </summary>
 /// <param name="a_v3Position">Position to spawn at</param>
-void ObstacleSpawnerComponent::SpawnObstacle(const glm::vec3 a_v3Position) const
+/// <param name="a_fRadius">Radius of the obstacle</param>
+/// <returns>Obstacle Entity</returns>
+Entity* ObstacleSpawnerComponent::SpawnObstacle(const glm::vec3 a_v3Position, const float a_fRadius)
 {
 	//Create an Entity
 	Entity* pObstacleEntity = new Entity();
@@ -87,14 +92,15 @@ void ObstacleSpawnerComponent::SpawnObstacle(const glm::vec3 a_v3Position) const
 
 	//Add Sphere - so we have a visual repreentation
 	SpherePrimitiveComponent* pObstacleSphere = new SpherePrimitiveComponent(pObstacleEntity);
-	pObstacleSphere->SetDimensions(m_fObstacleRadius);
+	pObstacleSphere->SetDimensions(a_fRadius);
 	pObstacleEntity->AddComponent(pObstacleSphere);
 
 	//Add collider - so we entities avoid this
 	ColliderComponent* pObstacleCollider = new ColliderComponent(pObstacleEntity, Scene::GetInstance()->GetCollisionWorld());
-	pObstacleCollider->AddSphereCollider(m_fObstacleRadius, glm::vec3(0));
+	pObstacleCollider->AddSphereCollider(a_fRadius, glm::vec3(0));
 	pObstacleEntity->AddComponent(pObstacleCollider);
 
+	return pObstacleEntity;
 }
 
 
@@ -0,0 +1,260 @@
+#include "Profiler.h"
+
+//C++ Includes
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+/// <summary>
+/// Create the profiler
+/// </summary>
+Profiler::Profiler() :
+	m_uHistoryHead(0u),
+	m_uHistoryCount(0u)
+{
+}
+
+/// <summary>
+/// Get the ID of a scope from it's path, scopes are registered the first time they are used
+/// </summary>
+/// <param name="a_szPath">Path of the scope, with parents split by '/'</param>
+/// <returns>Scope ID, sc_uMaxScopes if we have no room for any more scopes</returns>
+unsigned int Profiler::RegisterScope(const std::string& a_szPath)
+{
+	std::lock_guard<std::mutex> xLock(m_xRegisterMutex);
+
+	for (unsigned int i = 0; i < m_vszScopePaths.size(); ++i)
+	{
+		if (m_vszScopePaths[i] == a_szPath) {
+			return i;
+		}
+	}
+
+	if (m_vszScopePaths.size() >= sc_uMaxScopes) {
+		return sc_uMaxScopes;
+	}
+
+	m_vszScopePaths.push_back(a_szPath);
+	return static_cast<unsigned int>(m_vszScopePaths.size() - 1);
+}
+
+/// <summary>
+/// Add time spent in a scope to the current frame, safe to call from any thread
+/// </summary>
+/// <param name="a_uScopeId">ID of the scope</param>
+/// <param name="a_uNanoseconds">Time spent in the scope</param>
+void Profiler::AddSample(const unsigned int a_uScopeId, const uint64_t a_uNanoseconds)
+{
+	if (a_uScopeId >= sc_uMaxScopes) {
+		return;
+	}
+
+	ThreadSamples* pSamples = GetThreadSamples();
+	pSamples->auNanoseconds[a_uScopeId].fetch_add(a_uNanoseconds, std::memory_order_relaxed);
+	pSamples->auCalls[a_uScopeId].fetch_add(1u, std::memory_order_relaxed);
+}
+
+/// <summary>
+/// Finish the current frame, the times from every thread are added together
+/// and stored in the history
+/// </summary>
+void Profiler::EndFrame()
+{
+	std::lock_guard<std::mutex> xLock(m_xRegisterMutex);
+
+	//Make room in the history for any new scopes
+	const size_t uScopeCount = m_vszScopePaths.size();
+	if (m_vafHistoryMs.size() < uScopeCount) {
+		std::array<double, sc_uHistoryFrames> afEmptyMs;
+		afEmptyMs.fill(0.0);
+		std::array<uint32_t, sc_uHistoryFrames> auEmptyCalls;
+		auEmptyCalls.fill(0u);
+		m_vafHistoryMs.resize(uScopeCount, afEmptyMs);
+		m_vauHistoryCalls.resize(uScopeCount, auEmptyCalls);
+	}
+
+	for (unsigned int uScope = 0; uScope < uScopeCount; ++uScope)
+	{
+		uint64_t uNanoseconds = 0u;
+		uint32_t uCalls = 0u;
+		for (unsigned int i = 0; i < m_vpThreadSamples.size(); ++i)
+		{
+			uNanoseconds += m_vpThreadSamples[i]->auNanoseconds[uScope].exchange(0u, std::memory_order_relaxed);
+			uCalls += m_vpThreadSamples[i]->auCalls[uScope].exchange(0u, std::memory_order_relaxed);
+		}
+
+		m_vafHistoryMs[uScope][m_uHistoryHead] = static_cast<double>(uNanoseconds) / 1000000.0;
+		m_vauHistoryCalls[uScope][m_uHistoryHead] = uCalls;
+	}
+
+	m_uHistoryHead = (m_uHistoryHead + 1u) % sc_uHistoryFrames;
+	m_uHistoryCount = std::min(m_uHistoryCount + 1u, sc_uHistoryFrames);
+}
+
+/// <summary>
+/// Get the min, average and 99th percentile time of every scope over the history. Scopes are
+/// ordered so that children come straight after their parent, in the order they were first used
+/// </summary>
+/// <param name="a_vStats">List to fill with the stats</param>
+void Profiler::GetStats(std::vector<ScopeStats>& a_vStats)
+{
+	std::lock_guard<std::mutex> xLock(m_xRegisterMutex);
+	a_vStats.clear();
+
+	//Only scopes that have been through EndFrame have a history
+	const unsigned int uScopeCount = static_cast<unsigned int>(m_vafHistoryMs.size());
+
+	//Sort key for each scope, for each part of the path the first scope to use that part.
+	//Sorting by this keeps children under their parent and siblings in the order they were first used.
+	//Scopes are indented by the number of parents that are scopes themselves
+	std::vector<std::pair<std::vector<unsigned int>, unsigned int>> vSortKeys(uScopeCount);
+	std::vector<unsigned int> vuDepths(uScopeCount, 0u);
+	for (unsigned int uScope = 0; uScope < uScopeCount; ++uScope)
+	{
+		const std::string& szPath = m_vszScopePaths[uScope];
+		vSortKeys[uScope].second = uScope;
+
+		size_t uPartEnd = 0;
+		do
+		{
+			uPartEnd = szPath.find('/', uPartEnd + 1);
+			const std::string szPrefix = szPath.substr(0, uPartEnd);
+			for (unsigned int i = 0; i < uScopeCount; ++i)
+			{
+				const std::string& szOtherPath = m_vszScopePaths[i];
+				if (szOtherPath.compare(0, szPrefix.size(), szPrefix) == 0 && (szOtherPath.size() == szPrefix.size() || szOtherPath[szPrefix.size()] == '/')) {
+					vSortKeys[uScope].first.push_back(i);
+					break;
+				}
+			}
+			if (uPartEnd != std::string::npos && std::find(m_vszScopePaths.begin(), m_vszScopePaths.begin() + uScopeCount, szPrefix) != m_vszScopePaths.begin() + uScopeCount) {
+				++vuDepths[uScope];
+			}
+		} while (uPartEnd != std::string::npos);
+	}
+	std::sort(vSortKeys.begin(), vSortKeys.end());
+
+	std::vector<double> vfFrameMs;
+	for (unsigned int uKey = 0; uKey < uScopeCount; ++uKey)
+	{
+		const unsigned int uScope = vSortKeys[uKey].second;
+
+		ScopeStats xStats;
+		xStats.szPath = m_vszScopePaths[uScope];
+		xStats.szName = xStats.szPath.substr(xStats.szPath.find_last_of('/') + 1);
+		xStats.uDepth = vuDepths[uScope];
+		xStats.fMinMs = 0.0;
+		xStats.fAvgMs = 0.0;
+		xStats.fP99Ms = 0.0;
+		xStats.fAvgCalls = 0.0;
+
+		if (m_uHistoryCount > 0) {
+			vfFrameMs.clear();
+			double fTotalMs = 0.0;
+			double fTotalCalls = 0.0;
+			for (unsigned int i = 0; i < m_uHistoryCount; ++i)
+			{
+				vfFrameMs.push_back(m_vafHistoryMs[uScope][i]);
+				fTotalMs += m_vafHistoryMs[uScope][i];
+				fTotalCalls += m_vauHistoryCalls[uScope][i];
+			}
+			std::sort(vfFrameMs.begin(), vfFrameMs.end());
+
+			const size_t uP99Index = static_cast<size_t>(std::ceil(0.99 * vfFrameMs.size())) - 1u;
+			xStats.fMinMs = vfFrameMs.front();
+			xStats.fAvgMs = fTotalMs / m_uHistoryCount;
+			xStats.fP99Ms = vfFrameMs[uP99Index];
+			xStats.fAvgCalls = fTotalCalls / m_uHistoryCount;
+		}
+
+		a_vStats.push_back(xStats);
+	}
+}
+
+/// <summary>
+/// Write the stats of every scope to a CSV file
+/// </summary>
+/// <param name="a_szPath">Path of the file to write</param>
+/// <returns>If the file was written</returns>
+bool Profiler::WriteReport(const char* a_szPath)
+{
+	std::vector<ScopeStats> vStats;
+	GetStats(vStats);
+
+	FILE* pFile = fopen(a_szPath, "w");
+	if (!pFile) {
+		printf("PROFILER::FAILED TO WRITE: %s\n", a_szPath);
+		return false;
+	}
+
+	fprintf(pFile, "scope,min_ms,avg_ms,p99_ms,avg_calls,frames\n");
+	for (const ScopeStats& xStats : vStats)
+	{
+		fprintf(pFile, "%s,%.4f,%.4f,%.4f,%.1f,%u\n", xStats.szPath.c_str(), xStats.fMinMs, xStats.fAvgMs, xStats.fP99Ms, xStats.fAvgCalls, m_uHistoryCount);
+	}
+	fclose(pFile);
+
+	printf("PROFILER::WROTE: %s\n", a_szPath);
+	return true;
+}
+
+/// <summary>
+/// Clear the history of every scope
+/// </summary>
+void Profiler::Reset()
+{
+	std::lock_guard<std::mutex> xLock(m_xRegisterMutex);
+	m_uHistoryHead = 0u;
+	m_uHistoryCount = 0u;
+}
+
+thread_local Profiler::ThreadSamples* Profiler::s_pThreadSamples = nullptr;
+
+/// <summary>
+/// Give the calling thread the samples of a job system thread index. Workers are recreated when the
+/// thread count changes, so each index keeps the same samples rather than adding more for every new thread
+/// </summary>
+/// <param name="a_uThreadIndex">Job system index of the calling thread</param>
+void Profiler::SetThreadIndex(const unsigned int a_uThreadIndex)
+{
+	std::lock_guard<std::mutex> xLock(m_xRegisterMutex);
+	if (m_vpIndexedThreadSamples.size() <= a_uThreadIndex) {
+		m_vpIndexedThreadSamples.resize(a_uThreadIndex + 1u, nullptr);
+	}
+	if (!m_vpIndexedThreadSamples[a_uThreadIndex]) {
+		m_vpIndexedThreadSamples[a_uThreadIndex] = CreateThreadSamples();
+	}
+	s_pThreadSamples = m_vpIndexedThreadSamples[a_uThreadIndex];
+}
+
+/// <summary>
+/// Get the samples of the thread that is calling, creating them the first time
+/// a thread without a job system index adds a sample
+/// </summary>
+/// <returns>Samples of this thread</returns>
+Profiler::ThreadSamples* Profiler::GetThreadSamples()
+{
+	if (!s_pThreadSamples) {
+		std::lock_guard<std::mutex> xLock(m_xRegisterMutex);
+		s_pThreadSamples = CreateThreadSamples();
+	}
+	return s_pThreadSamples;
+}
+
+/// <summary>
+/// Create empty samples for a thread, the register mutex must be held
+/// </summary>
+/// <returns>Created samples, owned by the profiler</returns>
+Profiler::ThreadSamples* Profiler::CreateThreadSamples()
+{
+	std::unique_ptr<ThreadSamples> pSamples(new ThreadSamples());
+	for (unsigned int i = 0; i < sc_uMaxScopes; ++i)
+	{
+		pSamples->auNanoseconds[i].store(0u);
+		pSamples->auCalls[i].store(0u);
+	}
+
+	//Samples are kept after the thread stops as EndFrame may not have taken them yet
+	m_vpThreadSamples.push_back(std::move(pSamples));
+	return m_vpThreadSamples.back().get();
+}
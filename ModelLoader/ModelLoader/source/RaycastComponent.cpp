@@ -8,6 +8,9 @@
 //Typedefs
 typedef Component PARENT;
 
+//Allocate from a pool
+DEFINE_POOLED_ALLOCATION(RaycastComponent)
+
 /// <summary>
 /// Create a Raycaster Component
 /// </summary>
@@ -24,69 +27,56 @@ RaycastComponent::RaycastComponent(Entity* a_pOwner, reactphysics3d::CollisionWo
 /// </summary>
 /// <param name="a_v3StartPoint">World Start Point</param>
 /// <param name="a_v3EndPoint">World End Point</param>
-/// <returns>Infomation about all of the objects that the raycast has hit</returns>
-RayCastHitsInfo* RaycastComponent::RayCast(const glm::vec3 a_v3StartPoint, const glm::vec3 a_v3EndPoint) const
+/// <param name="a_hitsInfo">Hits info to add all of the objects that the raycast has hit to</param>
+/// <param name="a_uCategoryMask">Mask of the collision categories that can be hit</param>
+/// <returns>If the raycast hit anything</returns>
+bool RaycastComponent::RayCast(const glm::vec3 a_v3StartPoint, const glm::vec3 a_v3EndPoint, RayCastHitsInfo& a_hitsInfo, const unsigned short a_uCategoryMask /*=0xFFFF*/) const
 {
 	//Create a ray from the given start and end point
 	const rp3d::Vector3 v3StartPoint(a_v3StartPoint.x, a_v3StartPoint.y, a_v3StartPoint.z);
 	const rp3d::Vector3 v3EndPoint(a_v3EndPoint.x, a_v3EndPoint.y, a_v3EndPoint.z);
-	rp3d::Ray raycastRay(v3StartPoint, v3EndPoint);
+	const rp3d::Ray raycastRay(v3StartPoint, v3EndPoint);
 
 	//Call function that takes ray as parameter and return the result of that
-	return RayCast(&raycastRay);
+	return RayCast(raycastRay, a_hitsInfo, a_uCategoryMask);
 }
 
 /// <summary>
 /// Ray casts between 2 points in the world
 /// </summary>
 /// <param name="a_ray">Ray to cast</param>
-/// <returns>Infomation about all of the objects that the raycast has hit</returns>
-RayCastHitsInfo* RaycastComponent::RayCast(rp3d::Ray* a_ray) const
+/// <param name="a_hitsInfo">Hits info to add all of the objects that the raycast has hit to</param>
+/// <param name="a_uCategoryMask">Mask of the collision categories that can be hit</param>
+/// <returns>If the raycast hit anything</returns>
+bool RaycastComponent::RayCast(const rp3d::Ray& a_ray, RayCastHitsInfo& a_hitsInfo, const unsigned short a_uCategoryMask /*=0xFFFF*/) const
 {
-	RayCastHitsInfo* callback = new RayCastHitsInfo();
-
-	//Perform Raycast and return the resulting info
-	m_pCollisionWorld->raycast(*a_ray, callback);
-	return callback;
+	//Perform Raycast, the callback adds the hits to the info
+	const unsigned int uPreviousHitCount = a_hitsInfo.GetHitCount();
+	m_pCollisionWorld->raycast(a_ray, &a_hitsInfo, a_uCategoryMask);
+	return a_hitsInfo.GetHitCount() != uPreviousHitCount;
 }
 
 /// <summary>
-/// Performs Mutiple Raycasts and returns all of the hits from those casts
+/// Performs Mutiple Raycasts from the same start point and gathers all of the hits from those casts
 /// </summary>
-/// <param name="a_vRays">Rays to process</param>
-/// <returns>All of the Hits from the raycasts</returns>
-std::vector<RayCastHitsInfo*> RaycastComponent::MutiRayCast(std::vector<rp3d::Ray*> a_vRays, bool a_bDeleteRays /*=false*/) const
+/// <param name="a_v3StartPoint">World Start Point of every ray</param>
+/// <param name="a_pV3EndPoints">World End Points of each ray</param>
+/// <param name="a_uRayCount">Number of end points/rays to cast</param>
+/// <param name="a_hitsInfo">Hits info to add all of the hits from the raycasts to</param>
+/// <param name="a_uCategoryMask">Mask of the collision categories that can be hit</param>
+/// <returns>If any of the raycasts hit anything</returns>
+bool RaycastComponent::MutiRayCast(const glm::vec3& a_v3StartPoint, const glm::vec3* a_pV3EndPoints, const unsigned int a_uRayCount, RayCastHitsInfo& a_hitsInfo, const unsigned short a_uCategoryMask /*=0xFFFF*/) const
 {
-	//List of hits to return
-	std::vector<RayCastHitsInfo*> vAllRayHits;
+	bool bHit = false;
 
-	//Loop through all of the rays and cast them, if they have a collision
-	//add them to the ray hits otherwise they are not usefull delete them.
-	for (int rayIndex = 0; rayIndex < a_vRays.size(); ++rayIndex)
+	//Loop through all of the rays and cast them, stop once
+	//we have no room left to store any hits
+	for (unsigned int rayIndex = 0; rayIndex < a_uRayCount && !a_hitsInfo.IsFull(); ++rayIndex)
 	{
-		//Cast and check for hit
-		rp3d::Ray* pCurrentRay = a_vRays[rayIndex];
-		RayCastHitsInfo* pRayHit = RayCast(pCurrentRay);
-		if (!pRayHit->m_vRayCastHits.empty())
-		{
-			vAllRayHits.push_back(pRayHit);
-		}
-		else {
-			//Ray hit nothing delete it
-			delete pRayHit;
-		}
-
-
-		//If we should delete the ray itself then delete it
-		if (a_bDeleteRays)
-		{
-			delete pCurrentRay;
-		}
+		bHit |= RayCast(a_v3StartPoint, a_pV3EndPoints[rayIndex], a_hitsInfo, a_uCategoryMask);
 	}
 
-	//Return the vector of all the hits we have collected
-	return vAllRayHits;
-
+	return bHit;
 }
 
 #pragma region Raycast Callback Info
@@ -94,15 +84,18 @@ std::vector<RayCastHitsInfo*> RaycastComponent::MutiRayCast(std::vector<rp3d::Ra
 //Function called when the ray cast hits a collider in the world
 rp3d::decimal RayCastHitsInfo::notifyRaycastHit(const rp3d::RaycastInfo& a_pRaycastInfo)
 {
-	//Create a raycast hit and fill it with our info
-	RayCastHit* hit = new RayCastHit();
-	hit->m_pHitEntity = ColliderComponent::GetEntityFromCollisionBody(a_pRaycastInfo.body);
-	hit->m_v3HitPoint = glm::vec3(a_pRaycastInfo.worldPoint.x, a_pRaycastInfo.worldPoint.y, a_pRaycastInfo.worldPoint.z);
-	hit->m_v3HitNormal = glm::vec3(a_pRaycastInfo.worldNormal.x, a_pRaycastInfo.worldNormal.y, a_pRaycastInfo.worldNormal.z);
-	hit->m_fHitFraction = a_pRaycastInfo.hitFraction;
-
-	//Add to hits list
-	m_vRayCastHits.push_back(hit);
+	//If we have no room left for this hit then stop the current ray
+	if (IsFull())
+	{
+		return reactphysics3d::decimal(0.f);
+	}
+
+	//Fill the next raycast hit in our buffer with our info
+	RayCastHit& hit = m_aRayCastHits[m_uHitCount++];
+	hit.m_pHitEntity = ColliderComponent::GetEntityFromCollisionBody(a_pRaycastInfo.body);
+	hit.m_v3HitPoint = glm::vec3(a_pRaycastInfo.worldPoint.x, a_pRaycastInfo.worldPoint.y, a_pRaycastInfo.worldPoint.z);
+	hit.m_v3HitNormal = glm::vec3(a_pRaycastInfo.worldNormal.x, a_pRaycastInfo.worldNormal.y, a_pRaycastInfo.worldNormal.z);
+	hit.m_fHitFraction = a_pRaycastInfo.hitFraction;
 
 	// Return a decimal of 1.0 to gather all hits 
 	return reactphysics3d::decimal(1.f);
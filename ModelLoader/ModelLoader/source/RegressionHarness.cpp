@@ -0,0 +1,476 @@
+#include "RegressionHarness.h"
+
+//C++ Includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+//Project Includes
+#include "Scene.h"
+#include "DebugUI.h"
+#include "Entity.h"
+#include "JobSystem.h"
+#include "BoidSystem.h"
+#include "BrainComponent.h"
+#include "TransformComponent.h"
+#include "ObstacleSpawnerComponent.h"
+#include "CounterRandom.h"
+#include "FlockingKernel.h"
+#include "MappedFile.h"
+#include "SimulationSettings.h"
+
+namespace
+{
+	/*
+	 * Golden file layout, all values are little endian:
+	 * GoldenHeader
+	 * uint64_t[uStepCount] (hash of the boids after each step)
+	 * glm::vec3[uBoidCount] for the checkpoint positions, velocities and forwards
+	 * glm::mat3[uBoidCount] (checkpoint rotations)
+	 * glm::vec3[uBoidCount] for the final positions, velocities and forwards
+	 * glm::mat3[uBoidCount] (final rotations)
+	 */
+	constexpr uint32_t sc_uGoldenMagic = 0x444C4742; //"BGLD"
+	constexpr uint32_t sc_uGoldenVersion = 2u;
+
+	struct GoldenHeader
+	{
+		uint32_t uMagic;
+		uint32_t uVersion;
+		uint32_t uBoidCount;
+		uint32_t uStepCount;
+		uint32_t uSeed;
+		uint32_t uCheckpointStep;
+	};
+
+	static_assert(sizeof(GoldenHeader) == 24, "Golden header must have no hidden padding");
+	static_assert(sizeof(glm::vec3) == 12, "vec3 must be tightly packed to be written as an array");
+	static_assert(sizeof(glm::mat3) == 36, "mat3 must be tightly packed to be written as an array");
+
+	//A seeded run of the simulation
+	struct Scenario
+	{
+		const char* szName;
+		unsigned int uBoidCount;
+		int iWorldBounds;
+		unsigned int uStepCount;
+		unsigned int uSeed;
+		bool bNeighbourLists;
+		bool bAnalyticContainment;
+		unsigned int uObstacleCount;
+	};
+
+	//Scenarios cover each way boids find their neighbours and are kept inside the world
+	const Scenario sc_axScenarios[] = {
+		{ "short", 500u, 20, 10u, 5u, false, true, 0u },
+		{ "grid", 500u, 20, 300u, 1u, false, true, 0u },
+		{ "verlet", 500u, 20, 300u, 2u, true, true, 0u },
+		{ "walls_obstacles", 300u, 10, 300u, 3u, false, false, 4u },
+		{ "dense", 2000u, 10, 120u, 4u, false, true, 0u },
+	};
+
+	constexpr float sc_fTimeStep = 1.f / 60.f;
+	constexpr float sc_fObstacleRadius = 1.f;
+
+	//Largest difference in the checkpoint state that still passes with --tolerance when the step hashes do not match
+	constexpr float sc_fTolerance = 1e-3f;
+	//Step the checkpoint state is kept after. The flock is chaotic, a rounding difference grows past the tolerance
+	//within three steps in the dense scenario, so the first step is the only one every scenario can be compared at
+	constexpr unsigned int sc_uCheckpointStep = 1u;
+
+	//Exit codes, a run where some scenarios only passed within tolerance is not a clean pass
+	constexpr int sc_iExitPassed = 0;
+	constexpr int sc_iExitFailed = 1;
+	constexpr int sc_iExitTolerance = 2;
+
+	/*
+	 * Name of the build the golden files are for. Step hashes are only the same for builds that
+	 * round the same way, so each compiler and configuration checks against it's own golden files
+	 */
+#if defined(_MSC_VER) && !defined(__clang__)
+	constexpr const char* sc_szBuildCompiler = "msvc";
+#elif defined(__clang__)
+	constexpr const char* sc_szBuildCompiler = "clang";
+#else
+	constexpr const char* sc_szBuildCompiler = "gcc";
+#endif
+#if defined(_M_X64) || defined(__x86_64__)
+	constexpr const char* sc_szBuildArch = "x64";
+#elif defined(_M_ARM64) || defined(__aarch64__)
+	constexpr const char* sc_szBuildArch = "arm64";
+#else
+	constexpr const char* sc_szBuildArch = "x86";
+#endif
+	//Fused multiply adds round differently, so a build that can contract to them gets it's own golden files
+#if defined(__FMA__) && !defined(_MSC_VER)
+	constexpr const char* sc_szBuildFma = "-fma";
+#else
+	constexpr const char* sc_szBuildFma = "";
+#endif
+#if defined(_DEBUG) || (defined(__GNUC__) && !defined(__OPTIMIZE__))
+	constexpr const char* sc_szBuildConfig = "debug";
+#else
+	constexpr const char* sc_szBuildConfig = "release";
+#endif
+
+	//State of every boid at the end of a step
+	struct BoidState
+	{
+		std::vector<glm::vec3> vV3Positions;
+		std::vector<glm::vec3> vV3Velocities;
+		std::vector<glm::vec3> vV3Forwards;
+		std::vector<glm::mat3> vM3Rotations;
+	};
+
+	/// <summary>
+	/// Get the state of every boid, rotations come from the boid transforms so changes to how they are orthogonalized are caught
+	/// </summary>
+	void GetBoidState(BoidState& a_xState)
+	{
+		const BoidSystem* pBoidSystem = BoidSystem::GetInstance();
+		const unsigned int uBoidCount = pBoidSystem->GetBoidCount();
+		a_xState.vV3Positions.resize(uBoidCount);
+		a_xState.vV3Velocities.resize(uBoidCount);
+		a_xState.vV3Forwards.resize(uBoidCount);
+		a_xState.vM3Rotations.resize(uBoidCount);
+		for (unsigned int i = 0; i < uBoidCount; ++i)
+		{
+			a_xState.vV3Positions[i] = pBoidSystem->GetPosition(i);
+			a_xState.vV3Velocities[i] = pBoidSystem->GetVelocity(i);
+			a_xState.vV3Forwards[i] = pBoidSystem->GetForward(i);
+
+			const Entity* pOwner = pBoidSystem->GetBrain(i)->GetOwnerEntity();
+			const TransformComponent* pTransform = pOwner ? pOwner->GetComponent<TransformComponent*>() : nullptr;
+			a_xState.vM3Rotations[i] = pTransform ? glm::mat3(pTransform->GetEntityMatrix()) : glm::mat3(1.0f);
+		}
+	}
+
+	/// <summary>
+	/// Add the bits of some values to a FNV-1a hash, a word at a time
+	/// </summary>
+	uint64_t HashWords(uint64_t a_uHash, const void* a_pData, const size_t a_uSize)
+	{
+		const unsigned char* pBytes = static_cast<const unsigned char*>(a_pData);
+		for (size_t i = 0; i + sizeof(uint32_t) <= a_uSize; i += sizeof(uint32_t))
+		{
+			uint32_t uWord;
+			memcpy(&uWord, pBytes + i, sizeof(uWord));
+			a_uHash = (a_uHash ^ uWord) * 0x100000001B3ull;
+		}
+		return a_uHash;
+	}
+
+	/// <summary>
+	/// Hash the state of every boid, any change to any bit changes the hash
+	/// </summary>
+	uint64_t HashBoidState(const BoidState& a_xState)
+	{
+		uint64_t uHash = 0xCBF29CE484222325ull;
+		uHash = HashWords(uHash, a_xState.vV3Positions.data(), a_xState.vV3Positions.size() * sizeof(glm::vec3));
+		uHash = HashWords(uHash, a_xState.vV3Velocities.data(), a_xState.vV3Velocities.size() * sizeof(glm::vec3));
+		uHash = HashWords(uHash, a_xState.vV3Forwards.data(), a_xState.vV3Forwards.size() * sizeof(glm::vec3));
+		uHash = HashWords(uHash, a_xState.vM3Rotations.data(), a_xState.vM3Rotations.size() * sizeof(glm::mat3));
+		return uHash;
+	}
+
+	/// <summary>
+	/// Get the largest difference between the floats of two arrays, a difference that is not finite
+	/// (e.g a NaN in either array) is returned straight away so it can never pass as a small difference
+	/// </summary>
+	template<typename T>
+	float GetMaxDifference(const std::vector<T>& a_vA, const std::vector<T>& a_vB)
+	{
+		const size_t uFloatCount = std::min(a_vA.size(), a_vB.size()) * (sizeof(T) / sizeof(float));
+		const float* pA = reinterpret_cast<const float*>(a_vA.data());
+		const float* pB = reinterpret_cast<const float*>(a_vB.data());
+		float fMaxDifference = 0.f;
+		for (size_t i = 0; i < uFloatCount; ++i)
+		{
+			const float fDifference = std::fabs(pA[i] - pB[i]);
+			if (!std::isfinite(fDifference)) {
+				return fDifference;
+			}
+			if (!(fDifference <= fMaxDifference)) {
+				fMaxDifference = fDifference;
+			}
+		}
+		return fMaxDifference;
+	}
+
+	/// <summary>
+	/// Get the largest difference in each part of two boid states, returns if every difference is within the tolerance
+	/// </summary>
+	bool GetStateDifferences(const BoidState& a_xState, const BoidState& a_xGoldenState, float (&a_afDifferences)[4])
+	{
+		a_afDifferences[0] = GetMaxDifference(a_xState.vV3Positions, a_xGoldenState.vV3Positions);
+		a_afDifferences[1] = GetMaxDifference(a_xState.vV3Velocities, a_xGoldenState.vV3Velocities);
+		a_afDifferences[2] = GetMaxDifference(a_xState.vV3Forwards, a_xGoldenState.vV3Forwards);
+		a_afDifferences[3] = GetMaxDifference(a_xState.vM3Rotations, a_xGoldenState.vM3Rotations);
+		return a_xState.vV3Positions.size() == a_xGoldenState.vV3Positions.size() && std::all_of(std::begin(a_afDifferences), std::end(a_afDifferences),
+			[](const float a_fDifference) { return std::isfinite(a_fDifference) && a_fDifference <= sc_fTolerance; });
+	}
+
+	/// <summary>
+	/// Copy an array out of the mapped golden file
+	/// </summary>
+	template<typename T>
+	const unsigned char* ReadArray(const unsigned char* a_pData, std::vector<T>& a_vArray, const size_t a_uCount)
+	{
+		a_vArray.resize(a_uCount);
+		if (a_uCount > 0u) {
+			memcpy(a_vArray.data(), a_pData, a_uCount * sizeof(T));
+		}
+		return a_pData + a_uCount * sizeof(T);
+	}
+
+	/// <summary>
+	/// Write an array to the golden file
+	/// </summary>
+	template<typename T>
+	bool WriteArray(FILE* a_pFile, const std::vector<T>& a_vArray)
+	{
+		return a_vArray.empty() || fwrite(a_vArray.data(), sizeof(T), a_vArray.size(), a_pFile) == a_vArray.size();
+	}
+
+	/// <summary>
+	/// Copy a boid state out of the mapped golden file
+	/// </summary>
+	const unsigned char* ReadBoidState(const unsigned char* a_pData, BoidState& a_xState, const size_t a_uBoidCount)
+	{
+		a_pData = ReadArray(a_pData, a_xState.vV3Positions, a_uBoidCount);
+		a_pData = ReadArray(a_pData, a_xState.vV3Velocities, a_uBoidCount);
+		a_pData = ReadArray(a_pData, a_xState.vV3Forwards, a_uBoidCount);
+		return ReadArray(a_pData, a_xState.vM3Rotations, a_uBoidCount);
+	}
+
+	/// <summary>
+	/// Write a boid state to the golden file
+	/// </summary>
+	bool WriteBoidState(FILE* a_pFile, const BoidState& a_xState)
+	{
+		return WriteArray(a_pFile, a_xState.vV3Positions) && WriteArray(a_pFile, a_xState.vV3Velocities) &&
+			WriteArray(a_pFile, a_xState.vV3Forwards) && WriteArray(a_pFile, a_xState.vM3Rotations);
+	}
+
+	/// <summary>
+	/// Write a golden file, to a temporary file that is swapped in once it is complete
+	/// </summary>
+	bool WriteGolden(const std::string& a_szPath, const Scenario& a_xScenario, const std::vector<uint64_t>& a_vuStepHashes,
+		const BoidState& a_xCheckpointState, const BoidState& a_xState)
+	{
+		GoldenHeader xHeader;
+		memset(&xHeader, 0, sizeof(xHeader));
+		xHeader.uMagic = sc_uGoldenMagic;
+		xHeader.uVersion = sc_uGoldenVersion;
+		xHeader.uBoidCount = static_cast<uint32_t>(a_xState.vV3Positions.size());
+		xHeader.uStepCount = static_cast<uint32_t>(a_vuStepHashes.size());
+		xHeader.uSeed = a_xScenario.uSeed;
+		xHeader.uCheckpointStep = sc_uCheckpointStep;
+
+		const std::string szTempPath = a_szPath + ".tmp";
+		FILE* pFile = fopen(szTempPath.c_str(), "wb");
+		if (!pFile) {
+			return false;
+		}
+		bool bWritten = fwrite(&xHeader, sizeof(xHeader), 1, pFile) == 1 && WriteArray(pFile, a_vuStepHashes);
+		bWritten = bWritten && WriteBoidState(pFile, a_xCheckpointState) && WriteBoidState(pFile, a_xState);
+		bWritten = fclose(pFile) == 0 && bWritten;
+
+		remove(a_szPath.c_str());
+		if (!bWritten || rename(szTempPath.c_str(), a_szPath.c_str()) != 0) {
+			remove(szTempPath.c_str());
+			return false;
+		}
+		return true;
+	}
+
+	/// <summary>
+	/// Read a golden file, checking it was written for the scenario
+	/// </summary>
+	bool ReadGolden(const std::string& a_szPath, const Scenario& a_xScenario, std::vector<uint64_t>& a_vuStepHashes,
+		BoidState& a_xCheckpointState, BoidState& a_xState)
+	{
+		MappedFile xFile;
+		if (!xFile.Open(a_szPath) || xFile.GetSize() < sizeof(GoldenHeader)) {
+			return false;
+		}
+
+		GoldenHeader xHeader;
+		memcpy(&xHeader, xFile.GetData(), sizeof(xHeader));
+		const size_t uExpectedSize = sizeof(GoldenHeader) + xHeader.uStepCount * sizeof(uint64_t) +
+			static_cast<size_t>(xHeader.uBoidCount) * 2u * (3u * sizeof(glm::vec3) + sizeof(glm::mat3));
+		if (xHeader.uMagic != sc_uGoldenMagic || xHeader.uVersion != sc_uGoldenVersion || xHeader.uSeed != a_xScenario.uSeed ||
+			xHeader.uStepCount != a_xScenario.uStepCount || xHeader.uCheckpointStep != sc_uCheckpointStep || xFile.GetSize() != uExpectedSize) {
+			return false;
+		}
+
+		const unsigned char* pData = xFile.GetData() + sizeof(GoldenHeader);
+		pData = ReadArray(pData, a_vuStepHashes, xHeader.uStepCount);
+		pData = ReadBoidState(pData, a_xCheckpointState, xHeader.uBoidCount);
+		ReadBoidState(pData, a_xState, xHeader.uBoidCount);
+		return true;
+	}
+
+	/// <summary>
+	/// Set up a scenario's scene. Every scenario sets the same UI values, all others keep
+	/// their defaults, so earlier scenarios do not affect later ones
+	/// </summary>
+	bool InitializeScenario(const Scenario& a_xScenario)
+	{
+		UIInputValues* pUIValues = DebugUI::GetInstance()->GetUIInputValues();
+		pUIValues->iBoidCount.value = static_cast<int>(a_xScenario.uBoidCount);
+		pUIValues->iInputWorldBounds.value = a_xScenario.iWorldBounds;
+		pUIValues->bNeighbourLists = a_xScenario.bNeighbourLists;
+		pUIValues->bAnalyticContainment = a_xScenario.bAnalyticContainment;
+
+		Scene* pScene = Scene::GetInstance();
+		if (!pScene->InitializeHeadless(a_xScenario.uSeed)) {
+			return false;
+		}
+
+		//Obstacles are placed from the seed, within the inner half of the world
+		const uint64_t uObstacleKey = CounterRandom::GetKey(a_xScenario.uSeed, RANDOM_DOMAIN::RANDOM_DOMAIN_GLOBAL);
+		const glm::vec3& v3BoundsExtent = pScene->GetBoundsInnerExtent();
+		const float fObstacleExtent = glm::min(v3BoundsExtent.x, glm::min(v3BoundsExtent.y, v3BoundsExtent.z)) * 0.5f;
+		for (unsigned int i = 0; i < a_xScenario.uObstacleCount; ++i)
+		{
+			const glm::vec3 v3Position(CounterRandom::GetRange(-fObstacleExtent, fObstacleExtent, uObstacleKey, i, 0u),
+				CounterRandom::GetRange(-fObstacleExtent, fObstacleExtent, uObstacleKey, i, 1u),
+				CounterRandom::GetRange(-fObstacleExtent, fObstacleExtent, uObstacleKey, i, 2u));
+			ObstacleSpawnerComponent::SpawnObstacle(v3Position, sc_fObstacleRadius);
+		}
+		return true;
+	}
+}
+
+/// <summary>
+/// Run every scenario and check it against this build's golden file, or write the golden files if we are updating them.
+/// A scenario passes if every step hash matches. With --tolerance another build's golden files are used and a scenario
+/// whose hashes differ is reported as TOLERANCE if the state after the first step is within the tolerance of the golden
+/// state, this only checks the first step so it is for trying a build that has no golden files of it's own and is never a clean pass
+/// </summary>
+/// <param name="a_xSettings">Settings to run with, the golden directory, tolerance and thread count are used</param>
+/// <returns>Exit code for the program, 0 if every scenario matched exactly or was updated, 1 if any failed
+/// and 2 if some only passed within tolerance</returns>
+int RegressionHarness::Run(const SimulationSettings& a_xSettings)
+{
+	//Set the number of threads, 0 uses all of them. The results must not depend on it
+	const unsigned int uThreadCount = a_xSettings.iThreadCount > 0 ? static_cast<unsigned int>(a_xSettings.iThreadCount) : JobSystem::GetHardwareThreadCount();
+	JobSystem::GetInstance()->SetThreadCount(uThreadCount);
+
+	const unsigned int uScenarioCount = sizeof(sc_axScenarios) / sizeof(sc_axScenarios[0]);
+	const std::string szBuildName = std::string(sc_szBuildCompiler) + "-" + sc_szBuildArch + sc_szBuildFma + "-" + sc_szBuildConfig;
+	//A build without it's own golden files can be checked against another build's within tolerance
+	const bool bTolerance = !a_xSettings.szToleranceBuild.empty();
+	const std::string szGoldenBuild = bTolerance ? a_xSettings.szToleranceBuild : szBuildName;
+	printf("%s %u regression scenarios in %s for %s (%s golden files%s): %u threads, %s flocking kernel\n", a_xSettings.bUpdateGolden ? "Updating" : "Checking",
+		uScenarioCount, a_xSettings.szRegressionPath.c_str(), szBuildName.c_str(), szGoldenBuild.c_str(), bTolerance ? ", only step 1 within tolerance" : "",
+		JobSystem::GetInstance()->GetThreadCount(), FlockingKernel::GetKernelName(FlockingKernel::GetKernel()));
+	printf("  %-16s %-10s %6s %6s %12s %16s\n", "Scenario", "Result", "Boids", "Steps", "Steps/sec", "Boid-steps/sec");
+
+	Scene* pScene = Scene::GetInstance();
+	unsigned int uFailedCount = 0u;
+	unsigned int uToleranceCount = 0u;
+	for (const Scenario& xScenario : sc_axScenarios)
+	{
+		if (!InitializeScenario(xScenario)) {
+			printf("  %-16s FAILED to initialize\n", xScenario.szName);
+			++uFailedCount;
+			continue;
+		}
+
+		//Step and hash the boids after every step, only the steps are timed
+		std::vector<uint64_t> vuStepHashes;
+		vuStepHashes.reserve(xScenario.uStepCount);
+		BoidState xCheckpointState;
+		BoidState xState;
+		double fStepSeconds = 0.0;
+		for (unsigned int i = 0; i < xScenario.uStepCount; ++i)
+		{
+			const std::chrono::steady_clock::time_point xStepStart = std::chrono::steady_clock::now();
+			pScene->Step(sc_fTimeStep);
+			fStepSeconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - xStepStart).count();
+
+			GetBoidState(xState);
+			vuStepHashes.push_back(HashBoidState(xState));
+			if (i + 1u == sc_uCheckpointStep) {
+				xCheckpointState = xState;
+			}
+		}
+		//A scenario shorter than the checkpoint step is checked at it's last step
+		if (xScenario.uStepCount < sc_uCheckpointStep) {
+			xCheckpointState = xState;
+		}
+		pScene->DeInitialize(false);
+
+		const double fStepsPerSecond = fStepSeconds > 0.0 ? xScenario.uStepCount / fStepSeconds : 0.0;
+		const std::string szGoldenPath = a_xSettings.szRegressionPath + "/" + xScenario.szName + "." + szGoldenBuild + ".golden";
+
+		//Compare against the golden run, a step hash that does not match shows the first step that changed
+		const char* szResult = "EXACT";
+		std::string szDetail;
+		if (a_xSettings.bUpdateGolden)
+		{
+			szResult = WriteGolden(szGoldenPath, xScenario, vuStepHashes, xCheckpointState, xState) ? "UPDATED" : "FAILED";
+			if (strcmp(szResult, "FAILED") == 0) {
+				szDetail = "could not write " + szGoldenPath;
+			}
+		}
+		else
+		{
+			std::vector<uint64_t> vuGoldenHashes;
+			BoidState xGoldenCheckpointState;
+			BoidState xGoldenState;
+			if (!ReadGolden(szGoldenPath, xScenario, vuGoldenHashes, xGoldenCheckpointState, xGoldenState)) {
+				szResult = "FAILED";
+				szDetail = "missing or out of date golden file " + szGoldenPath + ", run this build with --update-golden and commit the golden files";
+			}
+			else if (vuGoldenHashes != vuStepHashes) {
+				const unsigned int uFirstStep = static_cast<unsigned int>(std::mismatch(vuStepHashes.begin(), vuStepHashes.end(), vuGoldenHashes.begin()).first - vuStepHashes.begin());
+				//Only the checkpoint state can be within tolerance, the final state has had time to grow a rounding difference
+				float afCheckpointDifferences[4];
+				float afFinalDifferences[4];
+				const bool bWithinTolerance = GetStateDifferences(xCheckpointState, xGoldenCheckpointState, afCheckpointDifferences);
+				GetStateDifferences(xState, xGoldenState, afFinalDifferences);
+				szResult = bTolerance && bWithinTolerance ? "TOLERANCE" : "FAILED";
+
+				char szBuffer[512];
+				snprintf(szBuffer, sizeof(szBuffer), "hashes differ from step %u, largest difference at step %u: position %g, velocity %g, forward %g, rotation %g\n"
+					"    largest final difference: position %g, velocity %g, forward %g, rotation %g",
+					uFirstStep + 1u, std::min(sc_uCheckpointStep, xScenario.uStepCount), afCheckpointDifferences[0], afCheckpointDifferences[1],
+					afCheckpointDifferences[2], afCheckpointDifferences[3], afFinalDifferences[0], afFinalDifferences[1], afFinalDifferences[2], afFinalDifferences[3]);
+				szDetail = szBuffer;
+			}
+		}
+
+		if (strcmp(szResult, "FAILED") == 0) {
+			++uFailedCount;
+		}
+		else if (strcmp(szResult, "TOLERANCE") == 0) {
+			++uToleranceCount;
+		}
+		printf("  %-16s %-10s %6u %6u %12.1f %16.0f\n", xScenario.szName, szResult, xScenario.uBoidCount, xScenario.uStepCount,
+			fStepsPerSecond, fStepsPerSecond * xScenario.uBoidCount);
+		if (!szDetail.empty()) {
+			printf("    %s\n", szDetail.c_str());
+		}
+		fflush(stdout);
+	}
+
+	if (a_xSettings.bUpdateGolden) {
+		printf("%u of %u scenarios updated\n", uScenarioCount - uFailedCount, uScenarioCount);
+	}
+	else {
+		printf("%u of %u scenarios matched exactly, %u only within tolerance\n", uScenarioCount - uFailedCount - uToleranceCount, uScenarioCount, uToleranceCount);
+	}
+
+	delete pScene;
+	if (uFailedCount > 0u) {
+		return sc_iExitFailed;
+	}
+	return uToleranceCount > 0u ? sc_iExitTolerance : sc_iExitPassed;
+}
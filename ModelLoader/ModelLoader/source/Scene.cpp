@@ -28,6 +28,14 @@
 #include "CameraComponent.h"
 #include "MathsUtils.h"
 #include "ObstacleSpawnerComponent.h"
+#include "SpatialHashGrid.h"
+#include "BoidSystem.h"
+#include "InstancedRenderer.h"
+#include "AssetLoader.h"
+#include "Profiler.h"
+#include "TraceRecorder.h"
+#include "TrajectoryRecorder.h"
+#include "TrajectoryPlayer.h"
 
 
 //Static Declareations
@@ -40,10 +48,17 @@ Scene::Scene() :
 	Application(),
 	m_pCamera(nullptr),
 	m_pSceneCollisionWorld(nullptr),
+	m_fBoundsSize(0.0f),
+	m_v3BoundsInnerExtent(0.0f),
 	m_bFirstMouse(true),
 	m_ourShader(nullptr),
+	m_pInstancedShader(nullptr),
 	m_fLastX(0.0f),
-	m_fLastY(0.0f)
+	m_fLastY(0.0f),
+	m_bHeadless(false),
+	m_fStepAccumulator(0.0f),
+	m_fInterpolationAlpha(1.0f),
+	m_iStepsLastFrame(0)
 {
 }
 
@@ -90,6 +105,11 @@ bool Scene::Initialize(const bool a_bInitApplication){
 	// build and compile shaders
 	// -------------------------
 	m_ourShader = new Shader("shaders/model_loading.vs", "shaders/model_loading.fs");
+	m_pInstancedShader = new Shader("shaders/model_instanced.vs", "shaders/model_loading.fs");
+
+	//Start loading the models boids are drawn with, they load in the background
+	//and boids are drawn with a placeholder until they are ready
+	BoidSpawner::GetInstance()->LoadAllModels();
 
 
 	//Init Camera
@@ -104,9 +124,40 @@ bool Scene::Initialize(const bool a_bInitApplication){
 	//Obstacle Spawner
 	ObstacleSpawnerComponent* pObstSpawner = new ObstacleSpawnerComponent(pCameraEntity);
 	pCameraEntity->AddComponent(pObstSpawner);
+
+	//Create the world and boids, seeding with the time so every run is different
+	InitializeSimulation(static_cast<unsigned int>(time(nullptr)));
 	
-	//Seed RNG
-	srand(time(nullptr));
+	return true;
+}
+
+/// <summary>
+/// Initialize the scene without a window, GL context, camera or models. Only the
+/// entities needed to simulate the boids are created
+/// </summary>
+/// <param name="a_uSeed">Seed for the RNG, so runs can be repeated</param>
+/// <returns></returns>
+bool Scene::InitializeHeadless(const unsigned int a_uSeed)
+{
+	m_bHeadless = true;
+
+	InitializeSimulation(a_uSeed);
+
+	return true;
+}
+
+/// <summary>
+/// Create the collision world, world bounds and spawn the boids. This is
+/// shared between the windowed and headless scene
+/// </summary>
+/// <param name="a_uSeed">Seed for the RNG</param>
+void Scene::InitializeSimulation(const unsigned int a_uSeed)
+{
+	//Seed RNG, the boids wander and spawn from their own keys of the seed so they
+	//do not depend on how many other random numbers were drawn
+	MathsUtils::SetSeed(a_uSeed);
+	BoidSystem::GetInstance()->SetRandomSeed(a_uSeed);
+	BoidSpawner::GetInstance()->SetRandomSeed(a_uSeed);
 
 	//Create a collision world - this is the physics simulation that all of our physics will
 	//occour in
@@ -118,8 +169,6 @@ bool Scene::Initialize(const bool a_bInitApplication){
 	//Create boids
 	BoidSpawner::GetInstance()->SetCollisionWorld(m_pSceneCollisionWorld);
 	BoidSpawner::GetInstance()->SpawnBoids(DebugUI::GetInstance()->GetUIInputValues()->iBoidCount.value);
-	
-	return true;
 }
 
 /// <summary>
@@ -128,38 +177,108 @@ bool Scene::Initialize(const bool a_bInitApplication){
 /// <returns>If scene should keep running</returns>
 bool Scene::Update() {
 
+	//The last frame has finished rendering, store it's times before we start timing this one
+	PROFILE_END_FRAME();
+	TraceRecorder::GetInstance()->EndFrame();
+	PROFILE_SCOPE("Update");
+	TRACE_SCOPE("Scene::Update", "scene");
+
 	//Update the application values
 	Application::Update();
 
+	//Upload any models that have finished loading in the background
+	AssetLoader::GetInstance()->ProcessUploads();
+
 	//Clear the Gizmos from last frame
 	Gizmos::clear();
 
 	//Update the Debug UI
 	DebugUI::GetInstance()->Update();
 
-	//Update Boids
-	std::map<const unsigned int, Entity*>::const_iterator xIter;
-	for (xIter = Entity::GetEntityMap().begin(); xIter != Entity::GetEntityMap().end(); ++xIter) 
+	//Update the camera every frame, so it moves smoothly whatever the simulation rate is
+	if (m_pCamera && m_pCamera->GetOwnerEntity()) {
+		PROFILE_SCOPE("Update/Camera");
+		m_pCamera->GetOwnerEntity()->Update(m_fDeltaTime);
+	}
+
+	//Play back a recorded trajectory instead of simulating, if we have one open
+	const UIInputValues* pUIValues = DebugUI::GetInstance()->GetUIInputValues();
+	TrajectoryPlayer* pTrajectoryPlayer = TrajectoryPlayer::GetInstance();
+	if (pTrajectoryPlayer->IsOpen()) {
+		pTrajectoryPlayer->Update(m_fDeltaTime);
+		m_iStepsLastFrame = 0;
+		m_fStepAccumulator = 0.0f;
+		m_fInterpolationAlpha = pUIValues->bInterpolateTransforms ? pTrajectoryPlayer->GetInterpolationAlpha() : 1.0f;
+		return !glfwWindowShouldClose(m_window);
+	}
+
+	//Step the simulation at a fixed rate, taking as many steps as we need to
+	//catch up with the time that has passed
+	const float fTimeStep = pUIValues->fFixedTimeStep.value;
+	m_fStepAccumulator += m_fDeltaTime;
+	m_iStepsLastFrame = 0;
+	while (m_fStepAccumulator >= fTimeStep && m_iStepsLastFrame < pUIValues->iMaxSubSteps.value)
 	{
-		Entity* pEntity = xIter->second;
-		if (pEntity) {
-			pEntity->Update(m_fDeltaTime);
-		}
+		Step(fTimeStep);
+		m_fStepAccumulator -= fTimeStep;
+		++m_iStepsLastFrame;
 	}
 
+	//If we hit the step limit (e.g a slow frame while loading) then drop the time we couldn't
+	//simulate, otherwise we would keep trying to catch up over the next frames
+	if (m_fStepAccumulator >= fTimeStep) {
+		m_fStepAccumulator = 0.0f;
+	}
+
+	//Work out how far we are between the last step and the next, for rendering
+	m_fInterpolationAlpha = pUIValues->bInterpolateTransforms ? m_fStepAccumulator / fTimeStep : 1.0f;
+
 	//return if we should keep running
 	return !glfwWindowShouldClose(m_window);
 }
 
+/// <summary>
+/// Step the simulation, updating the boids and then all of the entities in the scene.
+/// Does not touch the window or GL so can be used when running headless
+/// </summary>
+/// <param name="a_fDeltaTime">Time to step by</param>
+void Scene::Step(const float a_fDeltaTime)
+{
+	PROFILE_SCOPE("Update/Step");
+	TRACE_SCOPE("Scene::Step", "scene");
+
+	//Update the simulation of all of the boids
+	BoidSystem::GetInstance()->Update(a_fDeltaTime);
+
+	//Record where the boids are after this step, if we are recording
+	TrajectoryRecorder::GetInstance()->RecordFrame();
+
+	//Update Entities, the camera is updated per frame rather than per step
+	PROFILE_SCOPE("Update/Step/Entities");
+	TRACE_SCOPE("Entity Updates", "scene");
+	//Entities can be spawned while we update (e.g obstacles), so get the list and it's size each time around
+	const std::vector<Entity*>& vpEntities = Entity::GetEntityRegistry().GetEntities();
+	for (unsigned int i = 0; i < vpEntities.size(); ++i)
+	{
+		Entity* pEntity = vpEntities[i];
+		if (pEntity && pEntity->GetEntityType() != ENTITY_TYPE::ENTITY_TYPE_CAMERA) {
+			pEntity->Update(a_fDeltaTime);
+		}
+	}
+}
+
 /// <summary>
 /// Render all of the elements of scene
 /// </summary>
 void Scene::Render() {
-	
+
+	PROFILE_SCOPE("Render");
+	TRACE_SCOPE("Scene::Render", "render");
+
 	//Call Render on Application
 	Application::Render();
 	
-	if (!m_ourShader) {
+	if (!m_ourShader || !m_pInstancedShader) {
 		return;
 	}
 
@@ -171,27 +290,49 @@ void Scene::Render() {
 	const glm::mat4 view = m_pCamera->GetViewMatrix();
 	m_ourShader->setMat4("projection", projection);
 	m_ourShader->setMat4("view", view);
+	m_pInstancedShader->use();
+	m_pInstancedShader->setMat4("projection", projection);
+	m_pInstancedShader->setMat4("view", view);
+	m_ourShader->use();
 
-	//Draw Boids
-	std::map<const unsigned int, Entity*>::const_iterator xIter;
-	for (xIter = Entity::GetEntityMap().begin(); xIter != Entity::GetEntityMap().end(); ++xIter)
+	//Draw Boids, when instancing models are only added to the renderer
+	//here and are all drawn when we flush
 	{
-		Entity* pEntity = xIter->second;
-		if (pEntity) {
-			pEntity->Draw(m_ourShader);
+		PROFILE_SCOPE("Render/Entities");
+		InstancedRenderer::GetInstance()->BeginFrame();
+		const std::vector<Entity*>& vpEntities = Entity::GetEntityRegistry().GetEntities();
+		for (unsigned int i = 0; i < vpEntities.size(); ++i)
+		{
+			Entity* pEntity = vpEntities[i];
+			if (pEntity) {
+				pEntity->Draw(m_ourShader);
+			}
 		}
 	}
+	{
+		PROFILE_SCOPE("Render/Instanced Flush");
+		InstancedRenderer::GetInstance()->Flush(m_pInstancedShader);
+	}
 
 	//Draw Gizmos
-	Gizmos::draw(view, projection);
+	{
+		PROFILE_SCOPE("Render/Gizmos");
+		Gizmos::draw(view, projection);
+	}
 
 	//imgui Render
-	ImGui::Render();
-	ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+	{
+		PROFILE_SCOPE("Render/ImGui");
+		ImGui::Render();
+		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+	}
 
 	// glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
-	glfwSwapBuffers(m_window);
-	glfwPollEvents();
+	{
+		PROFILE_SCOPE("Render/Swap Buffers");
+		glfwSwapBuffers(m_window);
+		glfwPollEvents();
+	}
 }
 
 /// <summary>
@@ -200,34 +341,53 @@ void Scene::Render() {
 /// <param name="a_bCloseApplication">If we should close the application with our deinitalise</param>
 void Scene::DeInitialize(const bool a_bCloseApplication) {
 
+	//Finish recording the boids before they are deleted, and stop playing back in to them
+	TrajectoryRecorder::GetInstance()->StopRecording();
+	TrajectoryPlayer::GetInstance()->Close();
 	
 	//Delete all of our models, only is we are destroying
 	//the application, other wise we are likley to reuse them
 	if (a_bCloseApplication) {
+		InstancedRenderer::GetInstance()->ReleaseBuffers();
 		BoidSpawner::GetInstance()->UnloadAllModels();
 	}
 		
-	//Delete Shader
+	//Delete Shaders
 	delete m_ourShader;
+	m_ourShader = nullptr;
+	delete m_pInstancedShader;
+	m_pInstancedShader = nullptr;
 	
 	//Delete all of the entities that exist in the scene
-	std::map<const unsigned int, Entity*>::const_iterator xIter;
-	//Make a duplicate of the entity map so that we don't cause problems
-	//when itterating through it
-	std::map<const unsigned int, Entity*> existingEntityMap = Entity::GetEntityMap();
-	//Loop through all of the entities that exist and delete the
-	for (xIter = existingEntityMap.begin(); xIter != existingEntityMap.end(); ++xIter)
+	//Make a duplicate of the entity list so that we don't cause problems
+	//when itterating through it, deleting an entity removes it from the registry
+	const std::vector<Entity*> vpExistingEntities = Entity::GetEntityRegistry().GetEntities();
+	//Loop through all of the entities that exist and delete them
+	for (unsigned int i = 0; i < vpExistingEntities.size(); ++i)
 	{
-		Entity* pEntity = xIter->second;
-		delete pEntity;
+		delete vpExistingEntities[i];
 	}
-	existingEntityMap.clear();
+
+	//The spawner must not keep hold of the boids we just deleted
+	BoidSpawner::GetInstance()->ForgetAllBoids();
+
+	//Clear the spatial grid, it holds boids we just deleted
+	SpatialHashGrid::GetInstance()->Clear();
+
+	//Reset the fixed timestep, we start from no time simulated
+	m_fStepAccumulator = 0.0f;
+	m_fInterpolationAlpha = 1.0f;
 
 	//Destory Collision World
+	//Nothing may keep a pointer to it, the snapshot and trajectory code check it to see if the scene is initialized
 	delete m_pSceneCollisionWorld;
+	m_pSceneCollisionWorld = nullptr;
+	BoidSpawner::GetInstance()->SetCollisionWorld(nullptr);
 	
-	//Destory Gizmos
-	Gizmos::destroy();
+	//Destory Gizmos, these are never created when we are headless
+	if (!m_bHeadless) {
+		Gizmos::destroy();
+	}
 
 }
 
@@ -244,15 +404,17 @@ rp3d::CollisionWorld* Scene::GetCollisionWorld() const
 /// Generate a square bounds volume of the given size
 /// </summary>
 /// <param name="a_fBoundsSize">Size of the bounds to generate</param>
-void Scene::GenerateBoundsVolume(const float a_fBoundsSize) const
+void Scene::GenerateBoundsVolume(const float a_fBoundsSize)
 {
-	constexpr float fWallThickness = 0.5f;
 	constexpr int iWallCount = 6;
 
+	//Keep the size so that boids can be contained without having to raycast the walls
+	m_fBoundsSize = a_fBoundsSize;
+
 	//Array of the wall sizes and positions that we need
-	glm::vec3 aV3WallSizes[3] = {	glm::vec3(a_fBoundsSize + fWallThickness,a_fBoundsSize,fWallThickness + fWallThickness),
-									glm::vec3(a_fBoundsSize + fWallThickness,fWallThickness,a_fBoundsSize + fWallThickness),
-									glm::vec3(fWallThickness,	a_fBoundsSize + fWallThickness,a_fBoundsSize + fWallThickness) };
+	glm::vec3 aV3WallSizes[3] = {	glm::vec3(a_fBoundsSize + sc_fWallThickness,a_fBoundsSize,sc_fWallThickness + sc_fWallThickness),
+									glm::vec3(a_fBoundsSize + sc_fWallThickness,sc_fWallThickness,a_fBoundsSize + sc_fWallThickness),
+									glm::vec3(sc_fWallThickness,	a_fBoundsSize + sc_fWallThickness,a_fBoundsSize + sc_fWallThickness) };
 	glm::vec3 aV3WallPositions[iWallCount] = {	glm::vec3(0.f,0.f,a_fBoundsSize), glm::vec3(0.f,0.f,-a_fBoundsSize),
 										glm::vec3(0.f,a_fBoundsSize,0.0f), glm::vec3(0.f,-a_fBoundsSize,0.f),
 										glm::vec3(a_fBoundsSize,0.0f,0.0f), glm::vec3(-a_fBoundsSize,0.0f,0.f), };
@@ -266,6 +428,11 @@ void Scene::GenerateBoundsVolume(const float a_fBoundsSize) const
 		//Get the position of the current Wall
 		const glm::vec3 currentWallPosition = aV3WallPositions[i];
 
+		//The walls are in pairs along the Z, Y then X axis and their sizes are half extents, so the inside
+		//face of the wall is it's distance from the center less it's size along that axis
+		const int iWallAxis = 2 - (i / 2);
+		m_v3BoundsInnerExtent[iWallAxis] = glm::abs(currentWallPosition[iWallAxis]) - currentWallSize[iWallAxis];
+
 		//Create an entity to represent our wall
 		Entity* pWallEntity = new Entity();
 		pWallEntity->SetEntityType(ENTITY_TYPE::ENTITY_TYPE_CONTAINER);
@@ -277,6 +444,7 @@ void Scene::GenerateBoundsVolume(const float a_fBoundsSize) const
 
 		//Create a our collider to our entities can collider with this
 		ColliderComponent* pWallCollider = new ColliderComponent(pWallEntity, m_pSceneCollisionWorld);
+		pWallCollider->SetCollisionCategory(COLLISION_CATEGORY::COLLISION_CATEGORY_CONTAINER);
 		pWallCollider->AddBoxCollider(currentWallSize, glm::vec3(0, 0, 0));
 		pWallEntity->AddComponent(pWallCollider);
 		
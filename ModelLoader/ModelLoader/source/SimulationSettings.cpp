@@ -0,0 +1,184 @@
+#include "SimulationSettings.h"
+
+//C++ Includes
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+
+/// <summary>
+/// Fill the settings from the command line arguments, any argument
+/// that is not given keeps it's default value
+/// </summary>
+/// <param name="a_iArgCount">Number of arguments (argc)</param>
+/// <param name="a_pArgs">Arguments (argv)</param>
+/// <param name="a_xSettings">ByRef Settings to fill</param>
+/// <returns>If the arguments were valid and the application should run</returns>
+bool SimulationSettings::ParseCommandLine(const int a_iArgCount, char** a_pArgs, SimulationSettings& a_xSettings)
+{
+	//Start at 1, the first argument is the program name
+	for (int i = 1; i < a_iArgCount; ++i)
+	{
+		const char* szArg = a_pArgs[i];
+
+		//Flags without values
+		if (strcmp(szArg, "--headless") == 0)
+		{
+			a_xSettings.bHeadless = true;
+			continue;
+		}
+		if (strcmp(szArg, "--verlet") == 0)
+		{
+			a_xSettings.bNeighbourLists = true;
+			continue;
+		}
+		if (strcmp(szArg, "--update-golden") == 0)
+		{
+			a_xSettings.bUpdateGolden = true;
+			continue;
+		}
+		if (strcmp(szArg, "--help") == 0)
+		{
+			PrintUsage();
+			return false;
+		}
+
+		//All other arguments need a value after them
+		if (i + 1 >= a_iArgCount)
+		{
+			std::cout << "Missing value for argument " << szArg << std::endl;
+			PrintUsage();
+			return false;
+		}
+		const char* szValue = a_pArgs[++i];
+
+		if (strcmp(szArg, "--boids") == 0)
+		{
+			a_xSettings.iBoidCount = atoi(szValue);
+		}
+		else if (strcmp(szArg, "--bounds") == 0)
+		{
+			a_xSettings.iWorldBounds = atoi(szValue);
+		}
+		else if (strcmp(szArg, "--steps") == 0)
+		{
+			a_xSettings.iStepCount = atoi(szValue);
+		}
+		else if (strcmp(szArg, "--dt") == 0)
+		{
+			a_xSettings.fTimeStep = static_cast<float>(atof(szValue));
+		}
+		else if (strcmp(szArg, "--seed") == 0)
+		{
+			a_xSettings.uSeed = static_cast<unsigned int>(strtoul(szValue, nullptr, 10));
+		}
+		else if (strcmp(szArg, "--skin") == 0)
+		{
+			a_xSettings.fNeighbourListSkin = static_cast<float>(atof(szValue));
+		}
+		else if (strcmp(szArg, "--threads") == 0)
+		{
+			a_xSettings.iThreadCount = atoi(szValue);
+		}
+		else if (strcmp(szArg, "--trace") == 0)
+		{
+			a_xSettings.iTraceFrames = atoi(szValue);
+		}
+		else if (strcmp(szArg, "--trace-file") == 0)
+		{
+			a_xSettings.szTracePath = szValue;
+		}
+		else if (strcmp(szArg, "--load-snapshot") == 0)
+		{
+			a_xSettings.szLoadSnapshotPath = szValue;
+		}
+		else if (strcmp(szArg, "--save-snapshot") == 0)
+		{
+			a_xSettings.szSaveSnapshotPath = szValue;
+		}
+		else if (strcmp(szArg, "--record-trajectory") == 0)
+		{
+			a_xSettings.szTrajectoryPath = szValue;
+		}
+		else if (strcmp(szArg, "--replay") == 0)
+		{
+			a_xSettings.szReplayPath = szValue;
+		}
+		else if (strcmp(szArg, "--regression") == 0)
+		{
+			a_xSettings.szRegressionPath = szValue;
+		}
+		else if (strcmp(szArg, "--tolerance") == 0)
+		{
+			a_xSettings.szToleranceBuild = szValue;
+		}
+		else
+		{
+			std::cout << "Unknown argument " << szArg << std::endl;
+			PrintUsage();
+			return false;
+		}
+	}
+
+	//Check our values are sensible
+	if (a_xSettings.iBoidCount < 0 || a_xSettings.iWorldBounds <= 0 || a_xSettings.iStepCount < 0 ||
+		a_xSettings.fTimeStep <= 0.f || a_xSettings.iThreadCount < 0 || a_xSettings.iTraceFrames < 0 ||
+		a_xSettings.fNeighbourListSkin <= 0.f)
+	{
+		std::cout << "Invalid argument value" << std::endl;
+		PrintUsage();
+		return false;
+	}
+
+	if (a_xSettings.bUpdateGolden && a_xSettings.szRegressionPath.empty())
+	{
+		std::cout << "--update-golden needs a --regression directory" << std::endl;
+		PrintUsage();
+		return false;
+	}
+
+	//Golden files are only written for this build, and checked exactly
+	if (!a_xSettings.szToleranceBuild.empty() && (a_xSettings.szRegressionPath.empty() || a_xSettings.bUpdateGolden))
+	{
+		std::cout << "--tolerance needs a --regression directory and can not be used with --update-golden" << std::endl;
+		PrintUsage();
+		return false;
+	}
+
+	//Replays are drawn, so there is nothing to replay without a window
+	if (a_xSettings.bHeadless && !a_xSettings.szReplayPath.empty())
+	{
+		std::cout << "--replay can not be used with --headless" << std::endl;
+		PrintUsage();
+		return false;
+	}
+
+	return true;
+}
+
+/// <summary>
+/// Print the command line arguments that can be used
+/// </summary>
+void SimulationSettings::PrintUsage()
+{
+	std::cout << "Usage: ModelLoader [options]" << std::endl;
+	std::cout << "  --headless     Run the simulation with no window and print throughput" << std::endl;
+	std::cout << "  --boids N      Number of boids to spawn (default 100)" << std::endl;
+	std::cout << "  --bounds N     Size of the world bounds (default 20)" << std::endl;
+	std::cout << "  --steps N      Number of steps to simulate when headless (default 1000)" << std::endl;
+	std::cout << "  --dt F         Time each step simulates in seconds when headless (default 1/60)" << std::endl;
+	std::cout << "  --seed N       Seed for the RNG when headless (default 0)" << std::endl;
+	std::cout << "  --verlet       Find neighbours with Verlet lists that are only rebuilt when boids have moved far enough" << std::endl;
+	std::cout << "  --skin F       Distance past the neighbour radius that boids are kept on the Verlet lists (default 1)" << std::endl;
+	std::cout << "  --threads N    Number of job system threads, 0 for all hardware threads (default 0)" << std::endl;
+	std::cout << "  --trace N      Record a Chrome trace of the first N frames, or steps when headless (default 0)" << std::endl;
+	std::cout << "  --trace-file P Path to write the trace to (default trace.json)" << std::endl;
+	std::cout << "  --load-snapshot P Load a snapshot before stepping when headless, replacing the spawned boids" << std::endl;
+	std::cout << "  --save-snapshot P Save a snapshot after stepping when headless" << std::endl;
+	std::cout << "  --record-trajectory P Record the boids every step to a trajectory file when headless" << std::endl;
+	std::cout << "  --replay P     Play back a trajectory file instead of simulating, not when headless" << std::endl;
+	std::cout << "  --regression D Run the regression scenarios headless and check them against the golden files in D" << std::endl;
+	std::cout << "  --update-golden Write the golden files in the --regression directory from this build" << std::endl;
+	std::cout << "  --tolerance B  Check against build B's golden files (e.g gcc-x64-release). Only the state after the first step is compared within" << std::endl;
+	std::cout << "                 the tolerance, later steps are not checked. Exits with 2 if none failed but some only passed this way" << std::endl;
+	std::cout << "  --help         Show this message" << std::endl;
+}
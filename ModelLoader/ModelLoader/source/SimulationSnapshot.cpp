@@ -0,0 +1,455 @@
+#include "SimulationSnapshot.h"
+
+//C++ Includes
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+//GLM Includes
+#include <glm/glm.hpp>
+
+//Project Includes
+#include "MappedFile.h"
+#include "Scene.h"
+#include "DebugUI.h"
+#include "Entity.h"
+#include "BoidSystem.h"
+#include "BoidSpawner.h"
+#include "BrainComponent.h"
+#include "TransformComponent.h"
+#include "SpherePrimitiveComponent.h"
+#include "ObstacleSpawnerComponent.h"
+
+namespace
+{
+	/*
+	 * Snapshot file layout, all values are little endian:
+	 * SnapshotHeader
+	 * SnapshotSettings
+	 * glm::vec3[uBoidCount] positions
+	 * glm::vec3[uBoidCount] velocities
+	 * glm::vec3[uBoidCount] forwards
+	 * glm::vec3[uBoidCount] wander points
+	 * glm::mat3[uBoidCount] rotation of each boid's transform (right, up and forward rows)
+	 * uint32_t[uBoidCount] random streams
+	 * SnapshotObstacle[uObstacleCount]
+	 */
+	constexpr uint32_t sc_uSnapshotMagic = 0x504E5342; //"BSNP"
+	constexpr uint32_t sc_uSnapshotVersion = 1u;
+
+	struct SnapshotHeader
+	{
+		uint32_t uMagic;
+		uint32_t uVersion;
+		uint32_t uBoidCount;
+		uint32_t uObstacleCount;
+		float fBoundsSize; //Size the walls were generated with, the UI value does not change the walls until a restart
+		uint32_t uNextRandomStream; //Random stream the next boid added to the boid system gets
+		uint64_t uWanderRandomKey;
+		uint64_t uWanderRandomStep;
+		uint64_t uSpawnRandomKey;
+		uint32_t uSpawnCount;
+		uint32_t uPadding;
+	};
+
+	//UI values that change the simulation. The thread count and trace length are not saved
+	//as they belong to the machine that loads the snapshot
+	struct SnapshotSettings
+	{
+		float fContainmentForce;
+		float fCollisionAvoidForce;
+		float fSeparationForce;
+		float fAlignmentForce;
+		float fCohesionForce;
+		float fWanderForce;
+		float fWanderForward;
+		float fWanderJitter;
+		float fWanderRadius;
+		float fNeighbourRadius;
+		float fNeighbourListSkin;
+		float fFixedTimeStep;
+		int32_t iWorldBounds;
+		int32_t iBoidCount;
+		int32_t iMaxSubSteps;
+		uint8_t bNeighbourLists;
+		uint8_t bAnalyticContainment;
+		uint8_t bInterpolateTransforms;
+		uint8_t bInstancedRendering;
+		uint8_t bShowColliders;
+		uint8_t auPadding[3];
+	};
+
+	struct SnapshotObstacle
+	{
+		float afPosition[3];
+		float fRadius;
+	};
+
+	static_assert(sizeof(SnapshotHeader) == 56, "Snapshot header must have no hidden padding");
+	static_assert(sizeof(SnapshotSettings) == 68, "Snapshot settings must have no hidden padding");
+	static_assert(sizeof(SnapshotObstacle) == 16, "Snapshot obstacle must have no hidden padding");
+	//Boid arrays are copied straight in and out of the file
+	static_assert(sizeof(glm::vec3) == 12, "Boid vectors must be tightly packed");
+	static_assert(sizeof(glm::mat3) == 36, "Boid rotations must be tightly packed");
+
+	//Number of bytes each boid takes in the file
+	constexpr size_t sc_uBoidSize = sizeof(glm::vec3) * 4 + sizeof(glm::mat3) + sizeof(uint32_t);
+
+	//Copy the UI values we save out of the UI
+	SnapshotSettings GetSettings(const UIInputValues& a_xUIValues)
+	{
+		SnapshotSettings xSettings;
+		memset(&xSettings, 0, sizeof(xSettings));
+		xSettings.fContainmentForce = a_xUIValues.fInputContainmentForce.value;
+		xSettings.fCollisionAvoidForce = a_xUIValues.fInputCollisionAvoidForce.value;
+		xSettings.fSeparationForce = a_xUIValues.fInputSeparationForce.value;
+		xSettings.fAlignmentForce = a_xUIValues.fInputAlignmentForce.value;
+		xSettings.fCohesionForce = a_xUIValues.fInputCohesionForce.value;
+		xSettings.fWanderForce = a_xUIValues.fInputWanderForce.value;
+		xSettings.fWanderForward = a_xUIValues.fInputWanderForward.value;
+		xSettings.fWanderJitter = a_xUIValues.fInputWanderJitter.value;
+		xSettings.fWanderRadius = a_xUIValues.fInputWanderRadius.value;
+		xSettings.fNeighbourRadius = a_xUIValues.fInputNeighbourRadius.value;
+		xSettings.fNeighbourListSkin = a_xUIValues.fNeighbourListSkin.value;
+		xSettings.fFixedTimeStep = a_xUIValues.fFixedTimeStep.value;
+		xSettings.iWorldBounds = a_xUIValues.iInputWorldBounds.value;
+		xSettings.iBoidCount = a_xUIValues.iBoidCount.value;
+		xSettings.iMaxSubSteps = a_xUIValues.iMaxSubSteps.value;
+		xSettings.bNeighbourLists = a_xUIValues.bNeighbourLists ? 1u : 0u;
+		xSettings.bAnalyticContainment = a_xUIValues.bAnalyticContainment ? 1u : 0u;
+		xSettings.bInterpolateTransforms = a_xUIValues.bInterpolateTransforms ? 1u : 0u;
+		xSettings.bInstancedRendering = a_xUIValues.bInstancedRendering ? 1u : 0u;
+		xSettings.bShowColliders = a_xUIValues.bShowColliders ? 1u : 0u;
+		return xSettings;
+	}
+
+	//Check saved values the UI can not fix by clamping them, the world bounds and boid count are not
+	//limited to their sliders as headless runs set them from the command line
+	bool AreSettingsValid(const SnapshotSettings& a_xSettings)
+	{
+		const float afValues[] = { a_xSettings.fContainmentForce, a_xSettings.fCollisionAvoidForce, a_xSettings.fSeparationForce,
+			a_xSettings.fAlignmentForce, a_xSettings.fCohesionForce, a_xSettings.fWanderForce, a_xSettings.fWanderForward,
+			a_xSettings.fWanderJitter, a_xSettings.fWanderRadius, a_xSettings.fNeighbourRadius, a_xSettings.fNeighbourListSkin,
+			a_xSettings.fFixedTimeStep };
+		return std::all_of(std::begin(afValues), std::end(afValues), [](const float a_fValue) { return std::isfinite(a_fValue); }) &&
+			a_xSettings.iWorldBounds > 0 && a_xSettings.iBoidCount >= 0;
+	}
+
+	//Put a saved value in to a UI value, kept within the range of it's slider
+	template <class T>
+	void ApplyValue(UIRange<T>& a_xRange, const T a_value)
+	{
+		a_xRange.value = glm::clamp(a_value, a_xRange.min, a_xRange.max);
+	}
+
+	//Put saved values back in to the UI
+	void ApplySettings(const SnapshotSettings& a_xSettings, UIInputValues& a_xUIValues)
+	{
+		ApplyValue(a_xUIValues.fInputContainmentForce, a_xSettings.fContainmentForce);
+		ApplyValue(a_xUIValues.fInputCollisionAvoidForce, a_xSettings.fCollisionAvoidForce);
+		ApplyValue(a_xUIValues.fInputSeparationForce, a_xSettings.fSeparationForce);
+		ApplyValue(a_xUIValues.fInputAlignmentForce, a_xSettings.fAlignmentForce);
+		ApplyValue(a_xUIValues.fInputCohesionForce, a_xSettings.fCohesionForce);
+		ApplyValue(a_xUIValues.fInputWanderForce, a_xSettings.fWanderForce);
+		ApplyValue(a_xUIValues.fInputWanderForward, a_xSettings.fWanderForward);
+		ApplyValue(a_xUIValues.fInputWanderJitter, a_xSettings.fWanderJitter);
+		ApplyValue(a_xUIValues.fInputWanderRadius, a_xSettings.fWanderRadius);
+		ApplyValue(a_xUIValues.fInputNeighbourRadius, a_xSettings.fNeighbourRadius);
+		ApplyValue(a_xUIValues.fNeighbourListSkin, a_xSettings.fNeighbourListSkin);
+		ApplyValue(a_xUIValues.fFixedTimeStep, a_xSettings.fFixedTimeStep);
+		ApplyValue(a_xUIValues.iMaxSubSteps, static_cast<int>(a_xSettings.iMaxSubSteps));
+		a_xUIValues.iInputWorldBounds.value = a_xSettings.iWorldBounds;
+		a_xUIValues.iBoidCount.value = a_xSettings.iBoidCount;
+		a_xUIValues.bNeighbourLists = a_xSettings.bNeighbourLists != 0u;
+		a_xUIValues.bAnalyticContainment = a_xSettings.bAnalyticContainment != 0u;
+		a_xUIValues.bInterpolateTransforms = a_xSettings.bInterpolateTransforms != 0u;
+		a_xUIValues.bInstancedRendering = a_xSettings.bInstancedRendering != 0u;
+		a_xUIValues.bShowColliders = a_xSettings.bShowColliders != 0u;
+	}
+
+	//Write a whole array to a file in one go
+	template <class T>
+	bool WriteArray(FILE* a_pFile, const std::vector<T>& a_vValues)
+	{
+		return a_vValues.empty() || fwrite(a_vValues.data(), sizeof(T), a_vValues.size(), a_pFile) == a_vValues.size();
+	}
+
+	//Copy a whole array out of the mapped file in one go, moving the read position past it
+	template <class T>
+	void ReadArray(const unsigned char*& a_pData, std::vector<T>& a_vValues)
+	{
+		if (!a_vValues.empty()) {
+			memcpy(a_vValues.data(), a_pData, a_vValues.size() * sizeof(T));
+		}
+		a_pData += a_vValues.size() * sizeof(T);
+	}
+
+	//Check every float in a part of the mapped file is finite
+	bool AreFloatsFinite(const unsigned char* a_pData, const size_t a_uFloatCount)
+	{
+		for (size_t i = 0; i < a_uFloatCount; ++i)
+		{
+			float fValue;
+			memcpy(&fValue, a_pData + i * sizeof(float), sizeof(fValue));
+			if (!std::isfinite(fValue)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//Check the saved obstacles can be spawned, each must have a finite position and a positive radius
+	bool AreObstaclesValid(const unsigned char* a_pData, const uint32_t a_uObstacleCount)
+	{
+		for (uint32_t i = 0; i < a_uObstacleCount; ++i)
+		{
+			SnapshotObstacle xObstacle;
+			memcpy(&xObstacle, a_pData + i * sizeof(SnapshotObstacle), sizeof(xObstacle));
+			if (!AreFloatsFinite(a_pData + i * sizeof(SnapshotObstacle), sizeof(SnapshotObstacle) / sizeof(float)) || !(xObstacle.fRadius > 0.f)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	//Get the milliseconds since a time
+	double GetElapsedMs(const std::chrono::steady_clock::time_point a_xStartTime)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - a_xStartTime).count();
+	}
+}
+
+/// <summary>
+/// Save the current simulation to a file. The boid arrays are written straight from the boid
+/// system, only the rotations have to be gathered from the boid transforms first. The snapshot
+/// is written to a temporary file then renamed, so a snapshot is never left half written
+/// </summary>
+/// <param name="a_szPath">Path to save to</param>
+/// <returns>If the snapshot was saved</returns>
+bool SimulationSnapshot::Save(const std::string& a_szPath)
+{
+	const std::chrono::steady_clock::time_point xStartTime = std::chrono::steady_clock::now();
+
+	const Scene* pScene = Scene::GetInstance();
+	const BoidSystem* pBoidSystem = BoidSystem::GetInstance();
+	const BoidSpawner* pBoidSpawner = BoidSpawner::GetInstance();
+	const unsigned int uBoidCount = pBoidSystem->GetBoidCount();
+
+	//Rotations live in each boid's transform, everything else is already in arrays
+	std::vector<glm::mat3> vM3Rotations(uBoidCount, glm::mat3(1.0f));
+	for (unsigned int i = 0; i < uBoidCount; ++i)
+	{
+		const Entity* pOwner = pBoidSystem->m_vpBrains[i]->GetOwnerEntity();
+		const TransformComponent* pTransform = pOwner ? pOwner->GetComponent<TransformComponent*>() : nullptr;
+		if (pTransform) {
+			vM3Rotations[i] = glm::mat3(pTransform->GetEntityMatrix());
+		}
+	}
+
+	//Obstacles are the only other entities we need, the walls are rebuilt from the bounds size
+	std::vector<SnapshotObstacle> vxObstacles;
+	const std::vector<Entity*>& vpEntities = Entity::GetEntityRegistry().GetEntities();
+	for (unsigned int i = 0; i < vpEntities.size(); ++i)
+	{
+		const Entity* pEntity = vpEntities[i];
+		if (!pEntity || pEntity->GetEntityType() != ENTITY_TYPE::ENTITY_TYPE_OBSTACLE) {
+			continue;
+		}
+		TransformComponent* pTransform = pEntity->GetComponent<TransformComponent*>();
+		const SpherePrimitiveComponent* pSphere = pEntity->GetComponent<SpherePrimitiveComponent*>();
+		if (!pTransform || !pSphere) {
+			continue;
+		}
+		const glm::vec3 v3Position = pTransform->GetCurrentPosition();
+		const SnapshotObstacle xObstacle = { { v3Position.x, v3Position.y, v3Position.z }, pSphere->GetRadius() };
+		vxObstacles.push_back(xObstacle);
+	}
+
+	SnapshotHeader xHeader;
+	memset(&xHeader, 0, sizeof(xHeader));
+	xHeader.uMagic = sc_uSnapshotMagic;
+	xHeader.uVersion = sc_uSnapshotVersion;
+	xHeader.uBoidCount = uBoidCount;
+	xHeader.uObstacleCount = static_cast<uint32_t>(vxObstacles.size());
+	xHeader.fBoundsSize = pScene->m_fBoundsSize;
+	xHeader.uNextRandomStream = pBoidSystem->m_uNextRandomStream;
+	xHeader.uWanderRandomKey = pBoidSystem->m_uRandomKey;
+	xHeader.uWanderRandomStep = pBoidSystem->m_uRandomStep;
+	xHeader.uSpawnRandomKey = pBoidSpawner->m_uRandomKey;
+	xHeader.uSpawnCount = pBoidSpawner->m_uSpawnCount;
+	const SnapshotSettings xSettings = GetSettings(*DebugUI::GetInstance()->GetUIInputValues());
+
+	//Write to a temporary file and swap it in once it is complete
+	const std::string szTempPath = a_szPath + ".tmp";
+	FILE* pFile = fopen(szTempPath.c_str(), "wb");
+	if (!pFile) {
+		std::cout << ("SNAPSHOT::FAILED TO WRITE: " + a_szPath + "\n");
+		return false;
+	}
+	bool bWritten = fwrite(&xHeader, sizeof(xHeader), 1, pFile) == 1 && fwrite(&xSettings, sizeof(xSettings), 1, pFile) == 1;
+	bWritten = bWritten && WriteArray(pFile, pBoidSystem->m_vV3Positions) && WriteArray(pFile, pBoidSystem->m_vV3Velocities);
+	bWritten = bWritten && WriteArray(pFile, pBoidSystem->m_vV3Forwards) && WriteArray(pFile, pBoidSystem->m_vV3WanderPoints);
+	bWritten = bWritten && WriteArray(pFile, vM3Rotations) && WriteArray(pFile, pBoidSystem->m_vuRandomStreams);
+	bWritten = bWritten && WriteArray(pFile, vxObstacles);
+	bWritten = fclose(pFile) == 0 && bWritten;
+
+	remove(a_szPath.c_str());
+	if (!bWritten || rename(szTempPath.c_str(), a_szPath.c_str()) != 0) {
+		remove(szTempPath.c_str());
+		std::cout << ("SNAPSHOT::FAILED TO WRITE: " + a_szPath + "\n");
+		return false;
+	}
+
+	std::cout << "SNAPSHOT::SAVED: " << a_szPath << " (" << uBoidCount << " boids, " << vxObstacles.size()
+		<< " obstacles) in " << GetElapsedMs(xStartTime) << "ms" << std::endl;
+	return true;
+}
+
+/// <summary>
+/// Load a snapshot in to the current scene. The snapshot is mapped in to memory and the boid
+/// arrays are copied straight in to the boid system. Boids that already exist are reused and only
+/// the difference in boid count is spawned or destroyed. Obstacles are replaced and the walls are
+/// only rebuilt if the snapshot's bounds are a different size. The boids' collision bodies are
+/// moved by the next step, as moving them reinserts nearly every body in to the broadphase.
+/// Everything in the snapshot is checked before the scene is changed
+/// </summary>
+/// <param name="a_szPath">Path to load from</param>
+/// <returns>If the snapshot was loaded, the scene is not changed if the snapshot is missing or invalid</returns>
+bool SimulationSnapshot::Load(const std::string& a_szPath)
+{
+	const std::chrono::steady_clock::time_point xStartTime = std::chrono::steady_clock::now();
+
+	Scene* pScene = Scene::GetInstance();
+	if (!pScene->GetCollisionWorld()) {
+		std::cout << ("SNAPSHOT::SCENE NOT INITIALIZED: " + a_szPath + "\n");
+		return false;
+	}
+
+	MappedFile xFile;
+	if (!xFile.Open(a_szPath)) {
+		std::cout << ("SNAPSHOT::FAILED TO OPEN: " + a_szPath + "\n");
+		return false;
+	}
+
+	//Check the whole snapshot is there before we change anything
+	SnapshotHeader xHeader;
+	SnapshotSettings xSettings;
+	if (xFile.GetSize() < sizeof(xHeader) + sizeof(xSettings)) {
+		std::cout << ("SNAPSHOT::INVALID: " + a_szPath + "\n");
+		return false;
+	}
+	const unsigned char* pData = xFile.GetData();
+	memcpy(&xHeader, pData, sizeof(xHeader));
+	pData += sizeof(xHeader);
+	memcpy(&xSettings, pData, sizeof(xSettings));
+	pData += sizeof(xSettings);
+	const size_t uExpectedSize = sizeof(xHeader) + sizeof(xSettings) + static_cast<size_t>(xHeader.uBoidCount) * sc_uBoidSize +
+		static_cast<size_t>(xHeader.uObstacleCount) * sizeof(SnapshotObstacle);
+	if (xHeader.uMagic != sc_uSnapshotMagic || xHeader.uVersion != sc_uSnapshotVersion || xFile.GetSize() != uExpectedSize ||
+		!std::isfinite(xHeader.fBoundsSize) || xHeader.fBoundsSize <= 0.f || !AreSettingsValid(xSettings)) {
+		std::cout << ("SNAPSHOT::INVALID: " + a_szPath + "\n");
+		return false;
+	}
+
+	//Boid positions, velocities, forwards, wander points and rotations are all floats and come first in the
+	//file, the random streams after them can be any value. Obstacles come after the boids
+	const size_t uBoidFloatCount = static_cast<size_t>(xHeader.uBoidCount) * ((sc_uBoidSize - sizeof(uint32_t)) / sizeof(float));
+	const unsigned char* pObstacleData = pData + static_cast<size_t>(xHeader.uBoidCount) * sc_uBoidSize;
+	if (!AreFloatsFinite(pData, uBoidFloatCount) || !AreObstaclesValid(pObstacleData, xHeader.uObstacleCount)) {
+		std::cout << ("SNAPSHOT::INVALID: " + a_szPath + "\n");
+		return false;
+	}
+
+	//Boids can only be spawned in to a collision world, check we can get to the snapshot's count
+	BoidSpawner* pBoidSpawner = BoidSpawner::GetInstance();
+	BoidSystem* pBoidSystem = BoidSystem::GetInstance();
+	if (pBoidSystem->GetBoidCount() != pBoidSpawner->GetBoidCount() ||
+		(xHeader.uBoidCount > pBoidSpawner->GetBoidCount() && !pBoidSpawner->m_pBoidCollisionWorld)) {
+		std::cout << ("SNAPSHOT::FAILED TO SPAWN BOIDS: " + a_szPath + "\n");
+		return false;
+	}
+
+	//UI values first, boids are spawned and stepped using them
+	UIInputValues* pUIValues = DebugUI::GetInstance()->GetUIInputValues();
+	ApplySettings(xSettings, *pUIValues);
+	pUIValues->iBoidCount.value = static_cast<int>(xHeader.uBoidCount);
+
+	//Remove the obstacles, and the walls if they need to be a different size. Deleting an
+	//entity removes it from the registry so go through a copy of the list
+	const bool bRebuildBounds = xHeader.fBoundsSize != pScene->m_fBoundsSize;
+	const std::vector<Entity*> vpExistingEntities = Entity::GetEntityRegistry().GetEntities();
+	for (unsigned int i = 0; i < vpExistingEntities.size(); ++i)
+	{
+		Entity* pEntity = vpExistingEntities[i];
+		if (pEntity && (pEntity->GetEntityType() == ENTITY_TYPE::ENTITY_TYPE_OBSTACLE ||
+			(bRebuildBounds && pEntity->GetEntityType() == ENTITY_TYPE::ENTITY_TYPE_CONTAINER))) {
+			delete pEntity;
+		}
+	}
+	if (bRebuildBounds) {
+		pScene->GenerateBoundsVolume(xHeader.fBoundsSize);
+	}
+
+	//Get to the same number of boids, reusing the ones we have
+	pBoidSpawner->AdjustBoidCount(xHeader.uBoidCount);
+
+	//Copy the boid state in bulk, the order of the arrays matches the file layout
+	std::vector<glm::mat3> vM3Rotations(xHeader.uBoidCount);
+	ReadArray(pData, pBoidSystem->m_vV3Positions);
+	ReadArray(pData, pBoidSystem->m_vV3Velocities);
+	ReadArray(pData, pBoidSystem->m_vV3Forwards);
+	ReadArray(pData, pBoidSystem->m_vV3WanderPoints);
+	ReadArray(pData, vM3Rotations);
+	ReadArray(pData, pBoidSystem->m_vuRandomStreams);
+
+	//Every boid has moved, so the neighbour lists and collision bodies are no longer valid
+	pBoidSystem->m_bNeighbourListsDirty = true;
+	pBoidSystem->m_bCollisionBodiesDirty = true;
+
+	//Random numbers carry on from where they were, this is done after spawning as spawning draws from them
+	pBoidSystem->m_uRandomKey = xHeader.uWanderRandomKey;
+	pBoidSystem->m_uRandomStep = xHeader.uWanderRandomStep;
+	pBoidSystem->m_uNextRandomStream = xHeader.uNextRandomStream;
+	pBoidSpawner->m_uRandomKey = xHeader.uSpawnRandomKey;
+	pBoidSpawner->m_uSpawnCount = xHeader.uSpawnCount;
+
+	//Move the boid transforms, so boids are drawn where they are
+	for (unsigned int i = 0; i < xHeader.uBoidCount; ++i)
+	{
+		Entity* pOwner = pBoidSystem->m_vpBrains[i]->GetOwnerEntity();
+		if (!pOwner) {
+			continue;
+		}
+		TransformComponent* pTransform = pOwner->GetComponent<TransformComponent*>();
+		if (pTransform) {
+			pTransform->SetEntityMatrixRow(MATRIX_ROW::RIGHT_VECTOR, vM3Rotations[i][0]);
+			pTransform->SetEntityMatrixRow(MATRIX_ROW::UP_VECTOR, vM3Rotations[i][1]);
+			pTransform->SetEntityMatrixRow(MATRIX_ROW::FORWARD_VECTOR, vM3Rotations[i][2]);
+			pTransform->SetEntityMatrixRow(MATRIX_ROW::POSITION_VECTOR, pBoidSystem->m_vV3Positions[i]);
+			//Nothing to interpolate from until the next step
+			pTransform->StorePreviousMatrix();
+		}
+	}
+
+	//Put the obstacles back
+	for (uint32_t i = 0; i < xHeader.uObstacleCount; ++i)
+	{
+		SnapshotObstacle xObstacle;
+		memcpy(&xObstacle, pData, sizeof(xObstacle));
+		pData += sizeof(xObstacle);
+		ObstacleSpawnerComponent::SpawnObstacle(glm::vec3(xObstacle.afPosition[0], xObstacle.afPosition[1], xObstacle.afPosition[2]), xObstacle.fRadius);
+	}
+
+	//Start the fixed timestep from no time simulated
+	pScene->m_fStepAccumulator = 0.0f;
+	pScene->m_fInterpolationAlpha = 1.0f;
+
+	std::cout << "SNAPSHOT::LOADED: " << a_szPath << " (" << xHeader.uBoidCount << " boids, " << xHeader.uObstacleCount
+		<< " obstacles) in " << GetElapsedMs(xStartTime) << "ms" << std::endl;
+	return true;
+}
@@ -0,0 +1,206 @@
+#include "SpatialHashGrid.h"
+
+//C++ Includes
+#include <algorithm>
+#include <cmath>
+
+//Project Includes
+#include "FlockingKernel.h"
+
+/// <summary>
+/// Create the spatial hash grid
+/// </summary>
+SpatialHashGrid::SpatialHashGrid() :
+	m_fCellSize(1.0f),
+	m_fInvCellSize(1.0f),
+	m_uBucketMask(0u)
+{
+}
+
+/// <summary>
+/// Rebuild the grid from the current positions of all of the boids.
+/// Should be called once per frame before any boids query the grid
+/// </summary>
+/// <param name="a_vV3Positions">Position of each boid, indexed by boid index</param>
+/// <param name="a_vV3Velocities">Velocity of each boid, indexed by boid index</param>
+/// <param name="a_fCellSize">Size of each grid cell, this should be the neighbour radius so that
+/// the 27 cells around a boid cover everything within that radius</param>
+void SpatialHashGrid::Rebuild(const std::vector<glm::vec3>& a_vV3Positions, const std::vector<glm::vec3>& a_vV3Velocities, const float a_fCellSize)
+{
+	m_fCellSize = std::max(a_fCellSize, mc_fMinCellSize);
+	m_fInvCellSize = 1.0f / m_fCellSize;
+
+	//Gather all of the boids, caching the values
+	//that neighbour queries need
+	const unsigned int uBoidCount = static_cast<unsigned int>(std::min(a_vV3Positions.size(), a_vV3Velocities.size()));
+	m_vUnsortedEntries.resize(uBoidCount);
+	for (unsigned int i = 0; i < uBoidCount; ++i)
+	{
+		SpatialGridEntry& xEntry = m_vUnsortedEntries[i];
+		xEntry.m_uBoidIndex = i;
+		xEntry.m_v3Position = a_vV3Positions[i];
+		xEntry.m_v3Velocity = a_vV3Velocities[i];
+	}
+
+	//Size the bucket table to the next power of 2 that is at least double the number
+	//of entries, this keeps the number of hash collisions between cells low
+	const unsigned int uEntryCount = static_cast<unsigned int>(m_vUnsortedEntries.size());
+	unsigned int uBucketCount = mc_uMinBucketCount;
+	while (uBucketCount < uEntryCount * 2u)
+	{
+		uBucketCount <<= 1u;
+	}
+	m_uBucketMask = uBucketCount - 1u;
+
+	//Counting sort the entries by bucket - first count how many entries
+	//land in each bucket
+	m_vBucketStart.assign(uBucketCount + 1u, 0u);
+	m_vEntryBuckets.resize(uEntryCount);
+	for (unsigned int i = 0; i < uEntryCount; ++i)
+	{
+		const unsigned int uBucket = GetCellBucket(GetCellCoord(m_vUnsortedEntries[i].m_v3Position));
+		m_vEntryBuckets[i] = uBucket;
+		++m_vBucketStart[uBucket + 1u];
+	}
+
+	//Prefix sum the counts so each bucket knows where it starts
+	for (unsigned int i = 0; i < uBucketCount; ++i)
+	{
+		m_vBucketStart[i + 1u] += m_vBucketStart[i];
+	}
+
+	//Scatter the entries in to their buckets, using a copy of the
+	//start indices as a write cursor for each bucket
+	m_vEntries.resize(uEntryCount);
+	m_vBucketCursor.assign(m_vBucketStart.begin(), m_vBucketStart.end() - 1);
+	for (unsigned int i = 0; i < uEntryCount; ++i)
+	{
+		m_vEntries[m_vBucketCursor[m_vEntryBuckets[i]]++] = m_vUnsortedEntries[i];
+	}
+}
+
+/// <summary>
+/// Remove all of the entries from the grid
+/// </summary>
+void SpatialHashGrid::Clear()
+{
+	m_vEntries.clear();
+	m_vUnsortedEntries.clear();
+	m_vEntryBuckets.clear();
+	m_vBucketCursor.clear();
+	m_vBucketStart.assign(1u, 0u);
+	m_uBucketMask = 0u;
+}
+
+/// <summary>
+/// Gets all of the entries in the 27 cells surrounding a position. These are candidates
+/// only, callers still need to check the distance to each entry against their radius
+/// </summary>
+/// <param name="a_v3Position">Position to search around</param>
+/// <param name="a_vpNeighbours">ByRef list to fill with candidates, cleared before it is filled</param>
+void SpatialHashGrid::QueryNeighbours(const glm::vec3& a_v3Position, std::vector<const SpatialGridEntry*>& a_vpNeighbours) const
+{
+	a_vpNeighbours.clear();
+	if (m_vEntries.empty())
+	{
+		return;
+	}
+
+	unsigned int auBuckets[27];
+	const unsigned int uBucketCount = GetNeighbourBuckets(a_v3Position, auBuckets);
+	for (unsigned int b = 0; b < uBucketCount; ++b)
+	{
+		//Add all of the entries in this bucket
+		const unsigned int uBucket = auBuckets[b];
+		for (unsigned int i = m_vBucketStart[uBucket]; i < m_vBucketStart[uBucket + 1u]; ++i)
+		{
+			a_vpNeighbours.push_back(&m_vEntries[i]);
+		}
+	}
+}
+
+/// <summary>
+/// Gets all of the entries in the 27 cells surrounding a position, written straight in to the blocks
+/// the flocking kernel reads so the candidates are not copied twice. These are candidates only, the
+/// kernel still checks the distance to each one
+/// </summary>
+/// <param name="a_v3Position">Position to search around</param>
+/// <param name="a_uExcludeBoidIndex">Index of a boid to leave out, the boid we are searching for</param>
+/// <param name="a_xCandidates">ByRef candidates to fill, cleared before they are filled</param>
+void SpatialHashGrid::QueryNeighbours(const glm::vec3& a_v3Position, const unsigned int a_uExcludeBoidIndex, FlockingCandidates& a_xCandidates) const
+{
+	a_xCandidates.Clear();
+	if (m_vEntries.empty())
+	{
+		return;
+	}
+
+	unsigned int auBuckets[27];
+	const unsigned int uBucketCount = GetNeighbourBuckets(a_v3Position, auBuckets);
+	for (unsigned int b = 0; b < uBucketCount; ++b)
+	{
+		const unsigned int uBucket = auBuckets[b];
+		for (unsigned int i = m_vBucketStart[uBucket]; i < m_vBucketStart[uBucket + 1u]; ++i)
+		{
+			const SpatialGridEntry& xEntry = m_vEntries[i];
+			if (xEntry.m_uBoidIndex != a_uExcludeBoidIndex)
+			{
+				a_xCandidates.Add(xEntry.m_v3Position, xEntry.m_v3Velocity);
+			}
+		}
+	}
+}
+
+/// <summary>
+/// Gets the buckets of the 27 cells surrounding a position. Different cells can hash to the
+/// same bucket, so each bucket is only returned once to avoid returning an entry twice
+/// </summary>
+/// <param name="a_v3Position">Position to search around</param>
+/// <param name="a_auBuckets">ByRef array to fill with the buckets</param>
+/// <returns>Number of buckets</returns>
+unsigned int SpatialHashGrid::GetNeighbourBuckets(const glm::vec3& a_v3Position, unsigned int (&a_auBuckets)[27]) const
+{
+	unsigned int uBucketCount = 0u;
+	const glm::ivec3 v3CenterCell = GetCellCoord(a_v3Position);
+	for (int x = -1; x <= 1; ++x)
+	{
+		for (int y = -1; y <= 1; ++y)
+		{
+			for (int z = -1; z <= 1; ++z)
+			{
+				const unsigned int uBucket = GetCellBucket(v3CenterCell + glm::ivec3(x, y, z));
+				if (std::find(a_auBuckets, a_auBuckets + uBucketCount, uBucket) == a_auBuckets + uBucketCount)
+				{
+					a_auBuckets[uBucketCount++] = uBucket;
+				}
+			}
+		}
+	}
+	return uBucketCount;
+}
+
+/// <summary>
+/// Gets the integer coordinate of the cell that a position is in
+/// </summary>
+/// <param name="a_v3Position">World Position</param>
+/// <returns>Cell Coordinate</returns>
+glm::ivec3 SpatialHashGrid::GetCellCoord(const glm::vec3& a_v3Position) const
+{
+	return glm::ivec3(static_cast<int>(std::floor(a_v3Position.x * m_fInvCellSize)),
+					  static_cast<int>(std::floor(a_v3Position.y * m_fInvCellSize)),
+					  static_cast<int>(std::floor(a_v3Position.z * m_fInvCellSize)));
+}
+
+/// <summary>
+/// Hashes a cell coordinate in to a bucket in the bucket table
+/// </summary>
+/// <param name="a_v3CellCoord">Cell Coordinate</param>
+/// <returns>Index of the bucket this cell is stored in</returns>
+unsigned int SpatialHashGrid::GetCellBucket(const glm::ivec3& a_v3CellCoord) const
+{
+	//Large primes from "Optimized Spatial Hashing for Collision Detection of Deformable Objects" (Teschner et al.)
+	const unsigned int uHash = (static_cast<unsigned int>(a_v3CellCoord.x) * 73856093u) ^
+							   (static_cast<unsigned int>(a_v3CellCoord.y) * 19349663u) ^
+							   (static_cast<unsigned int>(a_v3CellCoord.z) * 83492791u);
+	return uHash & m_uBucketMask;
+}
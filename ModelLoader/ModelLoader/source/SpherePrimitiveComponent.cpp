@@ -9,6 +9,9 @@
 //Typedefs
 typedef PrimitiveComponent PARENT;
 
+//Allocate from a pool
+DEFINE_POOLED_ALLOCATION(SpherePrimitiveComponent)
+
 /// <summary>
 /// Create a sphere primative
 /// </summary>
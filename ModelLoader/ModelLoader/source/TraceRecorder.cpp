@@ -0,0 +1,204 @@
+#include "TraceRecorder.h"
+
+//C++ Includes
+#include <cstdio>
+
+namespace
+{
+	/// <summary>
+	/// Write a string to a JSON file, escaping any characters JSON does not allow
+	/// </summary>
+	void WriteJsonString(FILE* a_pFile, const std::string& a_szString)
+	{
+		fputc('"', a_pFile);
+		for (const char c : a_szString)
+		{
+			if (c == '"' || c == '\\') {
+				fputc('\\', a_pFile);
+				fputc(c, a_pFile);
+			}
+			else if (static_cast<unsigned char>(c) < 0x20) {
+				fprintf(a_pFile, "\\u%04x", static_cast<unsigned int>(c));
+			}
+			else {
+				fputc(c, a_pFile);
+			}
+		}
+		fputc('"', a_pFile);
+	}
+}
+
+/// <summary>
+/// Create the trace recorder
+/// </summary>
+TraceRecorder::TraceRecorder() :
+	m_bRecording(false),
+	m_uFramesRemaining(0u)
+{
+}
+
+/// <summary>
+/// Start recording events, any events from the last recording are thrown away
+/// </summary>
+/// <param name="a_uFrameCount">Number of frames to record</param>
+/// <param name="a_szPath">Path to write the trace to</param>
+void TraceRecorder::StartRecording(const unsigned int a_uFrameCount, const std::string& a_szPath)
+{
+	if (IsRecording() || a_uFrameCount == 0) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> xLock(m_xThreadsMutex);
+		for (unsigned int i = 0; i < m_vpThreadEvents.size(); ++i)
+		{
+			std::lock_guard<std::mutex> xThreadLock(m_vpThreadEvents[i]->xMutex);
+			m_vpThreadEvents[i]->vEvents.clear();
+		}
+	}
+
+	m_uFramesRemaining = a_uFrameCount;
+	m_szTracePath = a_szPath;
+	m_xRecordStartTime = std::chrono::steady_clock::now();
+	m_bRecording.store(true);
+
+	printf("TRACE::RECORDING: %u frames\n", a_uFrameCount);
+}
+
+/// <summary>
+/// Stop recording and write the trace to the path we were given
+/// </summary>
+void TraceRecorder::StopRecording()
+{
+	if (!IsRecording()) {
+		return;
+	}
+
+	m_bRecording.store(false);
+	m_uFramesRemaining = 0u;
+	WriteTrace(m_szTracePath);
+}
+
+/// <summary>
+/// Mark the end of a frame, once the last frame we were asked to record
+/// has finished the trace is written
+/// </summary>
+void TraceRecorder::EndFrame()
+{
+	if (!IsRecording()) {
+		return;
+	}
+
+	if (--m_uFramesRemaining == 0u) {
+		StopRecording();
+	}
+}
+
+/// <summary>
+/// Add an event that has finished to the calling thread's events
+/// </summary>
+/// <param name="a_szName">Name of the event, must stay valid until the trace is written</param>
+/// <param name="a_szCategory">Category of the event, must stay valid until the trace is written</param>
+/// <param name="a_xStartTime">Time the event started</param>
+/// <param name="a_xEndTime">Time the event finished</param>
+/// <param name="a_szDetail">Extra info to show with the event</param>
+void TraceRecorder::AddEvent(const char* a_szName, const char* a_szCategory, const std::chrono::steady_clock::time_point a_xStartTime,
+	const std::chrono::steady_clock::time_point a_xEndTime, const std::string& a_szDetail)
+{
+	if (!IsRecording()) {
+		return;
+	}
+
+	TraceEvent xEvent;
+	xEvent.szName = a_szName;
+	xEvent.szCategory = a_szCategory;
+	xEvent.iStartNs = std::chrono::duration_cast<std::chrono::nanoseconds>(a_xStartTime - m_xRecordStartTime).count();
+	xEvent.iDurationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(a_xEndTime - a_xStartTime).count();
+	xEvent.szDetail = a_szDetail;
+
+	ThreadEvents* pThreadEvents = GetThreadEvents();
+	std::lock_guard<std::mutex> xLock(pThreadEvents->xMutex);
+	pThreadEvents->vEvents.push_back(std::move(xEvent));
+}
+
+/// <summary>
+/// Set the name that the calling thread is shown with
+/// </summary>
+/// <param name="a_szName">Name of the thread</param>
+void TraceRecorder::SetThreadName(const std::string& a_szName)
+{
+	ThreadEvents* pThreadEvents = GetThreadEvents();
+	std::lock_guard<std::mutex> xLock(pThreadEvents->xMutex);
+	pThreadEvents->szThreadName = a_szName;
+}
+
+/// <summary>
+/// Get the events of the calling thread, creating them the first time it is used
+/// </summary>
+/// <returns>Events of this thread</returns>
+TraceRecorder::ThreadEvents* TraceRecorder::GetThreadEvents()
+{
+	static thread_local ThreadEvents* s_pThreadEvents = nullptr;
+	if (!s_pThreadEvents) {
+		//Events are kept after the thread stops so they can still be written
+		std::lock_guard<std::mutex> xLock(m_xThreadsMutex);
+		m_vpThreadEvents.emplace_back(new ThreadEvents());
+		s_pThreadEvents = m_vpThreadEvents.back().get();
+		s_pThreadEvents->uThreadId = static_cast<unsigned int>(m_vpThreadEvents.size());
+		s_pThreadEvents->szThreadName = "Thread " + std::to_string(s_pThreadEvents->uThreadId);
+	}
+	return s_pThreadEvents;
+}
+
+/// <summary>
+/// Write every recorded event as Chrome trace event JSON, times are written in microseconds
+/// </summary>
+/// <param name="a_szPath">Path of the file to write</param>
+/// <returns>If the trace was written</returns>
+bool TraceRecorder::WriteTrace(const std::string& a_szPath)
+{
+	FILE* pFile = fopen(a_szPath.c_str(), "w");
+	if (!pFile) {
+		printf("TRACE::FAILED TO WRITE: %s\n", a_szPath.c_str());
+		return false;
+	}
+
+	fprintf(pFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	bool bFirstEvent = true;
+	size_t uEventCount = 0;
+
+	std::lock_guard<std::mutex> xLock(m_xThreadsMutex);
+	for (unsigned int i = 0; i < m_vpThreadEvents.size(); ++i)
+	{
+		ThreadEvents* pThreadEvents = m_vpThreadEvents[i].get();
+		std::lock_guard<std::mutex> xThreadLock(pThreadEvents->xMutex);
+
+		//Name the thread, threads are sorted by their ID
+		fprintf(pFile, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", bFirstEvent ? "" : ",\n", pThreadEvents->uThreadId);
+		WriteJsonString(pFile, pThreadEvents->szThreadName);
+		fprintf(pFile, "}},\n{\"name\":\"thread_sort_index\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"sort_index\":%u}}", pThreadEvents->uThreadId, pThreadEvents->uThreadId);
+		bFirstEvent = false;
+
+		for (const TraceEvent& xEvent : pThreadEvents->vEvents)
+		{
+			fprintf(pFile, ",\n{\"name\":");
+			WriteJsonString(pFile, xEvent.szName);
+			fprintf(pFile, ",\"cat\":");
+			WriteJsonString(pFile, xEvent.szCategory);
+			fprintf(pFile, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u", xEvent.iStartNs / 1000.0, xEvent.iDurationNs / 1000.0, pThreadEvents->uThreadId);
+			if (!xEvent.szDetail.empty()) {
+				fprintf(pFile, ",\"args\":{\"detail\":");
+				WriteJsonString(pFile, xEvent.szDetail);
+				fprintf(pFile, "}");
+			}
+			fprintf(pFile, "}");
+		}
+		uEventCount += pThreadEvents->vEvents.size();
+	}
+
+	fprintf(pFile, "\n]}\n");
+	fclose(pFile);
+
+	printf("TRACE::WROTE: %s (%zu events)\n", a_szPath.c_str(), uEventCount);
+	return true;
+}
@@ -0,0 +1,199 @@
+#include "TrajectoryCodec.h"
+
+//C++ Includes
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace
+{
+	//Largest value of a quantized position and of a quantized quaternion component
+	constexpr float sc_fPositionSteps = 65535.f;
+	constexpr float sc_fRotationSteps = 32767.f;
+
+	//A zig-zag encoded 16 bit value never needs more than 3 bytes as a varint
+	constexpr unsigned int sc_uMaxVarintBytes = 3u;
+
+	/// <summary>
+	/// Quantize a position on one axis to [0, 65535] across [-extent, extent]
+	/// </summary>
+	uint16_t QuantizePosition(const float a_fPosition, const float a_fExtent)
+	{
+		const float fScaled = (a_fPosition + a_fExtent) * (sc_fPositionSteps / (2.f * a_fExtent));
+		return static_cast<uint16_t>(std::min(std::max(fScaled, 0.f), sc_fPositionSteps) + 0.5f);
+	}
+
+	/// <summary>
+	/// Quantize a quaternion component in [-1, 1] to a signed 16 bit value, kept in the bits of an unsigned one
+	/// </summary>
+	uint16_t QuantizeRotation(const float a_fComponent)
+	{
+		return static_cast<uint16_t>(static_cast<int16_t>(std::lround(std::min(std::max(a_fComponent, -1.f), 1.f) * sc_fRotationSteps)));
+	}
+
+	/// <summary>
+	/// Get the value that a frame is predicted to have from the two frames before it, assuming
+	/// it carries on changing at the same rate. Wraps around so encoding is lossless
+	/// </summary>
+	uint16_t Predict(const uint16_t a_uPrevious, const uint16_t a_uBeforePrevious)
+	{
+		return static_cast<uint16_t>(2u * a_uPrevious - a_uBeforePrevious);
+	}
+}
+
+/// <summary>
+/// Quantize a boid's position and rotation. A quaternion and it's negative are the same rotation, so
+/// the sign is picked to be closest to the boid's last frame, which keeps the differences between frames small
+/// </summary>
+/// <param name="a_v3Position">Position of the boid</param>
+/// <param name="a_qRotation">Rotation of the boid</param>
+/// <param name="a_fPositionExtent">Distance from the center of the world that positions are quantized to</param>
+/// <param name="a_puPreviousValues">Values of the boid in the frame before, or nullptr if this is the first frame</param>
+/// <param name="a_puValues">Values to write to, sc_uValuesPerBoid of them</param>
+void TrajectoryCodec::QuantizeBoid(const glm::vec3& a_v3Position, const glm::quat& a_qRotation, const float a_fPositionExtent,
+	const uint16_t* a_puPreviousValues, uint16_t* a_puValues)
+{
+	a_puValues[0] = QuantizePosition(a_v3Position.x, a_fPositionExtent);
+	a_puValues[1] = QuantizePosition(a_v3Position.y, a_fPositionExtent);
+	a_puValues[2] = QuantizePosition(a_v3Position.z, a_fPositionExtent);
+
+	glm::quat qRotation = glm::normalize(a_qRotation);
+	bool bFlip = qRotation.w < 0.f;
+	if (a_puPreviousValues) {
+		const float fPreviousDot = qRotation.x * static_cast<int16_t>(a_puPreviousValues[3]) + qRotation.y * static_cast<int16_t>(a_puPreviousValues[4]) +
+			qRotation.z * static_cast<int16_t>(a_puPreviousValues[5]) + qRotation.w * static_cast<int16_t>(a_puPreviousValues[6]);
+		bFlip = fPreviousDot < 0.f;
+	}
+	if (bFlip) {
+		qRotation = -qRotation;
+	}
+
+	a_puValues[3] = QuantizeRotation(qRotation.x);
+	a_puValues[4] = QuantizeRotation(qRotation.y);
+	a_puValues[5] = QuantizeRotation(qRotation.z);
+	a_puValues[6] = QuantizeRotation(qRotation.w);
+}
+
+/// <summary>
+/// Get a boid's position and rotation back from it's quantized values
+/// </summary>
+/// <param name="a_puValues">Quantized values of the boid</param>
+/// <param name="a_fPositionExtent">Distance from the center of the world that positions were quantized to</param>
+/// <param name="a_v3Position">Position of the boid</param>
+/// <param name="a_qRotation">Rotation of the boid</param>
+void TrajectoryCodec::DequantizeBoid(const uint16_t* a_puValues, const float a_fPositionExtent, glm::vec3& a_v3Position, glm::quat& a_qRotation)
+{
+	const float fStepSize = (2.f * a_fPositionExtent) / sc_fPositionSteps;
+	a_v3Position = glm::vec3(a_puValues[0], a_puValues[1], a_puValues[2]) * fStepSize - glm::vec3(a_fPositionExtent);
+
+	const glm::quat qRotation(static_cast<int16_t>(a_puValues[6]) / sc_fRotationSteps, static_cast<int16_t>(a_puValues[3]) / sc_fRotationSteps,
+		static_cast<int16_t>(a_puValues[4]) / sc_fRotationSteps, static_cast<int16_t>(a_puValues[5]) / sc_fRotationSteps);
+	const float fLength = glm::length(qRotation);
+	a_qRotation = fLength > 0.f ? qRotation / fLength : glm::quat(1.f, 0.f, 0.f, 0.f);
+}
+
+/// <summary>
+/// Encode the quantized frames of a chunk. The first frame is stored as is, so a chunk can be decoded
+/// without any other chunk. Each value of a later frame is stored as the difference from it's prediction
+/// </summary>
+/// <param name="a_puFrames">Quantized values of every frame, one frame after another</param>
+/// <param name="a_uFrameCount">Number of frames in the chunk</param>
+/// <param name="a_uBoidCount">Number of boids in each frame</param>
+/// <param name="a_vuEncoded">Buffer to add the encoded frames to</param>
+void TrajectoryCodec::EncodeChunk(const uint16_t* a_puFrames, const unsigned int a_uFrameCount, const unsigned int a_uBoidCount, std::vector<uint8_t>& a_vuEncoded)
+{
+	const size_t uValueCount = static_cast<size_t>(a_uBoidCount) * sc_uValuesPerBoid;
+	if (a_uFrameCount == 0u || uValueCount == 0u) {
+		return;
+	}
+
+	//Key frame
+	const size_t uKeyFrameStart = a_vuEncoded.size();
+	a_vuEncoded.resize(uKeyFrameStart + uValueCount * sizeof(uint16_t));
+	memcpy(&a_vuEncoded[uKeyFrameStart], a_puFrames, uValueCount * sizeof(uint16_t));
+
+	//Make room for the largest the other frames could be, so we do not have to check the size as we write
+	const size_t uDeltaStart = a_vuEncoded.size();
+	a_vuEncoded.resize(uDeltaStart + (a_uFrameCount - 1u) * uValueCount * sc_uMaxVarintBytes);
+	uint8_t* pOutput = a_vuEncoded.data() + uDeltaStart;
+
+	for (unsigned int uFrame = 1u; uFrame < a_uFrameCount; ++uFrame)
+	{
+		const uint16_t* puFrame = a_puFrames + uFrame * uValueCount;
+		const uint16_t* puPrevious = puFrame - uValueCount;
+		//With only one frame before this one, predict that nothing changes
+		const uint16_t* puBeforePrevious = uFrame > 1u ? puPrevious - uValueCount : puPrevious;
+
+		for (size_t i = 0; i < uValueCount; ++i)
+		{
+			//Zig-zag the difference so small negative differences are small numbers
+			const uint16_t uDifference = static_cast<uint16_t>(puFrame[i] - Predict(puPrevious[i], puBeforePrevious[i]));
+			unsigned int uZigZag = static_cast<uint16_t>((uDifference << 1) ^ static_cast<uint16_t>(static_cast<int16_t>(uDifference) >> 15));
+
+			//Varint, 7 bits per byte with the top bit set if there are more bytes
+			while (uZigZag >= 0x80u)
+			{
+				*pOutput++ = static_cast<uint8_t>(uZigZag | 0x80u);
+				uZigZag >>= 7;
+			}
+			*pOutput++ = static_cast<uint8_t>(uZigZag);
+		}
+	}
+
+	a_vuEncoded.resize(pOutput - a_vuEncoded.data());
+}
+
+/// <summary>
+/// Decode every frame of a chunk, undoing EncodeChunk
+/// </summary>
+/// <param name="a_puEncoded">Encoded frames</param>
+/// <param name="a_uEncodedSize">Size of the encoded frames</param>
+/// <param name="a_uFrameCount">Number of frames in the chunk</param>
+/// <param name="a_uBoidCount">Number of boids in each frame</param>
+/// <param name="a_puFrames">Values to write every frame to, one frame after another</param>
+/// <returns>If the chunk was decoded, false if the data ends early or has bytes left over</returns>
+bool TrajectoryCodec::DecodeChunk(const uint8_t* a_puEncoded, const size_t a_uEncodedSize, const unsigned int a_uFrameCount, const unsigned int a_uBoidCount, uint16_t* a_puFrames)
+{
+	const size_t uValueCount = static_cast<size_t>(a_uBoidCount) * sc_uValuesPerBoid;
+	if (a_uFrameCount == 0u || uValueCount == 0u) {
+		return a_uEncodedSize == 0u;
+	}
+
+	//Key frame
+	const size_t uKeyFrameSize = uValueCount * sizeof(uint16_t);
+	if (a_uEncodedSize < uKeyFrameSize) {
+		return false;
+	}
+	memcpy(a_puFrames, a_puEncoded, uKeyFrameSize);
+
+	const uint8_t* pInput = a_puEncoded + uKeyFrameSize;
+	const uint8_t* pInputEnd = a_puEncoded + a_uEncodedSize;
+
+	for (unsigned int uFrame = 1u; uFrame < a_uFrameCount; ++uFrame)
+	{
+		uint16_t* puFrame = a_puFrames + uFrame * uValueCount;
+		const uint16_t* puPrevious = puFrame - uValueCount;
+		const uint16_t* puBeforePrevious = uFrame > 1u ? puPrevious - uValueCount : puPrevious;
+
+		for (size_t i = 0; i < uValueCount; ++i)
+		{
+			unsigned int uZigZag = 0u;
+			unsigned int uShift = 0u;
+			uint8_t uByte = 0x80u;
+			while (uByte & 0x80u)
+			{
+				if (pInput == pInputEnd || uShift >= sc_uMaxVarintBytes * 7u) {
+					return false;
+				}
+				uByte = *pInput++;
+				uZigZag |= static_cast<unsigned int>(uByte & 0x7Fu) << uShift;
+				uShift += 7u;
+			}
+
+			const uint16_t uDifference = static_cast<uint16_t>((uZigZag >> 1) ^ (0u - (uZigZag & 1u)));
+			puFrame[i] = static_cast<uint16_t>(Predict(puPrevious[i], puBeforePrevious[i]) + uDifference);
+		}
+	}
+
+	return pInput == pInputEnd;
+}
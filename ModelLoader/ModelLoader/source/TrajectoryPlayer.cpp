@@ -0,0 +1,260 @@
+#include "TrajectoryPlayer.h"
+
+//C++ Includes
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+//Project Includes
+#include "Scene.h"
+#include "Entity.h"
+#include "DebugUI.h"
+#include "BoidSystem.h"
+#include "BoidSpawner.h"
+#include "BrainComponent.h"
+#include "TransformComponent.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "TraceRecorder.h"
+
+/// <summary>
+/// Create the trajectory player
+/// </summary>
+TrajectoryPlayer::TrajectoryPlayer() :
+	m_xHeader(),
+	m_uDecodedChunk(sc_uNoChunk),
+	m_xDecodedChunkHeader(),
+	m_bPlaying(false),
+	m_uCurrentFrame(0u),
+	m_fFrameTime(0.0f),
+	m_fInterpolationAlpha(1.0f)
+{
+}
+
+/// <summary>
+/// Open a trajectory file and show it's first frame. Only the header and the chunk index are
+/// read, chunks are decoded from the mapped file when a frame in them is shown
+/// </summary>
+/// <param name="a_szPath">Path of the trajectory to open</param>
+/// <returns>If the trajectory was opened, the scene is not changed if the file is missing or invalid</returns>
+bool TrajectoryPlayer::Open(const std::string& a_szPath)
+{
+	Close();
+	if (!Scene::GetInstance()->GetCollisionWorld()) {
+		return false;
+	}
+
+	if (!m_xFile.Open(a_szPath)) {
+		printf("TRAJECTORY::FAILED TO OPEN: %s\n", a_szPath.c_str());
+		return false;
+	}
+
+	//Check the header, a recording that never finished has no index. The index must fill the rest of the
+	//file, the offset is checked against the file size first so a crafted header can not overflow the sum
+	bool bValid = m_xFile.GetSize() >= sizeof(m_xHeader);
+	if (bValid) {
+		memcpy(&m_xHeader, m_xFile.GetData(), sizeof(m_xHeader));
+		const uint64_t uFileSize = m_xFile.GetSize();
+		bValid = m_xHeader.uMagic == TrajectoryCodec::sc_uMagic && m_xHeader.uVersion == TrajectoryCodec::sc_uVersion &&
+			m_xHeader.uIndexOffset >= sizeof(m_xHeader) && m_xHeader.uFrameCount > 0u && m_xHeader.fTimeStep > 0.f &&
+			m_xHeader.uIndexOffset <= uFileSize && m_xHeader.uChunkCount <= (uFileSize - m_xHeader.uIndexOffset) / sizeof(TrajectoryIndexEntry) &&
+			m_xHeader.uIndexOffset + static_cast<uint64_t>(m_xHeader.uChunkCount) * sizeof(TrajectoryIndexEntry) == uFileSize;
+	}
+
+	//Check the chunks cover every frame in order, so a frame can be found with a binary search
+	if (bValid) {
+		m_vxIndex.resize(m_xHeader.uChunkCount);
+		memcpy(m_vxIndex.data(), m_xFile.GetData() + m_xHeader.uIndexOffset, m_vxIndex.size() * sizeof(TrajectoryIndexEntry));
+		uint32_t uNextFrame = 0u;
+		for (unsigned int i = 0; i < m_vxIndex.size() && bValid; ++i)
+		{
+			bValid = m_vxIndex[i].uFirstFrame == uNextFrame && m_vxIndex[i].uFrameCount > 0u &&
+				m_vxIndex[i].uOffset <= m_xHeader.uIndexOffset - sizeof(TrajectoryChunkHeader);
+			uNextFrame += m_vxIndex[i].uFrameCount;
+		}
+		bValid = bValid && uNextFrame == m_xHeader.uFrameCount;
+	}
+
+	if (!bValid) {
+		printf("TRAJECTORY::INVALID FILE: %s\n", a_szPath.c_str());
+		Close();
+		return false;
+	}
+
+	printf("TRAJECTORY::OPENED: %s (%u frames in %u chunks, up to %u boids)\n", a_szPath.c_str(),
+		m_xHeader.uFrameCount, m_xHeader.uChunkCount, m_xHeader.uMaxBoidCount);
+
+	if (!SeekFrame(0u)) {
+		Close();
+		return false;
+	}
+	m_bPlaying = true;
+	return true;
+}
+
+/// <summary>
+/// Close the trajectory, the boids are left where the last frame put them
+/// </summary>
+void TrajectoryPlayer::Close()
+{
+	m_xFile.Close();
+	memset(&m_xHeader, 0, sizeof(m_xHeader));
+	m_vxIndex.clear();
+	m_uDecodedChunk = sc_uNoChunk;
+	m_bPlaying = false;
+	m_uCurrentFrame = 0u;
+	m_fFrameTime = 0.0f;
+	m_fInterpolationAlpha = 1.0f;
+}
+
+/// <summary>
+/// Move playback on by some time, showing a new frame once a frame's time step has passed.
+/// Playback stops on the last frame
+/// </summary>
+/// <param name="a_fDeltaTime">Time that has passed</param>
+void TrajectoryPlayer::Update(const float a_fDeltaTime)
+{
+	if (!IsOpen() || !m_bPlaying) {
+		return;
+	}
+
+	PROFILE_SCOPE("Update/Replay");
+	TRACE_SCOPE("TrajectoryPlayer::Update", "scene");
+
+	//Skip straight to the frame we should be on, rather than stepping through each one
+	const float fTimeStep = m_xHeader.fTimeStep;
+	m_fFrameTime += a_fDeltaTime;
+	const unsigned int uFramesLeft = m_xHeader.uFrameCount - 1u - m_uCurrentFrame;
+	const unsigned int uFramesPassed = std::min(static_cast<unsigned int>(m_fFrameTime / fTimeStep), uFramesLeft);
+	m_fFrameTime -= uFramesPassed * fTimeStep;
+
+	if (uFramesPassed > 0u && !ShowFrame(m_uCurrentFrame + uFramesPassed, true)) {
+		m_bPlaying = false;
+	}
+	if (m_uCurrentFrame + 1u >= m_xHeader.uFrameCount) {
+		m_bPlaying = false;
+	}
+
+	m_fInterpolationAlpha = m_bPlaying ? std::min(m_fFrameTime / fTimeStep, 1.0f) : 1.0f;
+}
+
+/// <summary>
+/// Show a frame with no interpolation from the frame shown before, playback carries on from this frame
+/// </summary>
+/// <param name="a_uFrame">Index of the frame to show</param>
+/// <returns>If the frame was shown</returns>
+bool TrajectoryPlayer::SeekFrame(const unsigned int a_uFrame)
+{
+	if (!IsOpen() || a_uFrame >= m_xHeader.uFrameCount) {
+		return false;
+	}
+
+	m_fFrameTime = 0.0f;
+	m_fInterpolationAlpha = 1.0f;
+	return ShowFrame(a_uFrame, false);
+}
+
+/// <summary>
+/// Set the transform of every boid from a frame. Boids are spawned or destroyed to match the number
+/// of boids in the frame, boid n of the frame is always shown by boid n of the boid system
+/// </summary>
+/// <param name="a_uFrame">Index of the frame to show</param>
+/// <param name="a_bInterpolate">If the transforms should be interpolated from the frame that is shown now</param>
+/// <returns>If the frame was shown</returns>
+bool TrajectoryPlayer::ShowFrame(const unsigned int a_uFrame, const bool a_bInterpolate)
+{
+	if (!DecodeChunkForFrame(a_uFrame)) {
+		return false;
+	}
+
+	const unsigned int uBoidCount = m_xDecodedChunkHeader.uBoidCount;
+	if (BoidSystem::GetInstance()->GetBoidCount() != uBoidCount) {
+		DebugUI::GetInstance()->GetUIInputValues()->iBoidCount.value = static_cast<int>(uBoidCount);
+		BoidSpawner::GetInstance()->AdjustBoidCount(uBoidCount);
+	}
+
+	const size_t uFrameValueCount = static_cast<size_t>(uBoidCount) * TrajectoryCodec::sc_uValuesPerBoid;
+	const uint16_t* puFrame = m_vuDecodedFrames.data() + (a_uFrame - m_xDecodedChunkHeader.uFirstFrame) * uFrameValueCount;
+	const float fPositionExtent = m_xHeader.fPositionExtent;
+	const BoidSystem* pBoidSystem = BoidSystem::GetInstance();
+	JobSystem::GetInstance()->ParallelFor(uBoidCount, sc_uBoidsPerJob, [pBoidSystem, puFrame, fPositionExtent, a_bInterpolate](const unsigned int a_uStart, const unsigned int a_uEnd, const unsigned int /*a_uThreadIndex*/)
+	{
+		for (unsigned int i = a_uStart; i < a_uEnd; ++i)
+		{
+			Entity* pOwner = pBoidSystem->GetBrain(i)->GetOwnerEntity();
+			TransformComponent* pTransform = pOwner ? pOwner->GetComponent<TransformComponent*>() : nullptr;
+			if (!pTransform) {
+				continue;
+			}
+
+			glm::vec3 v3Position;
+			glm::quat qRotation;
+			TrajectoryCodec::DequantizeBoid(puFrame + static_cast<size_t>(i) * TrajectoryCodec::sc_uValuesPerBoid, fPositionExtent, v3Position, qRotation);
+			const glm::mat3 m3Rotation = glm::mat3_cast(qRotation);
+
+			if (a_bInterpolate) {
+				pTransform->StorePreviousMatrix();
+			}
+			pTransform->SetEntityMatrixRow(MATRIX_ROW::RIGHT_VECTOR, m3Rotation[0]);
+			pTransform->SetEntityMatrixRow(MATRIX_ROW::UP_VECTOR, m3Rotation[1]);
+			pTransform->SetEntityMatrixRow(MATRIX_ROW::FORWARD_VECTOR, m3Rotation[2]);
+			pTransform->SetEntityMatrixRow(MATRIX_ROW::POSITION_VECTOR, v3Position);
+			if (!a_bInterpolate) {
+				pTransform->StorePreviousMatrix();
+			}
+		}
+	});
+
+	m_uCurrentFrame = a_uFrame;
+	return true;
+}
+
+/// <summary>
+/// Decode the chunk a frame is in. The chunk is found with a binary search of the index,
+/// nothing is decoded if it is the chunk we decoded last
+/// </summary>
+/// <param name="a_uFrame">Index of the frame</param>
+/// <returns>If the chunk is decoded</returns>
+bool TrajectoryPlayer::DecodeChunkForFrame(const unsigned int a_uFrame)
+{
+	const std::vector<TrajectoryIndexEntry>::const_iterator xEntry = std::upper_bound(m_vxIndex.begin(), m_vxIndex.end(), a_uFrame,
+		[](const unsigned int a_uFrameToFind, const TrajectoryIndexEntry& a_xEntry) { return a_uFrameToFind < a_xEntry.uFirstFrame; }) - 1;
+	const unsigned int uChunk = static_cast<unsigned int>(xEntry - m_vxIndex.begin());
+	if (uChunk == m_uDecodedChunk) {
+		return true;
+	}
+
+	TRACE_SCOPE("TrajectoryPlayer::DecodeChunk", "io");
+
+	//The chunk header must agree with the index and the chunk must end before the index
+	TrajectoryChunkHeader xChunkHeader;
+	memcpy(&xChunkHeader, m_xFile.GetData() + xEntry->uOffset, sizeof(xChunkHeader));
+	const uint64_t uDataOffset = xEntry->uOffset + sizeof(xChunkHeader);
+	if (xChunkHeader.uFirstFrame != xEntry->uFirstFrame || xChunkHeader.uFrameCount != xEntry->uFrameCount ||
+		xChunkHeader.uDataSize > m_xHeader.uIndexOffset - uDataOffset) {
+		printf("TRAJECTORY::INVALID CHUNK: %u\n", uChunk);
+		return false;
+	}
+
+	//Check the chunk's size before we make room to decode it, the key frame is stored whole
+	//and every value of the later frames takes at least one byte
+	const uint64_t uValueCount = static_cast<uint64_t>(xChunkHeader.uBoidCount) * TrajectoryCodec::sc_uValuesPerBoid;
+	const uint64_t uKeyFrameSize = uValueCount * sizeof(uint16_t);
+	if (xChunkHeader.uBoidCount > m_xHeader.uMaxBoidCount || xChunkHeader.uDataSize < uKeyFrameSize ||
+		(uValueCount > 0u && (xChunkHeader.uDataSize - uKeyFrameSize) / uValueCount < xChunkHeader.uFrameCount - 1u)) {
+		printf("TRAJECTORY::INVALID CHUNK: %u\n", uChunk);
+		return false;
+	}
+
+	m_uDecodedChunk = sc_uNoChunk;
+	m_vuDecodedFrames.resize(static_cast<size_t>(xChunkHeader.uFrameCount) * xChunkHeader.uBoidCount * TrajectoryCodec::sc_uValuesPerBoid);
+	if (!TrajectoryCodec::DecodeChunk(m_xFile.GetData() + uDataOffset, static_cast<size_t>(xChunkHeader.uDataSize),
+		xChunkHeader.uFrameCount, xChunkHeader.uBoidCount, m_vuDecodedFrames.data())) {
+		printf("TRAJECTORY::INVALID CHUNK: %u\n", uChunk);
+		return false;
+	}
+
+	m_uDecodedChunk = uChunk;
+	m_xDecodedChunkHeader = xChunkHeader;
+	return true;
+}
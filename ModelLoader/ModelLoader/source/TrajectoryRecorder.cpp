@@ -0,0 +1,294 @@
+#include "TrajectoryRecorder.h"
+
+//C++ Includes
+#include <algorithm>
+#include <cstring>
+
+//Project Includes
+#include "Scene.h"
+#include "Entity.h"
+#include "BoidSystem.h"
+#include "BrainComponent.h"
+#include "TransformComponent.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "TraceRecorder.h"
+
+/// <summary>
+/// Create the trajectory recorder
+/// </summary>
+TrajectoryRecorder::TrajectoryRecorder() :
+	m_pFile(nullptr),
+	m_xHeader(),
+	m_pFillingChunk(nullptr),
+	m_uFrameCount(0u),
+	m_bStopWriter(false),
+	m_uWriteOffset(0u),
+	m_bWriteFailed(false)
+{
+}
+
+/// <summary>
+/// Destroy the trajectory recorder, finishing the file if we are still recording
+/// </summary>
+TrajectoryRecorder::~TrajectoryRecorder()
+{
+	StopRecording();
+}
+
+/// <summary>
+/// Start recording every boid to a file. Positions are quantized to the current world bounds
+/// </summary>
+/// <param name="a_szPath">Path of the file to record to</param>
+/// <param name="a_fTimeStep">Time between each frame</param>
+/// <returns>If recording started</returns>
+bool TrajectoryRecorder::StartRecording(const std::string& a_szPath, const float a_fTimeStep)
+{
+	//Quantize over the largest extent so every axis fits
+	const Scene* pScene = Scene::GetInstance();
+	const glm::vec3& v3BoundsExtent = pScene->GetBoundsInnerExtent();
+	const float fPositionExtent = glm::max(v3BoundsExtent.x, glm::max(v3BoundsExtent.y, v3BoundsExtent.z));
+	if (IsRecording() || !pScene->GetCollisionWorld() || fPositionExtent <= 0.f) {
+		return false;
+	}
+
+	m_szPath = a_szPath;
+	m_szTempPath = a_szPath + ".tmp";
+	m_pFile = fopen(m_szTempPath.c_str(), "wb");
+	if (!m_pFile) {
+		printf("TRAJECTORY::FAILED TO WRITE: %s\n", a_szPath.c_str());
+		return false;
+	}
+
+	//The header is written again with the counts and index offset once we stop
+	memset(&m_xHeader, 0, sizeof(m_xHeader));
+	m_xHeader.uMagic = TrajectoryCodec::sc_uMagic;
+	m_xHeader.uVersion = TrajectoryCodec::sc_uVersion;
+	m_xHeader.uFramesPerChunk = sc_uFramesPerChunk;
+	m_xHeader.fPositionExtent = fPositionExtent;
+	m_xHeader.fTimeStep = a_fTimeStep;
+	m_bWriteFailed = fwrite(&m_xHeader, sizeof(m_xHeader), 1, m_pFile) != 1;
+	m_uWriteOffset = sizeof(m_xHeader);
+	m_vxIndex.clear();
+	m_uFrameCount = 0u;
+
+	//Double buffer the chunks, more are only made if the writer falls behind
+	m_vpChunks.clear();
+	m_vpEmptyChunks.clear();
+	m_xFullChunks.clear();
+	for (unsigned int i = 0; i < sc_uStartingChunkCount; ++i)
+	{
+		m_vpChunks.emplace_back(new FrameChunk());
+		m_vpEmptyChunks.push_back(m_vpChunks.back().get());
+	}
+	m_pFillingChunk = nullptr;
+
+	m_bStopWriter = false;
+	m_xWriterThread = std::thread(&TrajectoryRecorder::WriterLoop, this);
+
+	printf("TRAJECTORY::RECORDING: %s\n", a_szPath.c_str());
+	return true;
+}
+
+/// <summary>
+/// Stop recording. The last chunk is written, then the chunk index is added to the end of the
+/// file and the header is filled in, the file is only moved to it's path once it is complete
+/// </summary>
+/// <returns>If the file was completed, false if we were not recording or it could not be written</returns>
+bool TrajectoryRecorder::StopRecording()
+{
+	if (!IsRecording()) {
+		return false;
+	}
+
+	if (m_pFillingChunk && m_pFillingChunk->uFrameCount > 0u) {
+		SubmitChunk();
+	}
+	m_pFillingChunk = nullptr;
+
+	//Let the writer finish every chunk
+	{
+		std::lock_guard<std::mutex> xLock(m_xChunkMutex);
+		m_bStopWriter = true;
+	}
+	m_xChunkSubmitted.notify_one();
+	m_xWriterThread.join();
+
+	//Add the index and fill in the header
+	m_xHeader.uFrameCount = m_uFrameCount;
+	m_xHeader.uChunkCount = static_cast<uint32_t>(m_vxIndex.size());
+	m_xHeader.uIndexOffset = m_uWriteOffset;
+	bool bWritten = !m_bWriteFailed;
+	bWritten = bWritten && (m_vxIndex.empty() || fwrite(m_vxIndex.data(), sizeof(TrajectoryIndexEntry), m_vxIndex.size(), m_pFile) == m_vxIndex.size());
+	bWritten = bWritten && fseek(m_pFile, 0, SEEK_SET) == 0 && fwrite(&m_xHeader, sizeof(m_xHeader), 1, m_pFile) == 1;
+	bWritten = fclose(m_pFile) == 0 && bWritten;
+	m_pFile = nullptr;
+
+	remove(m_szPath.c_str());
+	const bool bCompleted = bWritten && rename(m_szTempPath.c_str(), m_szPath.c_str()) == 0;
+	if (!bCompleted) {
+		remove(m_szTempPath.c_str());
+		printf("TRAJECTORY::FAILED TO WRITE: %s\n", m_szPath.c_str());
+	}
+	else {
+		const uint64_t uFileSize = m_uWriteOffset + m_vxIndex.size() * sizeof(TrajectoryIndexEntry);
+		printf("TRAJECTORY::WROTE: %s (%u frames in %u chunks, %.2fMB)\n", m_szPath.c_str(), m_xHeader.uFrameCount,
+			m_xHeader.uChunkCount, uFileSize / (1024.0 * 1024.0));
+	}
+
+	//Only keep the memory of the chunks we started with
+	m_vpChunks.resize(std::min(static_cast<unsigned int>(m_vpChunks.size()), sc_uStartingChunkCount));
+	m_vpEmptyChunks.clear();
+	m_xFullChunks.clear();
+	return bCompleted;
+}
+
+/// <summary>
+/// Quantize the position and rotation of every boid in to the chunk we are filling. The chunk is
+/// handed to the writer once it is full, or before this frame if the number of boids has changed
+/// </summary>
+void TrajectoryRecorder::RecordFrame()
+{
+	if (!IsRecording()) {
+		return;
+	}
+
+	PROFILE_SCOPE("Update/Step/Record Trajectory");
+	TRACE_SCOPE("TrajectoryRecorder::RecordFrame", "scene");
+
+	const BoidSystem* pBoidSystem = BoidSystem::GetInstance();
+	const unsigned int uBoidCount = pBoidSystem->GetBoidCount();
+
+	//Every frame in a chunk has the same boids
+	if (m_pFillingChunk && m_pFillingChunk->uBoidCount != uBoidCount) {
+		SubmitChunk();
+	}
+	if (!m_pFillingChunk) {
+		m_pFillingChunk = GetEmptyChunk();
+		m_pFillingChunk->uFirstFrame = m_uFrameCount;
+		m_pFillingChunk->uFrameCount = 0u;
+		m_pFillingChunk->uBoidCount = uBoidCount;
+		m_pFillingChunk->vuValues.resize(static_cast<size_t>(sc_uFramesPerChunk) * uBoidCount * TrajectoryCodec::sc_uValuesPerBoid);
+	}
+
+	//Quantize every boid, the last frame of the chunk keeps quaternion signs the same between frames
+	const size_t uFrameValueCount = static_cast<size_t>(uBoidCount) * TrajectoryCodec::sc_uValuesPerBoid;
+	uint16_t* puFrame = m_pFillingChunk->vuValues.data() + m_pFillingChunk->uFrameCount * uFrameValueCount;
+	const uint16_t* puPreviousFrame = m_pFillingChunk->uFrameCount > 0u ? puFrame - uFrameValueCount : nullptr;
+	const float fPositionExtent = m_xHeader.fPositionExtent;
+	JobSystem::GetInstance()->ParallelFor(uBoidCount, sc_uBoidsPerJob, [pBoidSystem, puFrame, puPreviousFrame, fPositionExtent](const unsigned int a_uStart, const unsigned int a_uEnd, const unsigned int /*a_uThreadIndex*/)
+	{
+		for (unsigned int i = a_uStart; i < a_uEnd; ++i)
+		{
+			const Entity* pOwner = pBoidSystem->GetBrain(i)->GetOwnerEntity();
+			const TransformComponent* pTransform = pOwner ? pOwner->GetComponent<TransformComponent*>() : nullptr;
+			const glm::quat qRotation = pTransform ? glm::quat_cast(glm::mat3(pTransform->GetEntityMatrix())) : glm::quat(1.f, 0.f, 0.f, 0.f);
+
+			const size_t uOffset = static_cast<size_t>(i) * TrajectoryCodec::sc_uValuesPerBoid;
+			TrajectoryCodec::QuantizeBoid(pBoidSystem->GetPosition(i), qRotation, fPositionExtent,
+				puPreviousFrame ? puPreviousFrame + uOffset : nullptr, puFrame + uOffset);
+		}
+	});
+
+	++m_pFillingChunk->uFrameCount;
+	++m_uFrameCount;
+	m_xHeader.uMaxBoidCount = std::max(m_xHeader.uMaxBoidCount, uBoidCount);
+
+	if (m_pFillingChunk->uFrameCount == sc_uFramesPerChunk) {
+		SubmitChunk();
+	}
+}
+
+/// <summary>
+/// Get a chunk the writer has finished with. If the writer is still busy with all of them a
+/// new chunk is made, so the simulation never has to wait for the disk
+/// </summary>
+/// <returns>Empty chunk</returns>
+TrajectoryRecorder::FrameChunk* TrajectoryRecorder::GetEmptyChunk()
+{
+	std::lock_guard<std::mutex> xLock(m_xChunkMutex);
+	if (!m_vpEmptyChunks.empty()) {
+		FrameChunk* pChunk = m_vpEmptyChunks.back();
+		m_vpEmptyChunks.pop_back();
+		return pChunk;
+	}
+
+	m_vpChunks.emplace_back(new FrameChunk());
+	printf("TRAJECTORY::WRITER BEHIND: %zu chunks queued\n", m_xFullChunks.size());
+	return m_vpChunks.back().get();
+}
+
+/// <summary>
+/// Give the chunk we are filling to the writer thread
+/// </summary>
+void TrajectoryRecorder::SubmitChunk()
+{
+	{
+		std::lock_guard<std::mutex> xLock(m_xChunkMutex);
+		m_xFullChunks.push_back(m_pFillingChunk);
+	}
+	m_pFillingChunk = nullptr;
+	m_xChunkSubmitted.notify_one();
+}
+
+/// <summary>
+/// Wait for full chunks and write them, until recording stops and every chunk has been written
+/// </summary>
+void TrajectoryRecorder::WriterLoop()
+{
+	TraceRecorder::GetInstance()->SetThreadName("Trajectory Writer");
+
+	std::unique_lock<std::mutex> xLock(m_xChunkMutex);
+	while (true)
+	{
+		m_xChunkSubmitted.wait(xLock, [this]() { return !m_xFullChunks.empty() || m_bStopWriter; });
+		if (m_xFullChunks.empty()) {
+			return;
+		}
+
+		FrameChunk* pChunk = m_xFullChunks.front();
+		m_xFullChunks.pop_front();
+
+		//Encode and write without holding the lock, so the simulation can hand over the next chunk
+		xLock.unlock();
+		WriteChunk(*pChunk);
+		xLock.lock();
+
+		m_vpEmptyChunks.push_back(pChunk);
+	}
+}
+
+/// <summary>
+/// Encode a chunk and write it to the file, adding it to the index
+/// </summary>
+/// <param name="a_xChunk">Chunk to write</param>
+void TrajectoryRecorder::WriteChunk(const FrameChunk& a_xChunk)
+{
+	TRACE_SCOPE("TrajectoryRecorder::WriteChunk", "io");
+
+	//The file is thrown away when we stop, so there is no point writing more of it
+	if (m_bWriteFailed) {
+		return;
+	}
+
+	m_vuEncoded.clear();
+	TrajectoryCodec::EncodeChunk(a_xChunk.vuValues.data(), a_xChunk.uFrameCount, a_xChunk.uBoidCount, m_vuEncoded);
+
+	TrajectoryChunkHeader xChunkHeader;
+	memset(&xChunkHeader, 0, sizeof(xChunkHeader));
+	xChunkHeader.uFirstFrame = a_xChunk.uFirstFrame;
+	xChunkHeader.uFrameCount = a_xChunk.uFrameCount;
+	xChunkHeader.uBoidCount = a_xChunk.uBoidCount;
+	xChunkHeader.uDataSize = m_vuEncoded.size();
+
+	const bool bWritten = fwrite(&xChunkHeader, sizeof(xChunkHeader), 1, m_pFile) == 1 &&
+		(m_vuEncoded.empty() || fwrite(m_vuEncoded.data(), m_vuEncoded.size(), 1, m_pFile) == 1);
+	if (!bWritten) {
+		m_bWriteFailed = true;
+		return;
+	}
+
+	const TrajectoryIndexEntry xIndexEntry = { m_uWriteOffset, a_xChunk.uFirstFrame, a_xChunk.uFrameCount };
+	m_vxIndex.push_back(xIndexEntry);
+	m_uWriteOffset += sizeof(xChunkHeader) + m_vuEncoded.size();
+}
@@ -3,9 +3,14 @@
 //Typedefs
 typedef Component PARENT;
 
+//Allocate from a pool
+DEFINE_POOLED_ALLOCATION(TransformComponent)
+
 TransformComponent::TransformComponent(Entity* a_pOwner) : 
 	PARENT(a_pOwner),
-	m_m4EntityMatrix(glm::mat4(1.0f))
+	m_m4EntityMatrix(glm::mat4(1.0f)),
+	m_m4PreviousEntityMatrix(glm::mat4(1.0f)),
+	m_bHasPreviousMatrix(false)
 {
 
 }
@@ -40,6 +45,42 @@ glm::vec3 TransformComponent::GetCurrentPosition()
 	return GetEntityMatrixRow(MATRIX_ROW::POSITION_VECTOR);
 }
 
+/// <summary>
+/// Store the current matrix as the matrix of the previous simulation step.
+/// Should be called before the transform is moved by the simulation
+/// </summary>
+void TransformComponent::StorePreviousMatrix()
+{
+	m_m4PreviousEntityMatrix = m_m4EntityMatrix;
+	m_bHasPreviousMatrix = true;
+}
+
+/// <summary>
+/// Gets the matrix interpolated between the previous and current simulation steps.
+/// Position is lerped and rotation is slerped so the matrix stays orthogonal
+/// </summary>
+/// <param name="a_fAlpha">How far between the previous (0) and current (1) step to interpolate</param>
+/// <returns>Interpolated Matrix 4x4</returns>
+glm::mat4 TransformComponent::GetInterpolatedMatrix(const float a_fAlpha) const
+{
+	//If we haven't been moved by the simulation then there is nothing to interpolate
+	if (!m_bHasPreviousMatrix || a_fAlpha >= 1.f)
+	{
+		return m_m4EntityMatrix;
+	}
+
+	//Slerp between the rotations of each matrix
+	const glm::quat xPreviousRotation = glm::quat_cast(glm::mat3(m_m4PreviousEntityMatrix));
+	const glm::quat xCurrentRotation = glm::quat_cast(glm::mat3(m_m4EntityMatrix));
+	glm::mat4 m4Interpolated = glm::mat4_cast(glm::slerp(xPreviousRotation, xCurrentRotation, a_fAlpha));
+
+	//Lerp between the positions
+	const int iPositionRow = static_cast<int>(MATRIX_ROW::POSITION_VECTOR);
+	m4Interpolated[iPositionRow] = glm::mix(m_m4PreviousEntityMatrix[iPositionRow], m_m4EntityMatrix[iPositionRow], a_fAlpha);
+
+	return m4Interpolated;
+}
+
 /// <summary>
 /// Orthogonalize the matrix so that the forward, right and up vectors are facing in their respective
 /// directions.
@@ -18,6 +18,13 @@
 
 
 #include "Scene.h"
+#include "DebugUI.h"
+#include "SimulationSettings.h"
+#include "HeadlessSimulation.h"
+#include "RegressionHarness.h"
+#include "JobSystem.h"
+#include "TraceRecorder.h"
+#include "TrajectoryPlayer.h"
 
 #ifndef STB_IMAGE_IMPLEMENTATION
 #define STB_IMAGE_IMPLEMENTATION
@@ -25,8 +32,38 @@
 // ReSharper disable once CppUnusedIncludeDirective
 #include <stb/stb_image.h>
 
-int main()
+int main(int argc, char** argv)
 {
+	TraceRecorder::GetInstance()->SetThreadName("Main Thread");
+
+	//Read our settings from the command line
+	SimulationSettings xSettings;
+	if (!SimulationSettings::ParseCommandLine(argc, argv, xSettings))
+	{
+		return 1;
+	}
+
+	//Check the simulation against the golden runs if asked to, this is always headless
+	if (!xSettings.szRegressionPath.empty())
+	{
+		return RegressionHarness::Run(xSettings);
+	}
+
+	//Run without a window if asked to
+	if (xSettings.bHeadless)
+	{
+		return HeadlessSimulation::Run(xSettings);
+	}
+
+	if (xSettings.iThreadCount > 0)
+	{
+		JobSystem::GetInstance()->SetThreadCount(static_cast<unsigned int>(xSettings.iThreadCount));
+	}
+
+	//Start with the neighbour search asked for, this can be changed in the UI
+	UIInputValues* pUIValues = DebugUI::GetInstance()->GetUIInputValues();
+	pUIValues->bNeighbourLists = xSettings.bNeighbourLists;
+	pUIValues->fNeighbourListSkin.value = xSettings.fNeighbourListSkin;
     
 	Scene* pScene = Scene::GetInstance();
 
@@ -35,6 +72,15 @@ int main()
 
 		if (bIsInitalised) {
 
+			//Record a trace of the first frames if asked to
+			TraceRecorder::GetInstance()->StartRecording(static_cast<unsigned int>(xSettings.iTraceFrames), xSettings.szTracePath);
+
+			//Play back a recorded run instead of simulating if we were given one
+			if (!xSettings.szReplayPath.empty())
+			{
+				TrajectoryPlayer::GetInstance()->Open(xSettings.szReplayPath);
+			}
+
 			bool bKeepRunning = true;
 
 			while (bKeepRunning) {
@@ -42,6 +88,9 @@ int main()
 				pScene->Render();
 			}
 
+			//Write the trace if the window was closed while recording
+			TraceRecorder::GetInstance()->StopRecording();
+
 			pScene->DeInitialize(true);
 		}
 	}
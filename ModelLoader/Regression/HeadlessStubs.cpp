@@ -0,0 +1,80 @@
+/// <summary>
+/// Link only stand ins for the libraries the regression build does not have, GLFW and AssImp only ship as MSVC
+/// libraries and Gizmos.cpp only compiles with MSVC. The regression harness never opens a window or loads a model
+/// so none of these should be called, if one is it says which and aborts rather than carry on with a fake result.
+/// </summary>
+
+#include <cstdio>
+#include <cstdlib>
+
+#define GLFW_INCLUDE_NONE
+#include <GLFW/glfw3.h>
+#include <assimp/Importer.hpp>
+#include <assimp/material.h>
+
+#include "Gizmos.h"
+
+namespace
+{
+	/// <summary>
+	/// Report that a function we do not have was called and stop
+	/// </summary>
+	[[noreturn]] void StubCalled(const char* a_szFunction)
+	{
+		fprintf(stderr, "REGRESSION::%s IS NOT AVAILABLE IN THE HEADLESS BUILD\n", a_szFunction);
+		abort();
+	}
+}
+
+//GLFW
+GLFWcursor* glfwCreateStandardCursor(int) { StubCalled("glfwCreateStandardCursor"); }
+GLFWwindow* glfwCreateWindow(int, int, const char*, GLFWmonitor*, GLFWwindow*) { StubCalled("glfwCreateWindow"); }
+void glfwDestroyCursor(GLFWcursor*) { StubCalled("glfwDestroyCursor"); }
+const char* glfwGetClipboardString(GLFWwindow*) { StubCalled("glfwGetClipboardString"); }
+GLFWwindow* glfwGetCurrentContext() { StubCalled("glfwGetCurrentContext"); }
+void glfwGetCursorPos(GLFWwindow*, double*, double*) { StubCalled("glfwGetCursorPos"); }
+void glfwGetFramebufferSize(GLFWwindow*, int*, int*) { StubCalled("glfwGetFramebufferSize"); }
+int glfwGetInputMode(GLFWwindow*, int) { StubCalled("glfwGetInputMode"); }
+const float* glfwGetJoystickAxes(int, int*) { StubCalled("glfwGetJoystickAxes"); }
+const unsigned char* glfwGetJoystickButtons(int, int*) { StubCalled("glfwGetJoystickButtons"); }
+int glfwGetKey(GLFWwindow*, int) { StubCalled("glfwGetKey"); }
+int glfwGetMouseButton(GLFWwindow*, int) { StubCalled("glfwGetMouseButton"); }
+GLFWglproc glfwGetProcAddress(const char*) { StubCalled("glfwGetProcAddress"); }
+double glfwGetTime() { StubCalled("glfwGetTime"); }
+int glfwGetWindowAttrib(GLFWwindow*, int) { StubCalled("glfwGetWindowAttrib"); }
+void glfwGetWindowSize(GLFWwindow*, int*, int*) { StubCalled("glfwGetWindowSize"); }
+int glfwInit() { StubCalled("glfwInit"); }
+void glfwMakeContextCurrent(GLFWwindow*) { StubCalled("glfwMakeContextCurrent"); }
+void glfwPollEvents() { StubCalled("glfwPollEvents"); }
+GLFWcharfun glfwSetCharCallback(GLFWwindow*, GLFWcharfun) { StubCalled("glfwSetCharCallback"); }
+void glfwSetClipboardString(GLFWwindow*, const char*) { StubCalled("glfwSetClipboardString"); }
+void glfwSetCursor(GLFWwindow*, GLFWcursor*) { StubCalled("glfwSetCursor"); }
+void glfwSetCursorPos(GLFWwindow*, double, double) { StubCalled("glfwSetCursorPos"); }
+GLFWcursorposfun glfwSetCursorPosCallback(GLFWwindow*, GLFWcursorposfun) { StubCalled("glfwSetCursorPosCallback"); }
+GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun) { StubCalled("glfwSetErrorCallback"); }
+GLFWframebuffersizefun glfwSetFramebufferSizeCallback(GLFWwindow*, GLFWframebuffersizefun) { StubCalled("glfwSetFramebufferSizeCallback"); }
+void glfwSetInputMode(GLFWwindow*, int, int) { StubCalled("glfwSetInputMode"); }
+GLFWkeyfun glfwSetKeyCallback(GLFWwindow*, GLFWkeyfun) { StubCalled("glfwSetKeyCallback"); }
+GLFWmousebuttonfun glfwSetMouseButtonCallback(GLFWwindow*, GLFWmousebuttonfun) { StubCalled("glfwSetMouseButtonCallback"); }
+GLFWscrollfun glfwSetScrollCallback(GLFWwindow*, GLFWscrollfun) { StubCalled("glfwSetScrollCallback"); }
+void glfwSwapBuffers(GLFWwindow*) { StubCalled("glfwSwapBuffers"); }
+void glfwSwapInterval(int) { StubCalled("glfwSwapInterval"); }
+void glfwTerminate() { StubCalled("glfwTerminate"); }
+void glfwWindowHint(int, int) { StubCalled("glfwWindowHint"); }
+int glfwWindowShouldClose(GLFWwindow*) { StubCalled("glfwWindowShouldClose"); }
+
+//AssImp
+Assimp::Importer::Importer() { StubCalled("Assimp::Importer"); }
+Assimp::Importer::~Importer() {}
+const aiScene* Assimp::Importer::ReadFile(const char*, unsigned int) { StubCalled("Assimp::Importer::ReadFile"); }
+const char* Assimp::Importer::GetErrorString() const { StubCalled("Assimp::Importer::GetErrorString"); }
+aiReturn aiGetMaterialTexture(const aiMaterial*, aiTextureType, unsigned int, aiString*, aiTextureMapping*, unsigned int*, ai_real*, aiTextureOp*, aiTextureMapMode*, unsigned int*) { StubCalled("aiGetMaterialTexture"); }
+unsigned int aiGetMaterialTextureCount(const aiMaterial*, aiTextureType) { StubCalled("aiGetMaterialTextureCount"); }
+
+//Gizmos
+void Gizmos::create(unsigned int, unsigned int) { StubCalled("Gizmos::create"); }
+void Gizmos::destroy() { StubCalled("Gizmos::destroy"); }
+void Gizmos::clear() { StubCalled("Gizmos::clear"); }
+void Gizmos::draw(const glm::mat4&) { StubCalled("Gizmos::draw"); }
+void Gizmos::addBox(const glm::vec3&, const glm::vec3&, const bool&, const glm::vec4&, const glm::mat4&, glm::vec3**, unsigned int*) { StubCalled("Gizmos::addBox"); }
+void Gizmos::addSphere(const glm::vec3&, int, int, float, const glm::vec4&, const glm::mat4*, float, float, float, float, glm::vec3**, unsigned int*) { StubCalled("Gizmos::addSphere"); }
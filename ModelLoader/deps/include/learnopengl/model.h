@@ -38,6 +38,11 @@ public:
         loadModel(path);
     }
 
+    // constructor for an empty model, meshes and textures are added by whoever creates it (i.e the model cache)
+    Model() : gammaCorrection(false)
+    {
+    }
+
     // draws the model, and thus all its meshes
     void Draw(Shader shader)
     {